@@ -1,49 +1,54 @@
 ##
 # _mkcproj_complete.sh
 #
-# Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
-#  
 # Description: Autocomplete script of mkcproj, the generator of new C projects
-# 
-# Copyright (C) 2023 Gustavo Bacagine
 #
-# This program is free software: you can redistribute it and/or modify
-# it under the terms of the GNU General Public License as published by
-# the Free Software Foundation, either version 3 of the License, or
-# (at your option) any later version.
+# Generated by mkcproj --completion-script, don't edit it.
+# Run "make completion" to generate it again.
 #
-# This program is distributed in the hope that it will be useful,
-# but WITHOUT ANY WARRANTY; without even the implied warranty of
-# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-# GNU General Public License for more details.
-#
-# You should have received a copy of the GNU General Public License
-# along with this program.  If not, see <https://www.gnu.org/licenses/>.
-#
-# Date: 04/10/2023
-# 
 
 _mkcproj_complete()
 {
-  local cur_word
-  local prev_word
-  local long_type_list
-  local short_type_list
+  local cur_word="${COMP_WORDS[COMP_CWORD]}"
+  local prev_word="${COMP_WORDS[COMP_CWORD-1]}"
+  local long_opts="--help --version --trace --debug-level --colored-log --conf-filename --project-name --dev-name --dev-email --project-description --license --verbose --unity --unity-batch --pch --template-dir --watch --template-archive --output-tar --non-interactive --dedup --trace-events --extract-template --monorepo --merge-logs --manifest --verify --bench --rename --add-module --with"
+  local short_opts="-h -v -t -d -c -C -p -n -e -D -l -V -u -b -P -T -w -A -O -N -S -E -X -M -L -m -K -B -R -a -W"
+  local licenses="AGPL AGPL3 APACHE Apache Artistic2.0 Boost CCPL CDDL CPL EPL FDL FDL1.2 FDL1.3 GPL GPL2 GPL3 GPLv2 GPLv3 LGPL LGPL2.1 LGPL3 LPPL MPL MPL2 PHP PSF PerlArtistic RUBY Unlicense W3C ZPL"
 
-  cur_word="${COMP_WORDS[COMP_CWORD]}"
-  prev_word="${COMP_WORDS[COMP_CWORD-1]}"
+  # bash splits --option=value in "--option" "=" "value"
+  if [[ "${cur_word}" == "=" ]]; then
+    cur_word=""
+  elif [[ "${prev_word}" == "=" ]]; then
+    prev_word="${COMP_WORDS[COMP_CWORD-2]}"
+  fi
 
-  long_type_list=`mkcproj --help --version --trace \
-    --debug-level --colored-log --conf-filename`
-  short_type_list=`mkcproj -h -v -t -l -c -C`
-  
-  case "$cur_word" in
-    --*) COMPREPLY=( $(compgen -W "${long_type_list}" -- ${cur_word}) );;
-    -*) COMPREPLY=( $(compgen -W "${short_type_list}" -- ${cur_word}) );;
+  case "${prev_word}" in
+    --license|-l)
+      COMPREPLY=( $(compgen -W "${licenses}" -- "${cur_word}") )
+      return 0;;
+    --template-dir|-T)
+      compopt -o nospace
+      COMPREPLY=( $(mkcproj --complete 2 mkcproj -T "${cur_word}") )
+      return 0;;
+    --extract-template|-X|--verify|-K)
+      compopt -o filenames
+      COMPREPLY=( $(compgen -d -- "${cur_word}") )
+      return 0;;
+    --trace|-t|--conf-filename|-C|--template-archive|-A|--output-tar|-O|--trace-events|-E)
+      compopt -o filenames
+      COMPREPLY=( $(compgen -f -- "${cur_word}") )
+      return 0;;
+    --debug-level|-d|--project-name|-p|--dev-name|-n|--dev-email|-e|--project-description|-D|--unity-batch|-b|--rename|-R|--add-module|-a|--with|-W)
+      COMPREPLY=()
+      return 0;;
+  esac
+
+  case "${cur_word}" in
+    --*) COMPREPLY=( $(compgen -W "${long_opts}" -- "${cur_word}") );;
+    -*) COMPREPLY=( $(compgen -W "${short_opts}" -- "${cur_word}") );;
   esac
 
   return 0
 }
 
 complete -F _mkcproj_complete -o default mkcproj
-
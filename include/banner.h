@@ -0,0 +1,156 @@
+/**
+ * banner.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Header comment (banner) of the files of the new
+ *              projects, rendered once for each comment style
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _BANNER_H_
+#define _BANNER_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Files with each comment style
+ */
+#define COMMENT_C_FILES    (HEADER_FILE | SOURCE_FILE | BENCH_HEADER_FILE | BENCH_FILE | BENCH_PROJECT_FILE)
+#define COMMENT_HASH_FILES (MAKEFILE_FILE | MK_FILE | MKALL_FILE | MKD_FILE | MKDALL_FILE |     \
+                            MKCLEAN_FILE | MKDISTCLEAN_FILE | MKINSTALL_FILE |                  \
+                            MKUNINSTALL_FILE | MKSTRIP_FILE | MKPGO_FILE | MKPROF_FILE |        \
+                            INSTALL_SCRIPT_FILE | UNINSTALL_SCRIPT_FILE | AUTOCOMPLETE_FILE |    \
+                            CONF_FILE | MKBENCH_FILE)
+#define COMMENT_ROFF_FILES (MAN_FILE)
+#define COMMENT_HTML_FILES (MARKDOWN_README_FILE)
+
+/**
+ * The header comment of these files is replaced by the banner,
+ * in the others the banner is added before the template
+ */
+#define BANNER_REPLACE_FILES (HEADER_FILE | SOURCE_FILE | MAKEFILE_FILE | BENCH_HEADER_FILE | \
+                              BENCH_FILE | BENCH_PROJECT_FILE)
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Comment styles of the banners. The plain text files
+ * (INSTALL, AUTHORS, COPYRIGHT, ...) don't have a banner.
+ */
+typedef enum ENUM_COMMENT_STYLE
+{
+  COMMENT_STYLE_NONE = -1,
+  COMMENT_STYLE_C = 0, /* .c and .h                       */
+  COMMENT_STYLE_HASH,  /* Makefile, scripts and .conf     */
+  COMMENT_STYLE_ROFF,  /* man page                        */
+  COMMENT_STYLE_HTML,  /* README.md                       */
+  COMMENT_STYLE_COUNT
+} ENUM_COMMENT_STYLE;
+
+/**
+ * Banner of a comment style: pszHead, the name of the file
+ * and pszTail, written with 3 fwrite()
+ */
+typedef struct STRUCT_BANNER
+{
+  char *pszHead;
+  size_t lHeadLen;
+  char *pszTail;
+  size_t lTailLen;
+} STRUCT_BANNER, *PSTRUCT_BANNER;
+
+/**
+ * Banners of the comment styles, rendered again only
+ * when the project (gstCmdLine) changes, e.g. in --watch
+ */
+typedef struct STRUCT_BANNER_CACHE
+{
+  STRUCT_BANNER astBanners[COMMENT_STYLE_COUNT];
+  char szKey[_MAX_PATH * 5];
+  bool bRendered;
+} STRUCT_BANNER_CACHE;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Banners rendered by iRenderBanners
+ */
+extern STRUCT_BANNER_CACHE gstBannerCache;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Comment style of a file of the project
+ */
+ENUM_COMMENT_STYLE eGetCommentStyle(uint64_t ui64Flag);
+
+/**
+ * Write the lines of kpszText with the prefix of the comment
+ * style, without trailing spaces in the empty lines
+ */
+void vWriteCommentLines(FILE *fpBanner, ENUM_COMMENT_STYLE eStyle, const char *kpszText);
+
+/**
+ * Notice of the license written after "License: ...",
+ * empty for the licenses without one
+ */
+const char *kpszGetLicenseNotice(const char *kpszLicense, char *pszNotice, size_t lNoticeSize);
+
+/**
+ * Render the banners of every comment style, once for
+ * each project
+ */
+int iRenderBanners(void);
+
+/**
+ * Free the banners of gstBannerCache
+ */
+void vFreeBanners(void);
+
+/**
+ * Write the banner of a comment style with the name of the file
+ */
+bool bWriteBanner(FILE *fpFile, ENUM_COMMENT_STYLE eStyle, const char *kpszFileName);
+
+/**
+ * Copy the "#!" line of a script template, so the
+ * banner is written after it
+ */
+void vCopyTemplateShebang(FILE *fpTemplate, FILE *fpNewFile);
+
+/**
+ * Skip the comment block at the beginning of a template when it
+ * is a banner (has "Written by"), the banner of the project
+ * is written in its place
+ */
+void vSkipTemplateBanner(FILE *fpTemplate, ENUM_COMMENT_STYLE eStyle);
+
+#endif /* _BANNER_H_ */
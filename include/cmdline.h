@@ -42,6 +42,16 @@ typedef struct STRUCT_COMMAND_LINE
   char szDevMail            [_MAX_PATH];
   char szProjDescription    [_MAX_PATH];
   char szLicense            [_MAX_PATH];
+  char szUnityBatch         [_MAX_PATH];
+  char szTemplateDir        [_MAX_PATH];
+  char szTemplateArchive    [_MAX_PATH];
+  char szOutputTar          [_MAX_PATH];
+  char szTraceEvents        [_MAX_PATH];
+  char szExtractTemplate    [_MAX_PATH];
+  char szVerify             [_MAX_PATH];
+  char szRename             [_MAX_PATH];
+  char szAddModule          [_MAX_PATH];
+  char szWith               [_MAX_PATH];
 } STRUCT_COMMAND_LINE;
 
 /**
@@ -0,0 +1,135 @@
+/**
+ * complete.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Shell completion of the command line, generated
+ *              from the table of options (astCmdOpt)
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _COMPLETE_H_
+#define _COMPLETE_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <dirent.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * mkcproj --complete <cword> <words...>
+ *
+ * Print the candidates of the word <cword> of <words...>
+ * (COMP_CWORD and COMP_WORDS of bash), one by line
+ */
+#define COMPLETE_OPTION "--complete"
+
+/**
+ * mkcproj --completion-script
+ *
+ * Print the bash completion script, with the options and the
+ * licenses inside of it, so only the completion of the template
+ * directories runs mkcproj
+ */
+#define COMPLETION_SCRIPT_OPTION "--completion-script"
+
+/**
+ * Directory of the templates, relative to $HOME
+ */
+#define TEMPLATES_DIR "Template"
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * What is completed after a option
+ */
+typedef enum ENUM_COMPLETE_KIND
+{
+  COMPLETE_NONE = 0,     /* No argument */
+  COMPLETE_TEXT,         /* text, number: nothing to complete */
+  COMPLETE_FILE,
+  COMPLETE_DIR,
+  COMPLETE_LICENSE,
+  COMPLETE_TEMPLATE_DIR
+} ENUM_COMPLETE_KIND;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * IDs of the licenses completed by --license (the Licenses directory)
+ */
+extern const char *kaszLicenseIds[];
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Index in astCmdOpt of the option of a word: --name, --name=value
+ * or -x. ppszValue receives the value after the '=' (NULL without it).
+ * Returns -1 when the word isn't an option.
+ */
+int iGetCmdOptIndex(const char *kpszWord, const char **ppszValue);
+
+/**
+ * What is completed after the option ii of astCmdOpt
+ */
+ENUM_COMPLETE_KIND eGetCompleteKind(int ii);
+
+/**
+ * Print the --name or -x options that begin with kpszCur
+ */
+void vCompleteOptions(const char *kpszCur);
+
+/**
+ * Print the IDs of the licenses that begin with kpszCur,
+ * after kpszOptPrefix (e.g. "--license=")
+ */
+void vCompleteLicenses(const char *kpszCur, const char *kpszOptPrefix);
+
+/**
+ * Print the entries of the directory of kpszCur that begin with it,
+ * only the directories when bOnlyDirs. The directories end with '/'.
+ */
+void vCompletePath(const char *kpszCur, bool bOnlyDirs, const char *kpszOptPrefix);
+
+/**
+ * Print the template directories ($HOME/Template/<name> and the
+ * directory of the template of the profile) that begin with kpszCur
+ */
+void vCompleteTemplateDirs(const char *kpszCur, const char *kpszOptPrefix);
+
+/**
+ * mkcproj --complete <cword> <words...>, ppszWords[0] is <cword>
+ */
+int iCompleteCommandLine(int iWordsCount, char **ppszWords);
+
+/**
+ * mkcproj --completion-script, write the bash completion script
+ */
+int iWriteCompletionScript(FILE *fpScript);
+
+#endif /* _COMPLETE_H_ */
@@ -0,0 +1,138 @@
+/**
+ * extract.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Create a template directory from an existing
+ *              project (--extract-template), replacing the name
+ *              of the project by "template" and "TEMPLATE"
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _EXTRACT_H_
+#define _EXTRACT_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Maximum number of threads of the tree walk
+ */
+#define EXTRACT_MAX_THREADS 64
+
+/**
+ * Bytes read to know if a file is binary (has a '\0'),
+ * the binary files are copied without changes
+ */
+#define EXTRACT_BINARY_CHECK_SIZE 8192
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A directory to read or a file to copy,
+ * relative to the directory of the project
+ */
+typedef struct STRUCT_EXTRACT_JOB
+{
+  char szRelativePath[_MAX_PATH];
+  bool bDir;
+} STRUCT_EXTRACT_JOB, *PSTRUCT_EXTRACT_JOB;
+
+/**
+ * Jobs shared by the threads of the tree walk. The walk
+ * ends when there is no job in the queue and no thread
+ * running a job (iPending == 0).
+ */
+typedef struct STRUCT_EXTRACT_QUEUE
+{
+  PSTRUCT_EXTRACT_JOB pastJobs;
+  int iJobsCount;
+  int iJobsAlloc;
+  int iPending;
+  int iErrors;
+  long lFilesCount;
+  pthread_mutex_t stMutex;
+  pthread_cond_t stCond;
+  char szSrcDir[_MAX_PATH];
+  char szDestDir[2048];
+  char szProjName[_MAX_PATH];
+  char szUpperProjName[_MAX_PATH];
+} STRUCT_EXTRACT_QUEUE, *PSTRUCT_EXTRACT_QUEUE;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Files and directories that are not copied: the
+ * outputs removed by "make distclean" (obj, bin,
+ * *.log and bench.json), the files generated by
+ * mkcproj and the hidden ones (.git, .mkcproj, ...)
+ */
+bool bIsExtractIgnored(const char *kpszRelativePath, const char *kpszName, bool bDir);
+
+/**
+ * Replace the name of the project by "template" and
+ * the name in upper case by "TEMPLATE", only whole words
+ */
+int iWriteTemplateName(FILE *fpTemplate, const char *kpszContent, size_t lSize,
+                       PSTRUCT_EXTRACT_QUEUE pstQueue);
+
+/**
+ * Relative path of a file in the template
+ *
+ * Example: src/MyProj.c -> src/template.c
+ */
+void vGetTemplatePath(const char *kpszRelativePath, char *pszTemplatePath, size_t lTemplatePathSize,
+                      PSTRUCT_EXTRACT_QUEUE pstQueue);
+
+/**
+ * Add a job to the queue, the mutex must be locked
+ */
+bool bPushExtractJob(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath, bool bDir);
+
+/**
+ * Read a directory of the project and add its entries to the queue
+ */
+int iExtractDir(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath);
+
+/**
+ * Copy a file of the project to the template, mapped in the memory
+ */
+int iExtractFile(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath);
+
+/**
+ * Thread of the tree walk
+ */
+void *pvExtractWorker(void *pvQueue);
+
+/**
+ * Create the template directory gszTemplatePathDir
+ * from the project kpszProjectPathDir
+ */
+int iExtractTemplate(const char *kpszProjectPathDir);
+
+#endif /* _EXTRACT_H_ */
@@ -0,0 +1,197 @@
+/**
+ * libmkcproj.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: API of libmkcproj (make lib), create a project
+ *              without run the mkcproj binary
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _LIBMKCPROJ_H_
+#define _LIBMKCPROJ_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Size of the paths of the memory sink
+ */
+#define MKCPROJ_MAX_PATH 1024
+
+/**
+ * Options of vMkcprojSetSpecOptions
+ */
+#define MKCPROJ_OPTION_PCH      0x01 /* include/pch.h (--pch)       */
+#define MKCPROJ_OPTION_BENCH    0x02 /* bench/ directory (--bench)  */
+#define MKCPROJ_OPTION_MANIFEST 0x04 /* .mkcproj-manifest (-m)      */
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * What to create, the same fields of the command line.
+ * Only the functions below read or change it.
+ */
+typedef struct STRUCT_MKCPROJ_SPEC STRUCT_MKCPROJ_SPEC, *PSTRUCT_MKCPROJ_SPEC;
+
+/**
+ * Sink and result of the generations of the caller, one for
+ * each thread. Only the functions below read or change it.
+ */
+typedef struct STRUCT_MKCPROJ_CTX STRUCT_MKCPROJ_CTX, *PSTRUCT_MKCPROJ_CTX;
+
+/**
+ * Text fields of the spec, the empty fields take
+ * the defaults of mkcproj
+ */
+typedef enum ENUM_MKCPROJ_SPEC_FIELD
+{
+  MKCPROJ_SPEC_PROJ_NAME,
+  MKCPROJ_SPEC_DEV_NAME,
+  MKCPROJ_SPEC_DEV_MAIL,
+  MKCPROJ_SPEC_PROJ_DESCRIPTION,
+  MKCPROJ_SPEC_LICENSE,      /* Default: GPLv2                              */
+  MKCPROJ_SPEC_TEMPLATE_DIR, /* Directory or .tar(.gz) of the template      */
+  MKCPROJ_SPEC_PROJECTS_DIR, /* Default: $HOME/Projects                     */
+  MKCPROJ_SPEC_WITH          /* Modules of --with, e.g. "arena,pool"        */
+} ENUM_MKCPROJ_SPEC_FIELD;
+
+/**
+ * A file or a directory written in the memory sink
+ */
+typedef struct STRUCT_MKCPROJ_MEMORY_FILE
+{
+  char szPath[MKCPROJ_MAX_PATH];    /* Example: MyProj/src/MyProj.c            */
+  mode_t iMode;
+  bool bDir;
+  char *pszContent;
+  size_t lSize;
+} STRUCT_MKCPROJ_MEMORY_FILE, *PSTRUCT_MKCPROJ_MEMORY_FILE;
+
+/**
+ * Every entry written in the memory sink, in the order of the creation
+ */
+typedef struct STRUCT_MKCPROJ_MEMORY
+{
+  PSTRUCT_MKCPROJ_MEMORY_FILE pastFiles;
+  int iFilesCount;
+  int iFilesAlloc;
+} STRUCT_MKCPROJ_MEMORY, *PSTRUCT_MKCPROJ_MEMORY;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * New spec, with the defaults of mkcproj. NULL without memory.
+ */
+PSTRUCT_MKCPROJ_SPEC pstMkcprojNewSpec(void);
+
+/**
+ * Free the spec
+ */
+void vMkcprojFreeSpec(PSTRUCT_MKCPROJ_SPEC pstSpec);
+
+/**
+ * Set a text field of the spec, false if it's too long
+ */
+bool bMkcprojSetSpecText(PSTRUCT_MKCPROJ_SPEC pstSpec, ENUM_MKCPROJ_SPEC_FIELD eField, const char *kpszValue);
+
+/**
+ * Size of the src/unity_N.c files (--unity), 0 is without them
+ */
+void vMkcprojSetSpecUnityBatch(PSTRUCT_MKCPROJ_SPEC pstSpec, int iUnityBatch);
+
+/**
+ * MKCPROJ_OPTION_* of the spec
+ */
+void vMkcprojSetSpecOptions(PSTRUCT_MKCPROJ_SPEC pstSpec, unsigned int uiOptions);
+
+/**
+ * New context, without files, that writes in the directory
+ * of the spec. NULL without memory.
+ */
+PSTRUCT_MKCPROJ_CTX pstMkcprojNewCtx(void);
+
+/**
+ * Free the context and the files of the last generation
+ */
+void vMkcprojFreeCtx(PSTRUCT_MKCPROJ_CTX pstCtx);
+
+/**
+ * Print the errors in the stderr too, print the
+ * created files in the stdout
+ */
+void vMkcprojSetCtxOutput(PSTRUCT_MKCPROJ_CTX pstCtx, bool bPrintErrors, bool bVerbose);
+
+/**
+ * The next generations write in the sink of the caller,
+ * the paths are relative to the projects directory, e.g.
+ * MyProj/src. pbFinish (can be NULL) runs after the last file.
+ */
+void vMkcprojSetSink(PSTRUCT_MKCPROJ_CTX pstCtx,
+                     bool (*pbWriteDir)(void *pvData, const char *kpszPath, mode_t iMode),
+                     bool (*pbWriteFile)(void *pvData, const char *kpszPath, mode_t iMode,
+                                         const char *kpszContent, size_t lSize),
+                     bool (*pbFinish)(void *pvData), void *pvData);
+
+/**
+ * The next generations keep the project in pstMemory,
+ * nothing is written in the disk
+ */
+void vMkcprojSetMemorySink(PSTRUCT_MKCPROJ_CTX pstCtx, PSTRUCT_MKCPROJ_MEMORY pstMemory);
+
+/**
+ * The next generations write a tar archive in fpTar
+ */
+void vMkcprojSetTarSink(PSTRUCT_MKCPROJ_CTX pstCtx, FILE *fpTar);
+
+/**
+ * Free the files of the memory sink
+ */
+void vMkcprojFreeMemory(PSTRUCT_MKCPROJ_MEMORY pstMemory);
+
+/**
+ * Create the project of kpstSpec in the sink of pstCtx. It never
+ * exits the process, the errors are in pstCtx.
+ *
+ * The generation uses the globals of mkcproj, so the calls are
+ * serialized by a lock: any thread can call it, but only one
+ * project is created at a time.
+ */
+int iMkcprojGenerate(PSTRUCT_MKCPROJ_CTX pstCtx, const STRUCT_MKCPROJ_SPEC *kpstSpec);
+
+/**
+ * Result of the last generation, 0 is OK, and its error message
+ */
+int iMkcprojGetResult(const STRUCT_MKCPROJ_CTX *kpstCtx);
+const char *kpszMkcprojGetError(const STRUCT_MKCPROJ_CTX *kpstCtx);
+
+/**
+ * Files created by the last generation, in the order of the
+ * creation. The path is relative to the project, e.g. src/MyProj.c.
+ */
+int iMkcprojGetFilesCount(const STRUCT_MKCPROJ_CTX *kpstCtx);
+const char *kpszMkcprojGetFile(const STRUCT_MKCPROJ_CTX *kpstCtx, int iFile, mode_t *piMode);
+
+#endif /* _LIBMKCPROJ_H_ */
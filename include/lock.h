@@ -0,0 +1,90 @@
+/**
+ * lock.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Many mkcproj running at the same time: a log file
+ *              for each process and a lock for each project
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _LOCK_H_
+#define _LOCK_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Lock of a project, beside of its directory: <projects>/.<name>.lock
+ */
+#define PROJECT_LOCK_SUFFIX ".lock"
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Merge the logs of the other processes in the log file and exit
+ */
+extern bool gbMergeLogs;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Name of the log of the process pid: "./mkcproj.log" -> "./mkcproj.<pid>.log"
+ */
+void vGetLogShardName(const char *kpszLogFileName, long lPid, char *pszShardName, size_t lShardNameSize);
+
+/**
+ * Use the log file when no other mkcproj writes in it, otherwise
+ * use the log of this process (vGetLogShardName). The lock of the
+ * file is kept until the end of the process.
+ */
+void vSetSharedLogFileName(const char *kpszLogFileName);
+
+/**
+ * Append the logs of the processes that already ended in the log
+ * file, each one with a single write(), and remove them
+ */
+int iMergeLogShards(const char *kpszLogFileName);
+
+/**
+ * Path of the lock file of the project, the same for any
+ * path of the directory: "proj/", "./proj", "/abs/proj"
+ */
+void vGetProjectLockPath(const char *kpszProjectPathDir, char *pszLockPath, size_t lLockPathSize);
+
+/**
+ * Lock the project directory for this process. Fails without wait
+ * when other mkcproj creates or updates the same project.
+ */
+bool bLockProject(const char *kpszProjectPathDir);
+
+/**
+ * Release the lock of bLockProject()
+ */
+void vUnlockProject(void);
+
+#endif /* _LOCK_H_ */
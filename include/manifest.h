@@ -0,0 +1,152 @@
+/**
+ * manifest.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Manifest with the hash of each file of the project,
+ *              to find the files changed after the creation
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _MANIFEST_H_
+#define _MANIFEST_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Manifest in the directory of the project. Each line is
+ * "<XXH64 in hex>  <relative path>", the format of xxhsum,
+ * so "xxhsum -c .mkcproj-manifest" checks it too.
+ */
+#define MANIFEST_FILE ".mkcproj-manifest"
+
+/**
+ * Maximum number of threads of --verify
+ */
+#define MANIFEST_MAX_THREADS 64
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A line of the manifest
+ */
+typedef struct STRUCT_MANIFEST_ENTRY
+{
+  char szRelativePath[_MAX_PATH];
+  uint64_t ui64Hash;
+} STRUCT_MANIFEST_ENTRY, *PSTRUCT_MANIFEST_ENTRY;
+
+/**
+ * Lines of a manifest
+ */
+typedef struct STRUCT_MANIFEST
+{
+  PSTRUCT_MANIFEST_ENTRY pastEntries;
+  int iEntriesCount;
+  int iEntriesAlloc;
+} STRUCT_MANIFEST, *PSTRUCT_MANIFEST;
+
+/**
+ * A file to check, with the hash of the manifest
+ */
+typedef struct STRUCT_VERIFY_JOB
+{
+  char szPath[_MAX_PATH * 2];
+  uint64_t ui64Hash;
+} STRUCT_VERIFY_JOB, *PSTRUCT_VERIFY_JOB;
+
+/**
+ * Files of every manifest given to --verify, the
+ * threads take the next one (iNextJob) until the end
+ */
+typedef struct STRUCT_VERIFY_QUEUE
+{
+  PSTRUCT_VERIFY_JOB pastJobs;
+  int iJobsCount;
+  int iJobsAlloc;
+  int iNextJob;
+  int iChanged;
+  int iMissing;
+  pthread_mutex_t stMutex;
+} STRUCT_VERIFY_QUEUE, *PSTRUCT_VERIFY_QUEUE;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Write the manifest of the project, default is false
+ */
+extern bool gbManifest;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * XXH64 of lSize bytes, the same value of "xxhsum -H64"
+ */
+uint64_t ui64HashXxh64(const void *kpvData, size_t lSize, uint64_t ui64Seed);
+
+/**
+ * Add a line to the manifest, or replace the hash
+ * of the line of the same file
+ */
+bool bSetManifestEntry(PSTRUCT_MANIFEST pstManifest, const char *kpszRelativePath, uint64_t ui64Hash);
+
+/**
+ * Read the manifest of the project in kpszProjectPathDir.
+ * Returns -1 when it doesn't exist or is invalid.
+ */
+int iReadManifest(const char *kpszProjectPathDir, PSTRUCT_MANIFEST pstManifest);
+
+/**
+ * Order of the lines of the manifest, qsort() callback
+ */
+int iCompareManifestEntries(const void *kpvEntry1, const void *kpvEntry2);
+
+/**
+ * Write the manifest of gszFullNewProjectPathDir with the hashes
+ * of gstProjectFiles, keeping the lines of the files that were
+ * not created again (--watch updates only some files)
+ */
+int iWriteManifest(void);
+
+/**
+ * Thread of --verify, hash the files of the queue
+ */
+void *pvVerifyWorker(void *pvQueue);
+
+/**
+ * mkcproj --verify DIR [DIR...], check the files of the projects
+ * against their manifests, with a thread for each CPU
+ */
+int iVerifyManifests(int iProjectsCount, char **ppszProjectsPathDir);
+
+#endif /* _MANIFEST_H_ */
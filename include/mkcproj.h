@@ -43,14 +43,21 @@
 #include <locale.h>
 #include <libintl.h>
 #include <sys/utsname.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
 #include <unistd.h>
 #include <pwd.h>
+#include <pthread.h>
 #include "trace/trace.h"
 #include "cutils/cutils.h"
 #include "cutils/str.h"
 #include "cutils/date_time.h"
 #include "cutils/file.h"
 #include "cutils/io.h"
+#include "trace_events.h"
 
 /******************************************************************************
  *                                                                            *
@@ -135,6 +142,36 @@
 #define LOG_HEADER_FILE 0x0400000000
 #define LOG_LIB_FILE    0x0800000000
 
+/**
+ * Build profile scripts
+ */
+#define MKPGO_FILE  0x1000000000
+#define MKPROF_FILE 0x20000000000
+
+/**
+ * Microbenchmark files (--bench), bench/bench_template.c has
+ * the benchmarks of the project and is named bench/bench_<name>.c
+ */
+#define BENCH_HEADER_FILE  0x2000000000
+#define BENCH_FILE         0x4000000000
+#define BENCH_PROJECT_FILE 0x8000000000
+#define MKBENCH_FILE       0x10000000000
+
+#define BENCH_FILES (BENCH_HEADER_FILE | BENCH_FILE | BENCH_PROJECT_FILE | MKBENCH_FILE)
+
+/**
+ * Files that every template directory must have,
+ * the others are created only if they exist in
+ * the template directory
+ */
+#define REQUIRED_FILES (HEADER_FILE | SOURCE_FILE | MAKEFILE_FILE)
+
+/**
+ * Files created from the template directory
+ * (HEADER_FILE to MAN_FILE, MKPGO_FILE and MKPROF_FILE)
+ */
+#define PROJECT_FILES (0x1FFFFFF | MKPGO_FILE | MKPROF_FILE)
+
 /**
  * Default directories created in new C project
  */
@@ -144,16 +181,142 @@
 #define DOC_DIR  0x008
 #define MAN_DIR  0x010
 #define LIB_DIR  0x020
+#define BENCH_DIR 0x040
 
 #define PROJECTS_DIR "Projects"
 #define TEMPLATE_DIR "template"
 
+/**
+ * Default number of .c files included
+ * by each src/unity_N.c file
+ */
+#define UNITY_BATCH_SIZE 8
+
+/**
+ * Suffix of the temporary file written before
+ * be renamed to the file of the project
+ */
+#define TMP_FILE_SUFFIX ".mkcproj-tmp"
+
+/**
+ * File with the information of the project (name,
+ * developer, license, ...) saved in the new project
+ */
+#define PROJECT_INFO_FILE ".mkcproj"
+
+/**
+ * First line of the Makefile of the monorepo (--monorepo),
+ * only a Makefile with it is written again
+ */
+#define MONOREPO_MAKEFILE_MARK "generated by mkcproj"
+
+/**
+ * --watch: inotify events of the template directory
+ * and time without events before update the projects
+ */
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM)
+#define WATCH_DEBOUNCE_MS 100
+
 /******************************************************************************
  *                                                                            *
  *                  Typedefs, structures, unions and enums                    *
  *                                                                            *
  ******************************************************************************/
 
+/**
+ * A file found in the template directory
+ */
+typedef struct STRUCT_TEMPLATE_FILE
+{
+  char szRelativePath[_MAX_PATH]; /* Example: src/template.c */
+  off_t lSize;
+  mode_t iMode;
+  char *pszContent; /* Only for the templates read from an archive */
+} STRUCT_TEMPLATE_FILE, *PSTRUCT_TEMPLATE_FILE;
+
+/**
+ * Every file of the template directory, sorted
+ * by the relative path
+ */
+typedef struct STRUCT_TEMPLATE_INDEX
+{
+  PSTRUCT_TEMPLATE_FILE pastFiles;
+  int iFilesCount;
+  int iFilesAlloc;
+} STRUCT_TEMPLATE_INDEX;
+
+/**
+ * A directory of the template watched by inotify
+ */
+typedef struct STRUCT_WATCH_DIR
+{
+  int iWatchDescriptor;
+  char szRelativeDir[_MAX_PATH]; /* Empty for gszTemplatePathDir */
+} STRUCT_WATCH_DIR, *PSTRUCT_WATCH_DIR;
+
+/**
+ * The inotify instance of --watch and your directories
+ */
+typedef struct STRUCT_TEMPLATE_WATCH
+{
+  int iInotifyFd;
+  PSTRUCT_WATCH_DIR pastDirs;
+  int iDirsCount;
+  char **ppszTreePaths; /* Changed files that aren't flags */
+  int iTreePathsCount;
+} STRUCT_TEMPLATE_WATCH, *PSTRUCT_TEMPLATE_WATCH;
+
+/**
+ * Where the files of the new project go when they aren't
+ * written in the disk (--output-tar, the memory, ...). The
+ * paths are relative to gszProjectsPathDir, e.g. MyProj/src.
+ * pbFinish (can be NULL) runs after the last file.
+ */
+typedef struct STRUCT_OUTPUT_SINK
+{
+  bool (*pbWriteDir)(void *pvData, const char *kpszPath, mode_t iMode);
+  bool (*pbWriteFile)(void *pvData, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize);
+  bool (*pbFinish)(void *pvData);
+  void *pvData;
+} STRUCT_OUTPUT_SINK, *PSTRUCT_OUTPUT_SINK;
+
+/**
+ * A file of the new project being written, in a temporary
+ * file or in the memory (--output-tar and --dedup)
+ */
+typedef struct STRUCT_NEW_FILE
+{
+  FILE *fpFile;
+  uint64_t ui64Flag;  /* 0 for the files that aren't in the template */
+  bool bInMemory;
+  bool bDedup;        /* From the store (--dedup) */
+  char *pszBuffer;    /* Only when bInMemory */
+  size_t lBufferSize;
+  char szPath[2048+2048+2048];
+  char szTmpPath[2048+2048+2048+32];
+} STRUCT_NEW_FILE, *PSTRUCT_NEW_FILE;
+
+/**
+ * A file created in the new project
+ */
+typedef struct STRUCT_PROJECT_FILE
+{
+  char szRelativePath[_MAX_PATH]; /* Example: src/MyProj.c */
+  mode_t iMode;
+  bool bHashed;                   /* --manifest */
+  uint64_t ui64Hash;
+} STRUCT_PROJECT_FILE, *PSTRUCT_PROJECT_FILE;
+
+/**
+ * Every file created in the new project, in
+ * the order of the creation
+ */
+typedef struct STRUCT_PROJECT_FILES
+{
+  PSTRUCT_PROJECT_FILE pastFiles;
+  int iFilesCount;
+  int iFilesAlloc;
+} STRUCT_PROJECT_FILES;
 
 /******************************************************************************
  *                                                                            *
@@ -169,6 +332,42 @@ extern const char *gkpszProgramName;
  */
 extern bool gbVerbose;
 
+/**
+ * Generate the src/unity_N.c files of the
+ * unity build, default is false
+ */
+extern bool gbUnityBuild;
+
+/**
+ * Create the include/pch.h precompiled
+ * header, default is false
+ */
+extern bool gbPrecompiledHeader;
+
+/**
+ * Watch the template directory and update the
+ * projects when it changes, default is false
+ */
+extern bool gbWatch;
+
+/**
+ * Never ask in the terminal, the required
+ * fields missing are an error, default is false
+ */
+extern bool gbNonInteractive;
+
+/**
+ * Create the Makefile of the projects directory,
+ * that builds all the projects, default is false
+ */
+extern bool gbMonorepo;
+
+/**
+ * Create the bench/ microbenchmarks of
+ * the new project, default is false
+ */
+extern bool gbBench;
+
 /**
  * Example: /home/user/Templates/template
  */
@@ -191,6 +390,46 @@ extern char gszFullNewProjectPathDir[2048+2048];
  */
 extern char gszFullNewFileNamePath[2048+2048+2048];
 
+/**
+ * Files of gszTemplatePathDir, read once
+ * before the creation of the project
+ */
+extern STRUCT_TEMPLATE_INDEX gstTemplateIndex;
+
+/**
+ * Files created in the new project
+ */
+extern STRUCT_PROJECT_FILES gstProjectFiles;
+
+/**
+ * Tar archive of --output-tar, written
+ * by the sink of tar.c
+ */
+extern FILE *gfpOutputTar;
+
+/**
+ * Sink of the files of the new project, NULL
+ * when the project is created in the disk
+ */
+extern PSTRUCT_OUTPUT_SINK gpstOutputSink;
+
+/**
+ * Lock of gstProjectFiles and gpstOutputSink, the
+ * files of the template tree are created by threads
+ */
+extern pthread_mutex_t gstProjectFilesMutex;
+
+/**
+ * Last message of vPrintErrorMessage, without the colors
+ */
+extern char gszLastError[1024];
+
+/**
+ * Print the errors in the stderr, default is true (the
+ * library keeps only the message in gszLastError)
+ */
+extern bool gbPrintErrors;
+
 
 /******************************************************************************
  *                                                                            *
@@ -213,6 +452,12 @@ void vPrintVersion(void);
  */
 void vPrintErrorMessage(const char *kpszFmt, ...);
 
+/**
+ * Print a message when gbVerbose is set, in the stderr
+ * when the tar archive is written in the stdout
+ */
+void vPrintVerbose(const char *kpszFmt, ...);
+
 /**
  * Check if what wass passed on the command line is valid
  */
@@ -254,6 +499,13 @@ int iInitMkcproj(void);
  */
 int iGetProjInfo(void);
 
+/**
+ * Ask a required field until it is typed, when it
+ * is not already in the command line or the profile
+ */
+bool bAskRequiredField(const char *kpszPrompt, const char *kpszError, const char *kpszRetry,
+                       char *pszField, size_t lFieldSize);
+
 /**
  *
  */
@@ -277,26 +529,207 @@ int iGetNewFileName(uint64_t ui64Flag, char *pszNewFileName);
  */
 int iGetNewFullFileNamePath(uint64_t ui64Flag);
 
+/**
+ * Read the files of gszTemplatePathDir/kpszRelativeDir
+ * (and of your subdirectories) to gstTemplateIndex
+ */
+int iIndexTemplateDir(const char *kpszRelativeDir);
+
+/**
+ * Read the template archive (--template-archive) or the template
+ * directory to a sorted gstTemplateIndex
+ */
+int iIndexTemplate(void);
+
+/**
+ * qsort() and bsearch() callback to sort STRUCT_TEMPLATE_FILE
+ * by the relative path
+ */
+int iCompareTemplateFiles(const void *kpvFirst, const void *kpvSecond);
+
+/**
+ * Sort gstTemplateIndex, must be called after the last
+ * call of iIndexTemplateDir
+ */
+void vSortTemplateIndex(void);
+
+/**
+ * Free the memory of gstTemplateIndex
+ */
+void vFreeTemplateIndex(void);
+
+/**
+ * Search the template of the file in gstTemplateIndex,
+ * returns NULL if it doesn't exist in the template directory
+ */
+PSTRUCT_TEMPLATE_FILE pstGetTemplateFile(uint64_t ui64Flag);
+
+/**
+ * Check if every one of REQUIRED_FILES is in gstTemplateIndex,
+ * showing all of missing files at once
+ */
+bool bRequiredTemplateFilesExist(void);
+
 /**
  * Create a file of the new C project
  */
 int iCreateFile(uint64_t ui64Flag);
 
+/**
+ * Read a template file of the disk in pstTemplateFile->pszContent,
+ * with a single read(). The content is freed with the index.
+ */
+bool bLoadTemplateFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile, const char *kpszFullTemplateFileNamePath);
+
+/**
+ * Open a template file, from the memory: read from an
+ * archive or loaded by bLoadTemplateFile
+ */
+FILE *fpOpenTemplateFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile, const char *kpszFullTemplateFileNamePath);
+
+/**
+ * Open a new file of the project: a temporary file in the
+ * disk or a buffer in the memory (--output-tar and --dedup)
+ */
+bool bOpenNewFile(PSTRUCT_NEW_FILE pstNewFile, const char *kpszPath, uint64_t ui64Flag);
+
+/**
+ * Close a new file of the project: rename the temporary file,
+ * write the buffer in the tar archive or take it from the store
+ */
+bool bCloseNewFile(PSTRUCT_NEW_FILE pstNewFile, mode_t iMode);
+
+/**
+ * Add a file to gstProjectFiles
+ */
+bool bAddProjectFile(const char *kpszPath, mode_t iMode);
+
+/**
+ * Path of a file in the tar archive, relative to
+ * gszProjectsPathDir. Example: MyProj/src/MyProj.c
+ */
+const char *pszGetTarPath(const char *kpszPath);
+
 /**
  * Create the direcotories of the new C project
  */
 int iCreateDirectories(uint64_t ui64Flag);
 
 /**
- * Header comment of files
+ * Header comment of files, in the comment style of
+ * the file (see banner.h)
  */
-bool bCreateHeaderComment(uint64_t ui64Flag);
+bool bCreateHeaderComment(FILE *fpFile, uint64_t ui64Flag);
 
 /**
  * Skip the template header comment during the copy
  * of files (.c, .h and Makefile)
  */
-void vSkipTemplateHeaderComment(void);
+void vSkipTemplateHeaderComment(FILE *fpTemplate);
+
+/**
+ * Write a line of the template in the new file, replacing
+ * "template" and "TEMPLATE" by the name of the project
+ */
+void vReplaceTemplateName(FILE *fpNewFile, const char *kpszLine);
+
+/**
+ * Number of .c files included by each unity file
+ */
+int iGetUnityBatchSize(void);
+
+/**
+ * qsort() callback to sort an array of strings
+ */
+int iCompareStrings(const void *kpvFirst, const void *kpvSecond);
+
+/**
+ * Create the src/unity_N.c files of the unity build, each
+ * one including a batch of the .c files of the new project
+ */
+int iCreateUnityFiles(void);
+
+/**
+ * Directive of a line that starts with '#', e.g. "include <stdio.h>"
+ */
+char *pszGetDirective(char *pszLine);
+
+/**
+ * True if pszIfLine is "#ifndef MACRO" and pszDefineLine "#define MACRO"
+ */
+bool bIsIncludeGuard(char *pszIfLine, char *pszDefineLine);
+
+/**
+ * Create the include/pch.h precompiled header with the #include
+ * lines of the header of the new project and their #if blocks
+ */
+int iCreatePrecompiledHeader(void);
+
+/**
+ * Create the bench/ directory with the runner of the
+ * microbenchmarks and the mkbench script (--bench)
+ */
+int iCreateBench(void);
+
+/**
+ * Save the information of the project in PROJECT_INFO_FILE
+ */
+int iCreateProjectInfoFile(void);
+
+/**
+ * Create the non-recursive Makefile of gszProjectsPathDir,
+ * that builds every project in a single make
+ */
+int iCreateMonorepoMakefile(void);
+
+/**
+ * Load the PROJECT_INFO_FILE of a project created before
+ * and set gszFullNewProjectPathDir with your directory
+ */
+bool bLoadProjectInfo(const char *kpszProjectPathDir);
+
+/**
+ * Get the flag of the file created from a template,
+ * returns 0 if it isn't a file of PROJECT_FILES
+ *
+ * Example: "src/template.c" returns SOURCE_FILE
+ */
+uint64_t ui64GetTemplateFileFlag(const char *kpszRelativePath);
+
+/**
+ * Create again the files in ui64Flags of the project
+ * loaded by bLoadProjectInfo
+ */
+int iUpdateProjectFiles(uint64_t ui64Flags);
+
+/**
+ * Add a inotify watch to kpszRelativeDir of the template
+ * directory and to each one of your subdirectories
+ */
+int iAddTemplateWatches(PSTRUCT_TEMPLATE_WATCH pstWatch, const char *kpszRelativeDir);
+
+/**
+ * Save the path of a changed template file that isn't
+ * a flag, the tree walk creates it again
+ */
+bool bAddWatchTreePath(PSTRUCT_TEMPLATE_WATCH pstWatch, const char *kpszRelativePath);
+
+/**
+ * Free the paths saved by bAddWatchTreePath
+ */
+void vFreeWatchTreePaths(PSTRUCT_TEMPLATE_WATCH pstWatch);
+
+/**
+ * Read the pending inotify events, returns the flags
+ * of the changed template files
+ */
+uint64_t ui64ReadTemplateEvents(PSTRUCT_TEMPLATE_WATCH pstWatch);
+
+/**
+ * Watch the template directory and, on each change, create
+ * again only the changed files in every project directory
+ */
+int iWatchTemplateDir(int iProjectsCount, char **ppszProjectsPathDir);
 
 /**
  * Create a new C project using the functions
@@ -304,5 +737,11 @@ void vSkipTemplateHeaderComment(void);
  */
 int iMakeProject(void);
 
+/**
+ * Create the project of gstCmdLine in the sink (NULL: in the
+ * disk, locked against other mkcproj). It never exits.
+ */
+int iGenerateProject(PSTRUCT_OUTPUT_SINK pstSink);
+
 #endif /* _MKCPROJ_H_ */
 
@@ -0,0 +1,72 @@
+/**
+ * module.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Add a module (src/NAME.c and include/NAME.h)
+ *              to a project created before (--add-module)
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _MODULE_H_
+#define _MODULE_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Makefile of the project, patched when it lists the files
+ */
+#define MODULE_MAKEFILE "Makefile"
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The name of a module is a C identifier, used in the
+ * name of the files and in the include guard
+ */
+bool bIsValidModuleName(const char *kpszModuleName);
+
+/**
+ * Create include/NAME.h with the banner of the project
+ */
+int iCreateModuleHeader(const char *kpszModuleName);
+
+/**
+ * Create src/NAME.c with the banner of the project
+ */
+int iCreateModuleSource(const char *kpszModuleName);
+
+/**
+ * Add the module to the list of objects (or sources) of the
+ * Makefile, after the last one and in the same form. A Makefile
+ * with $(wildcard ...) already builds it and is not changed.
+ */
+int iAddModuleToMakefile(const char *kpszModuleName);
+
+/**
+ * mkcproj --add-module NAME [DIR], create only the files
+ * of the module in the project DIR, the others are not
+ * touched (so make rebuilds only the module)
+ */
+int iAddModule(const char *kpszModuleName, const char *kpszProjectPathDir);
+
+#endif /* _MODULE_H_ */
@@ -0,0 +1,112 @@
+/**
+ * profile.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Profile of the developer, saved once and used
+ *              by the next projects without ask it again
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <strings.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Profile of the developer, relative to
+ * $XDG_CONFIG_HOME (default is ~/.config)
+ */
+#define PROFILE_DIR  "mkcproj"
+#define PROFILE_FILE "profile"
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Values of the profile, empty when not found
+ */
+typedef struct STRUCT_PROFILE
+{
+  char szDevName    [_MAX_PATH];
+  char szDevMail    [_MAX_PATH];
+  char szLicense    [_MAX_PATH];
+  char szTemplateDir[_MAX_PATH];
+  char szProjectsDir[_MAX_PATH];
+} STRUCT_PROFILE;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Profile loaded by iLoadProfile
+ */
+extern STRUCT_PROFILE gstProfile;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Path of a file in $XDG_CONFIG_HOME or ~/.config
+ *
+ * Example: /home/user/.config/mkcproj/profile
+ */
+void vGetConfigPath(char *pszPath, size_t lPathSize, const char *kpszRelativePath);
+
+/**
+ * Read the KEY = value lines of the profile
+ */
+bool bReadProfile(const char *kpszProfilePath);
+
+/**
+ * Read the name and the e-mail of the [user] section
+ * of a git config file, without run git
+ */
+bool bReadGitConfigUser(const char *kpszGitConfigPath);
+
+/**
+ * Load the profile once, with the user of the git config
+ * as fallback, and fill the fields that are not in the
+ * command line
+ */
+int iLoadProfile(void);
+
+/**
+ * Save the profile when it doesn't exist yet, with the
+ * template directory answered by the developer (can be
+ * empty, then the profile has no TEMPLATE_DIR)
+ */
+int iSaveProfile(const char *kpszTemplateDir);
+
+/**
+ * Check the fields required to create a project,
+ * printing the missing ones when bPrintMissing
+ */
+bool bRequiredProjInfoExist(bool bPrintMissing);
+
+#endif /* _PROFILE_H_ */
@@ -0,0 +1,173 @@
+/**
+ * rename.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Rename a project created by mkcproj (--rename),
+ *              its files and the name in the content of them
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _RENAME_H_
+#define _RENAME_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Maximum number of threads of the tree walk
+ */
+#define RENAME_MAX_THREADS 64
+
+/**
+ * Bytes read to know if a file is binary (has a '\0'),
+ * the content of the binary files is not changed
+ */
+#define RENAME_BINARY_CHECK_SIZE 8192
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A directory to read or a file to rewrite,
+ * relative to the directory of the project
+ */
+typedef struct STRUCT_RENAME_JOB
+{
+  char szRelativePath[_MAX_PATH];
+  bool bDir;
+} STRUCT_RENAME_JOB, *PSTRUCT_RENAME_JOB;
+
+/**
+ * A file or directory changed by the rename, with the hashes
+ * of the file before and after it (to update the manifest)
+ */
+typedef struct STRUCT_RENAMED_FILE
+{
+  char szRelativePath[_MAX_PATH];
+  char szNewRelativePath[_MAX_PATH];
+  uint64_t ui64OldHash;
+  uint64_t ui64NewHash;
+  bool bDir;
+} STRUCT_RENAMED_FILE, *PSTRUCT_RENAMED_FILE;
+
+/**
+ * Jobs shared by the threads of the tree walk. The walk
+ * ends when there is no job in the queue and no thread
+ * running a job (iPending == 0).
+ */
+typedef struct STRUCT_RENAME_QUEUE
+{
+  PSTRUCT_RENAME_JOB pastJobs;
+  int iJobsCount;
+  int iJobsAlloc;
+  int iPending;
+  int iErrors;
+  long lFilesCount;
+  PSTRUCT_RENAMED_FILE pastRenamed;
+  int iRenamedCount;
+  int iRenamedAlloc;
+  pthread_mutex_t stMutex;
+  pthread_cond_t stCond;
+  char szProjectDir[_MAX_PATH];
+  char szOldName[_MAX_PATH];
+  char szUpperOldName[_MAX_PATH];
+  char szNewName[_MAX_PATH];
+  char szUpperNewName[_MAX_PATH];
+} STRUCT_RENAME_QUEUE, *PSTRUCT_RENAME_QUEUE;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Files and directories that are not renamed: the outputs
+ * removed by "make distclean" (obj, bin and *.log) and the
+ * hidden ones (.git, ...), except the PROJECT_INFO_FILE
+ */
+bool bIsRenameIgnored(const char *kpszRelativePath, const char *kpszName, bool bDir);
+
+/**
+ * Next kpszName in the content, only the whole names: "foo" is
+ * found in "foo.h", "_FOO_H_" and "bench_foo.c", not in "food"
+ */
+const char *kpszFindName(const char *kpszBegin, const char *kpszStart, const char *kpszEnd,
+                         const char *kpszName, size_t lNameLen);
+
+/**
+ * Replace the old name of the project by the new one,
+ * in lower and upper case
+ */
+int iWriteNewName(FILE *fpFile, const char *kpszContent, size_t lSize, PSTRUCT_RENAME_QUEUE pstQueue);
+
+/**
+ * Relative path with the new name of the project
+ *
+ * Example: bench/bench_old.c -> bench/bench_new.c
+ */
+void vGetNewPath(const char *kpszRelativePath, char *pszNewPath, size_t lNewPathSize,
+                 PSTRUCT_RENAME_QUEUE pstQueue);
+
+/**
+ * Add a job to the queue, the mutex must be locked
+ */
+bool bPushRenameJob(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath, bool bDir);
+
+/**
+ * Add a changed file to the queue, the mutex must be locked
+ */
+bool bPushRenamedFile(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath, const char *kpszNewRelativePath,
+                      uint64_t ui64OldHash, uint64_t ui64NewHash, bool bDir);
+
+/**
+ * Read a directory of the project and add its entries to the queue
+ */
+int iRenameDir(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath);
+
+/**
+ * Rewrite a file of the project, mapped in the memory, in a
+ * temporary file that replaces it (readers never see half of
+ * the file). The files without the old name are not touched.
+ */
+int iRenameFile(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath);
+
+/**
+ * Thread of the tree walk
+ */
+void *pvRenameWorker(void *pvQueue);
+
+/**
+ * Update the paths and the hashes of the manifest of the project,
+ * the hash of a file changed by the developer stays the old one
+ */
+int iUpdateRenamedManifest(PSTRUCT_RENAME_QUEUE pstQueue);
+
+/**
+ * mkcproj --rename OLD NEW DIR, rename the project kpszOldName
+ * in kpszProjectPathDir to kpszNewName
+ */
+int iRenameProject(const char *kpszOldName, const char *kpszNewName, const char *kpszProjectPathDir);
+
+#endif /* _RENAME_H_ */
@@ -0,0 +1,132 @@
+/**
+ * store.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Store of the files shared by the projects, each
+ *              distinct content is saved once and cloned or
+ *              linked in the projects (--dedup)
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _STORE_H_
+#define _STORE_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Directory of the store, inside of gszProjectsPathDir
+ */
+#define STORE_DIR ".mkcproj-store"
+
+/**
+ * Files saved in the store, the same in most of the projects.
+ * The scripts have a banner with the name of the project, so
+ * their content is never the same in two projects.
+ */
+#define DEDUP_FILES (INSTALL_FILE | LICENSE_FILE)
+
+/**
+ * Files that nobody edits in the project, hard linked
+ * to the store (read only) when the file system can't
+ * clone them. The others are copied in this case.
+ */
+#define DEDUP_LINK_FILES (LICENSE_FILE)
+
+/**
+ * Directories of the template tree with the libtrace and
+ * libcutils files, created by tree.c. Their files go to
+ * the store and are linked as DEDUP_LINK_FILES.
+ */
+#define STORE_TREE_DIRS { "include/trace/", "include/cutils/", "lib/", NULL }
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The file system of the store can clone (reflink) the files
+ */
+typedef enum ENUM_STORE_CLONE
+{
+  STORE_CLONE_UNKNOWN = 0,
+  STORE_CLONE_SUPPORTED,
+  STORE_CLONE_UNSUPPORTED
+} ENUM_STORE_CLONE;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Save the shared files in the store, default is false
+ */
+extern bool gbDedupStore;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * 64-bit FNV-1a hash of a content
+ */
+uint64_t ui64HashContent(const char *kpszContent, size_t lSize);
+
+/**
+ * Check if a file has exactly this content
+ */
+bool bFileHasContent(const char *kpszPath, const char *kpszContent, size_t lSize);
+
+/**
+ * A file of the project in STORE_TREE_DIRS
+ */
+bool bIsStoreTreeFile(const char *kpszPath);
+
+/**
+ * Path of a content in the store, saving it when it
+ * isn't there yet (*pbCreated is true in this case).
+ *
+ * Example: /home/user/Projects/.mkcproj-store/3f/3f2a...-1211-555
+ */
+bool bGetStoreFile(const char *kpszContent, size_t lSize, mode_t iMode,
+                   char *pszStorePath, size_t lStorePathSize, bool *pbCreated);
+
+/**
+ * Clone (reflink) a file: the copy shares the blocks
+ * of the original until one of them is changed
+ */
+bool bCloneFile(const char *kpszSrcPath, const char *kpszDestPath, mode_t iMode);
+
+/**
+ * Create a file of the project from the store, cloned or
+ * hard linked. False when it must be written as usual,
+ * then the store doesn't keep a new copy of the content.
+ */
+bool bLinkStoreFile(const char *kpszPath, const char *kpszTmpPath, uint64_t ui64Flag,
+                    const char *kpszContent, size_t lSize, mode_t iMode);
+
+#endif /* _STORE_H_ */
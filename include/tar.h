@@ -0,0 +1,105 @@
+/**
+ * tar.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Read the template files from tar archives and
+ *              write the new projects as tar archives
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _TAR_H_
+#define _TAR_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <zlib.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Size of the header and data blocks of a tar archive
+ */
+#define TAR_BLOCK_SIZE 512
+
+/**
+ * Type of the tar entries
+ */
+#define TAR_TYPE_FILE '0'
+#define TAR_TYPE_DIR  '5'
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Convert a octal number field of a tar header
+ */
+long lGetTarNumber(const char *kpszField, size_t lFieldLen);
+
+/**
+ * Add a file read from a template archive to gstTemplateIndex,
+ * the index takes the ownership of pszContent
+ */
+int iAddArchiveTemplateFile(const char *kpszRelativePath, mode_t iMode, char *pszContent, off_t lSize);
+
+/**
+ * Remove the directory that contains every file of the
+ * archive, e.g. "template/src/template.c" -> "src/template.c"
+ */
+void vStripArchiveTopDir(void);
+
+/**
+ * Read every file of a .tar or .tar.gz archive to gstTemplateIndex
+ * in a single pass, without extract them to the disk
+ */
+int iIndexTemplateArchive(const char *kpszArchivePath);
+
+/**
+ * Write the ustar header of a entry of the archive, names longer
+ * than 100 characters are splitted in the prefix field
+ */
+bool bWriteTarHeader(FILE *fpTar, const char *kpszPath, mode_t iMode, off_t lSize, char chType);
+
+/**
+ * Write a regular file (header, data and padding) in the archive
+ */
+bool bWriteTarFile(FILE *fpTar, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize);
+
+/**
+ * Write a directory in the archive
+ */
+bool bWriteTarDir(FILE *fpTar, const char *kpszPath, mode_t iMode);
+
+/**
+ * Write the two empty blocks at the end of the archive
+ */
+bool bWriteTarEnd(FILE *fpTar);
+
+/**
+ * Callbacks of the sink of --output-tar, pvTar is the archive
+ */
+bool bWriteTarSinkDir(void *pvTar, const char *kpszPath, mode_t iMode);
+bool bWriteTarSinkFile(void *pvTar, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize);
+bool bFinishTarSink(void *pvTar);
+
+/**
+ * Sink that writes the new project in the tar archive fpTar
+ */
+void vInitTarSink(PSTRUCT_OUTPUT_SINK pstSink, FILE *fpTar);
+
+#endif /* _TAR_H_ */
@@ -0,0 +1,142 @@
+/**
+ * trace_events.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Record the "%s - begin" and "%s - end" messages
+ *              of the functions as spans of a Chrome trace-event
+ *              JSON file (--trace-events), opened in Perfetto or
+ *              chrome://tracing
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _TRACE_EVENTS_H_
+#define _TRACE_EVENTS_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "trace.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A begin ('B') or end ('E') of a function
+ */
+typedef struct STRUCT_TRACE_EVENT
+{
+  const char *kpszName; /* __func__, valid until the end of the program */
+  char chPhase;
+  int iThreadId;
+  uint64_t ui64TimeNs;
+} STRUCT_TRACE_EVENT, *PSTRUCT_TRACE_EVENT;
+
+/**
+ * Events recorded until the exit of the program
+ */
+typedef struct STRUCT_TRACE_EVENTS
+{
+  PSTRUCT_TRACE_EVENT pastEvents;
+  int iEventsCount;
+  int iEventsAlloc;
+  pthread_mutex_t stMutex;
+  uint64_t ui64StartNs;
+  char szFileName[4096];
+} STRUCT_TRACE_EVENTS;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Record the spans of the functions, default is false
+ */
+extern bool gbTraceEvents;
+
+/**
+ * Spans recorded by vAddTraceEvent
+ */
+extern STRUCT_TRACE_EVENTS gstTraceEvents;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * INFO_DETAILS of libtrace, without the spans
+ */
+static inline bool bTraceInfoDetails(void)
+{
+  return INFO_DETAILS;
+}
+
+/**
+ * The messages of vTraceEvent go to the vTraceInfo of libtrace
+ * and are recorded as spans, so the "if(INFO_DETAILS) vTraceEvent(...)"
+ * of every function is also executed when only --trace-events is given
+ */
+#undef INFO_DETAILS
+#define INFO_DETAILS (gbTraceEvents || bTraceInfoDetails())
+
+#define vTraceEvent(...) vTraceEventsInfo(__VA_ARGS__)
+
+/**
+ * Formats of the messages recorded as spans, with the name of
+ * the function. An end can have more text after a space.
+ *
+ * Example: "%s - end iRsl == %d"
+ */
+#define TRACE_EVENT_BEGIN "%s - begin"
+#define TRACE_EVENT_END   "%s - end"
+
+/**
+ * Time of CLOCK_MONOTONIC in nanoseconds
+ */
+uint64_t ui64GetTimeNs(void);
+
+/**
+ * Start the record of the spans, written in kpszFileName
+ * at the exit of the program
+ */
+int iInitTraceEvents(const char *kpszFileName);
+
+/**
+ * The format is kpszEvent, alone or followed by a space
+ */
+bool bIsTraceEventFormat(const char *kpszFmt, const char *kpszEvent);
+
+/**
+ * Record a span when kpszFmt is TRACE_EVENT_BEGIN or TRACE_EVENT_END,
+ * and send the message to the vTraceInfo of libtrace
+ */
+void vTraceEventsInfo(const char *kpszFmt, ...);
+
+/**
+ * Record a begin ('B') or end ('E') of a function
+ */
+void vAddTraceEvent(const char *kpszName, char chPhase);
+
+/**
+ * Write the recorded spans in the JSON file
+ */
+void vWriteTraceEvents(void);
+
+#endif /* _TRACE_EVENTS_H_ */
@@ -0,0 +1,187 @@
+/**
+ * tree.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Create the files of the template that aren't one
+ *              of the files of mkcproj (the flags), with the names
+ *              replaced by the substitution rules
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _TREE_H_
+#define _TREE_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "mkcproj.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Maximum number of threads that create the files
+ */
+#define TREE_MAX_THREADS 64
+
+/**
+ * Files of each thread, a small tree is created
+ * without start threads
+ */
+#define TREE_FILES_PER_THREAD 16
+
+/**
+ * Maximum number of substitution rules
+ */
+#define TREE_MAX_RULES 16
+
+/**
+ * Bytes read to know if a file is binary (has a '\0'),
+ * the binary files are copied without changes
+ */
+#define TREE_BINARY_CHECK_SIZE 8192
+
+/**
+ * Files of the template created by the code of mkcproj (with
+ * the banner, only with its option, ...), the tree skips them
+ */
+#define TREE_FLAG_FILES (PROJECT_FILES | BENCH_FILES)
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Replace szFrom by szTo, in the paths and in the content
+ *
+ * Example: template -> MyProj
+ */
+typedef struct STRUCT_TREE_RULE
+{
+  char szFrom[_MAX_PATH];
+  char szTo[_MAX_PATH];
+  size_t lFromLen;
+} STRUCT_TREE_RULE, *PSTRUCT_TREE_RULE;
+
+/**
+ * A file of the template and its path in the project
+ */
+typedef struct STRUCT_TREE_JOB
+{
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile;
+  char szNewRelativePath[_MAX_PATH];
+} STRUCT_TREE_JOB, *PSTRUCT_TREE_JOB;
+
+/**
+ * Files shared by the threads, each one takes the
+ * next job (iNextJob) until the end of the list
+ */
+typedef struct STRUCT_TREE_QUEUE
+{
+  PSTRUCT_TREE_JOB pastJobs;
+  int iJobsCount;
+  int iJobsAlloc;
+  int iNextJob;
+  int iErrors;
+  STRUCT_TREE_RULE astRules[TREE_MAX_RULES];
+  int iRulesCount;
+  pthread_mutex_t stMutex;
+} STRUCT_TREE_QUEUE, *PSTRUCT_TREE_QUEUE;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Add a substitution rule, the first one added
+ * wins when two rules match in the same place
+ */
+bool bAddTreeRule(PSTRUCT_TREE_QUEUE pstQueue, const char *kpszFrom, const char *kpszTo);
+
+/**
+ * Rules of the project: "template" -> name of the
+ * project and "TEMPLATE" -> name in upper case
+ */
+bool bInitTreeRules(PSTRUCT_TREE_QUEUE pstQueue);
+
+/**
+ * Replace the matches of the rules in the content
+ */
+int iWriteTreeRules(FILE *fpFile, const char *kpszContent, size_t lSize, PSTRUCT_TREE_QUEUE pstQueue);
+
+/**
+ * Relative path in the project of a template file
+ *
+ * Example: src/template_util.c -> src/MyProj_util.c
+ */
+void vGetTreePath(const char *kpszRelativePath, char *pszNewPath, size_t lNewPathSize,
+                  PSTRUCT_TREE_QUEUE pstQueue);
+
+/**
+ * Add a file to the list of jobs
+ */
+bool bPushTreeJob(PSTRUCT_TREE_QUEUE pstQueue, PSTRUCT_TEMPLATE_FILE pstTemplateFile);
+
+/**
+ * Create the directories of the files, before the threads
+ */
+int iCreateTreeDirs(PSTRUCT_TREE_QUEUE pstQueue);
+
+/**
+ * Create a file of the project from its template,
+ * the binary files are copied without changes
+ */
+int iCreateTreeFile(PSTRUCT_TREE_QUEUE pstQueue, PSTRUCT_TREE_JOB pstJob);
+
+/**
+ * Thread that creates the files
+ */
+void *pvTreeWorker(void *pvQueue);
+
+/**
+ * Template files that are never in the tree: temporary
+ * files and the modules of --with
+ */
+bool bIsTreeSkipped(const char *kpszRelativePath);
+
+/**
+ * The template file is one of TREE_FLAG_FILES
+ */
+bool bIsTreeFlagFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile);
+
+/**
+ * Create the directories and the files of the jobs,
+ * with threads when there are many files
+ */
+int iRunTreeJobs(PSTRUCT_TREE_QUEUE pstQueue);
+
+/**
+ * Create every file of the template that isn't one of
+ * TREE_FLAG_FILES, in any directory of the template
+ */
+int iCreateTemplateTree(void);
+
+/**
+ * Create again the files of the tree with these relative
+ * paths in the template (--watch), the others are skipped
+ */
+int iUpdateTemplateTree(char **ppszRelativePaths, int iPathsCount);
+
+#endif /* _TREE_H_ */
@@ -0,0 +1,70 @@
+/**
+ * with.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Add the modules of the template (arena, pool, ...)
+ *              to the project, with their tests and benchmarks
+ *              (--with)
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _WITH_H_
+#define _WITH_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include "mkcproj.h"
+#include "tree.h"
+#include "trace.h"
+#include "cutils/cutils.h"
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Directory of the modules in the template, each module has
+ * the directories of the project (src, include, tests, bench)
+ *
+ * Example: with/arena/src/arena.c -> src/arena.c
+ */
+#define WITH_TEMPLATE_DIR "with/"
+
+/**
+ * Separator of the modules of --with
+ */
+#define WITH_SEPARATOR ","
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The name of a module has only lower case letters,
+ * digits, '-' and '_'
+ */
+bool bIsValidWithModule(const char *kpszModule);
+
+/**
+ * Add the files of the module to the jobs, with the path
+ * in the project. Return the number of files, 0 when the
+ * template doesn't have the module and -1 on error.
+ */
+int iPushWithModule(PSTRUCT_TREE_QUEUE pstQueue, const char *kpszModule);
+
+/**
+ * Create the files of the modules of --with
+ */
+int iCreateWithModules(void);
+
+#endif /* _WITH_H_ */
@@ -0,0 +1,337 @@
+/**
+ * banner.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Header comment (banner) of the files of the new
+ *              projects, rendered once for each comment style
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "banner.h"
+
+STRUCT_BANNER_CACHE gstBannerCache;
+
+/**
+ * Opening line, prefix of the lines, prefix of the empty
+ * lines and closing line of each comment style
+ */
+static const char *kaszCommentStyle[COMMENT_STYLE_COUNT][4] = {
+  { "/**\n" , " * "   , " *"   , " */\n"   },
+  { ""      , "# "    , "#"    , "#\n"     },
+  { ""      , ".\\\" ", ".\\\"", ".\\\"\n" },
+  { "<!--\n", "  "    , ""     , "-->\n"   }
+};
+
+ENUM_COMMENT_STYLE eGetCommentStyle(uint64_t ui64Flag)
+{
+  if(ui64Flag & COMMENT_C_FILES)
+  {
+    return COMMENT_STYLE_C;
+  }
+
+  if(ui64Flag & COMMENT_HASH_FILES)
+  {
+    return COMMENT_STYLE_HASH;
+  }
+
+  if(ui64Flag & COMMENT_ROFF_FILES)
+  {
+    return COMMENT_STYLE_ROFF;
+  }
+
+  if(ui64Flag & COMMENT_HTML_FILES)
+  {
+    return COMMENT_STYLE_HTML;
+  }
+
+  return COMMENT_STYLE_NONE;
+}
+
+void vWriteCommentLines(FILE *fpBanner, ENUM_COMMENT_STYLE eStyle, const char *kpszText)
+{
+  const char *kpszLineEnd = NULL;
+  size_t lLineLen = 0;
+
+  while(*kpszText != '\0')
+  {
+    kpszLineEnd = strchr(kpszText, '\n');
+    lLineLen = kpszLineEnd != NULL ? (size_t) (kpszLineEnd - kpszText) : strlen(kpszText);
+
+    if(lLineLen == 0)
+    {
+      fputs(kaszCommentStyle[eStyle][2], fpBanner);
+    }
+    else
+    {
+      fputs(kaszCommentStyle[eStyle][1], fpBanner);
+      fwrite(kpszText, 1, lLineLen, fpBanner);
+    }
+
+    fputc('\n', fpBanner);
+
+    if(kpszLineEnd == NULL)
+    {
+      break;
+    }
+
+    kpszText = kpszLineEnd + 1;
+  }
+}
+
+const char *kpszGetLicenseNotice(const char *kpszLicense, char *pszNotice, size_t lNoticeSize)
+{
+  const char *kpszName = NULL;
+  const char *kpszVersion = NULL;
+
+  memset(pszNotice, 0, lNoticeSize);
+
+  if(strncasecmp(kpszLicense, "AGPL", 4) == 0)
+  {
+    kpszName = "GNU Affero General Public License";
+  }
+  else if(strncasecmp(kpszLicense, "LGPL", 4) == 0)
+  {
+    kpszName = "GNU Lesser General Public License";
+  }
+  else if(strncasecmp(kpszLicense, "GPL", 3) == 0)
+  {
+    kpszName = "GNU General Public License";
+  }
+  else
+  {
+    return pszNotice;
+  }
+
+  /* GPLv2, GPL-2.0, LGPLv2.1, ... the default is the last version */
+  for(kpszVersion = kpszLicense; *kpszVersion != '\0' && !isdigit((unsigned char) *kpszVersion); kpszVersion++);
+
+  if(*kpszVersion == '\0')
+  {
+    kpszVersion = "3";
+  }
+
+  snprintf(pszNotice, lNoticeSize,
+      "\n\n"
+      "This program is free software: you can redistribute it and/or modify\n"
+      "it under the terms of the %s as published by\n"
+      "the Free Software Foundation, either version %.*s of the License, or\n"
+      "(at your option) any later version.",
+      kpszName, (int) strspn(kpszVersion, "0123456789."), kpszVersion
+  );
+
+  return pszNotice;
+}
+
+int iRenderBanners(void)
+{
+  PSTRUCT_DATE pstDate = NULL;
+  PSTRUCT_BANNER pstBanner = NULL;
+  FILE *fpBanner = NULL;
+  char *pszBody = NULL;
+  size_t lBodySize = 0;
+  int iStyle;
+  char szKey[sizeof(gstBannerCache.szKey)];
+  char szNotice[1024];
+
+  memset(szKey, 0, sizeof(szKey));
+  memset(szNotice, 0, sizeof(szNotice));
+
+  snprintf(szKey, sizeof(szKey), "%s\n%s\n%s\n%s\n%s", gstCmdLine.szProjName, gstCmdLine.szDevName,
+                                                       gstCmdLine.szDevMail, gstCmdLine.szProjDescription,
+                                                       gstCmdLine.szLicense);
+
+  /* Same project, the banners are already rendered */
+  if(gstBannerCache.bRendered && strcmp(szKey, gstBannerCache.szKey) == 0)
+  {
+    return 0;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  vFreeBanners();
+
+  if((pstDate = (PSTRUCT_DATE) malloc(sizeof(STRUCT_DATE))) == NULL ||
+     (fpBanner = open_memstream(&pszBody, &lBodySize)) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the header comments"));
+
+    free(pstDate);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  vGetCurrentDate(&pstDate);
+
+  /* Lines after the name of the file, without the comment prefix */
+  fprintf(fpBanner,
+      "\n"
+      "Written by %s <%s>\n"
+      "\n"
+      "Description: %s\n"
+      "\n"
+      "Copyright (C) %d %s\n" /* Year and developer name */
+      "\n"
+      "License: %s%s\n"       /* License of the software and its notice */
+      "\n"
+      "Date: %02d/%02d/%04d", /* dd/mm/yyyy */
+      gstCmdLine.szDevName, gstCmdLine.szDevMail, gstCmdLine.szProjDescription,
+      pstDate->iYear, gstCmdLine.szDevName, gstCmdLine.szLicense,
+      kpszGetLicenseNotice(gstCmdLine.szLicense, szNotice, sizeof(szNotice)),
+      pstDate->iDay, pstDate->iMonth, pstDate->iYear
+  );
+
+  fclose(fpBanner);
+  free(pstDate);
+
+  for(iStyle = 0; iStyle < COMMENT_STYLE_COUNT; iStyle++)
+  {
+    pstBanner = &gstBannerCache.astBanners[iStyle];
+
+    if((fpBanner = open_memstream(&pstBanner->pszHead, &pstBanner->lHeadLen)) != NULL)
+    {
+      fprintf(fpBanner, "%s%s", kaszCommentStyle[iStyle][0], kaszCommentStyle[iStyle][1]);
+      fclose(fpBanner);
+    }
+
+    if((fpBanner = open_memstream(&pstBanner->pszTail, &pstBanner->lTailLen)) != NULL)
+    {
+      fputc('\n', fpBanner);
+      vWriteCommentLines(fpBanner, iStyle, pszBody);
+      fputs(kaszCommentStyle[iStyle][3], fpBanner);
+      fclose(fpBanner);
+    }
+
+    if(pstBanner->pszHead == NULL || pstBanner->pszTail == NULL)
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the header comments"));
+
+      free(pszBody);
+      vFreeBanners();
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+  }
+
+  free(pszBody);
+
+  snprintf(gstBannerCache.szKey, sizeof(gstBannerCache.szKey), "%s", szKey);
+  gstBannerCache.bRendered = true;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+void vFreeBanners(void)
+{
+  int iStyle;
+
+  for(iStyle = 0; iStyle < COMMENT_STYLE_COUNT; iStyle++)
+  {
+    free(gstBannerCache.astBanners[iStyle].pszHead);
+    free(gstBannerCache.astBanners[iStyle].pszTail);
+  }
+
+  memset(&gstBannerCache, 0, sizeof(gstBannerCache));
+}
+
+bool bWriteBanner(FILE *fpFile, ENUM_COMMENT_STYLE eStyle, const char *kpszFileName)
+{
+  PSTRUCT_BANNER pstBanner = NULL;
+
+  if(eStyle == COMMENT_STYLE_NONE)
+  {
+    return true;
+  }
+
+  if(iRenderBanners() != 0)
+  {
+    return false;
+  }
+
+  pstBanner = &gstBannerCache.astBanners[eStyle];
+
+  fwrite(pstBanner->pszHead, 1, pstBanner->lHeadLen, fpFile);
+  fputs(kpszFileName, fpFile);
+  fwrite(pstBanner->pszTail, 1, pstBanner->lTailLen, fpFile);
+
+  return ferror(fpFile) == 0;
+}
+
+void vCopyTemplateShebang(FILE *fpTemplate, FILE *fpNewFile)
+{
+  long lLinePos = ftell(fpTemplate);
+  char szLine[4096];
+
+  memset(szLine, 0, sizeof(szLine));
+
+  if(fgets(szLine, sizeof(szLine), fpTemplate) == NULL)
+  {
+    return;
+  }
+
+  if(strncmp(szLine, "#!", 2) == 0)
+  {
+    vReplaceTemplateName(fpNewFile, szLine);
+    return;
+  }
+
+  fseek(fpTemplate, lLinePos, SEEK_SET);
+}
+
+void vSkipTemplateBanner(FILE *fpTemplate, ENUM_COMMENT_STYLE eStyle)
+{
+  long lBlockPos = ftell(fpTemplate);
+  long lLinePos = lBlockPos;
+  bool bBanner = false;
+  bool bHtmlEnd = false;
+  char szLine[4096];
+
+  memset(szLine, 0, sizeof(szLine));
+
+  if(eStyle == COMMENT_STYLE_NONE || eStyle == COMMENT_STYLE_C)
+  {
+    return;
+  }
+
+  while(fgets(szLine, sizeof(szLine), fpTemplate) != NULL)
+  {
+    if(eStyle == COMMENT_STYLE_HASH && (szLine[0] != '#' || szLine[1] == '!'))
+    {
+      break;
+    }
+
+    if(eStyle == COMMENT_STYLE_ROFF && strncmp(szLine, ".\\\"", 3) != 0)
+    {
+      break;
+    }
+
+    if(eStyle == COMMENT_STYLE_HTML && lLinePos == lBlockPos && strncmp(szLine, "<!--", 4) != 0)
+    {
+      break;
+    }
+
+    if(strstr(szLine, "Written by") != NULL)
+    {
+      bBanner = true;
+    }
+
+    lLinePos = ftell(fpTemplate);
+
+    if(eStyle == COMMENT_STYLE_HTML && strstr(szLine, "-->") != NULL)
+    {
+      bHtmlEnd = true;
+      break;
+    }
+  }
+
+  /* Only the banner of the template, the other comments are part of it */
+  fseek(fpTemplate, bBanner && (eStyle != COMMENT_STYLE_HTML || bHtmlEnd) ? lLinePos : lBlockPos, SEEK_SET);
+}
@@ -9,8 +9,12 @@
  */
 
 #include "cmdline.h"
+#include "store.h"
+#include "complete.h"
+#include "lock.h"
+#include "manifest.h"
 
-static const char *kszOptStr = "hvt:d:cC:p:n:e:D:l:V";
+static const char *kszOptStr = "hvt:d:cC:p:n:e:D:l:Vub:PT:wA:O:NSE:X:MLmK:BR:a:W:";
 
 /**
  * Command line structure and strings
@@ -28,6 +32,25 @@ struct option astCmdOpt[] = {
   { "project-description", required_argument,    0, 'D' },
   { "license"            , required_argument,    0, 'l' },
   { "verbose"            , no_argument      ,    0, 'V' },
+  { "unity"              , no_argument      ,    0, 'u' },
+  { "unity-batch"        , required_argument,    0, 'b' },
+  { "pch"                , no_argument      ,    0, 'P' },
+  { "template-dir"       , required_argument,    0, 'T' },
+  { "watch"              , no_argument      ,    0, 'w' },
+  { "template-archive"   , required_argument,    0, 'A' },
+  { "output-tar"         , required_argument,    0, 'O' },
+  { "non-interactive"    , no_argument      ,    0, 'N' },
+  { "dedup"              , no_argument      ,    0, 'S' },
+  { "trace-events"       , required_argument,    0, 'E' },
+  { "extract-template"   , required_argument,    0, 'X' },
+  { "monorepo"           , no_argument      ,    0, 'M' },
+  { "merge-logs"         , no_argument      ,    0, 'L' },
+  { "manifest"           , no_argument      ,    0, 'm' },
+  { "verify"             , required_argument,    0, 'K' },
+  { "bench"              , no_argument      ,    0, 'B' },
+  { "rename"             , required_argument,    0, 'R' },
+  { "add-module"         , required_argument,    0, 'a' },
+  { "with"               , required_argument,    0, 'W' },
   { NULL                 , 0                , NULL,  0  }
 };
 
@@ -48,6 +71,25 @@ const char *pszCmdArguments[] = {
   "text",
   "text",
   NULL,
+  NULL,
+  "number",
+  NULL,
+  "dir",
+  NULL,
+  "file",
+  "file",
+  NULL,
+  NULL,
+  "file",
+  "dir",
+  NULL,
+  NULL,
+  NULL,
+  "dir",
+  NULL,
+  "text",
+  "text",
+  "list",
   NULL
 };
 
@@ -68,6 +110,25 @@ const char *pszCmdMessages[] = {
   "<text> is the project description",
   "<text> is the license of project",
   "Show the detailed creation of project",
+  "Create the src/unity_N.c files of the unity build (make UNITY=1)",
+  "<number> is the number of .c files in each unity file",
+  "Create the include/pch.h precompiled header of the project",
+  "<dir> is the template directory",
+  "Watch the template directory and update the projects given after the options",
+  "<file> is a .tar or .tar.gz archive with the template files",
+  "Write the project in the <file> tar archive (- is the stdout) instead of the disk",
+  "Never ask in the terminal, fail when a required option is missing",
+  "Share the license and the vendored libraries of the projects by a store in the projects directory",
+  "<file> receives the begin/end of the functions as Chrome trace-event JSON (Perfetto)",
+  "Create the template directory (--template-dir) from the project in <dir>",
+  "Create also the Makefile of the projects directory, that builds all the projects with make -j",
+  "Append the logs of the mkcproj that ran at the same time (mkcproj.<pid>.log) in the log file and exit",
+  "Write in .mkcproj-manifest the XXH64 hash of each file of the project",
+  "Check the files of the projects <dir> (and the others after the options) against their manifests",
+  "Create the bench/ microbenchmarks of the project (make bench or ./mkbench write bench.json)",
+  "Rename the project <text> to NEW in DIR, given after the options (--rename OLD NEW DIR)",
+  "Add src/<text>.c and include/<text>.h to the project in the directory given after the options (default .)",
+  "Add the modules of the template in <list> (arena,pool,ringbuffer,threadpool,simd-dispatch) with their tests (make test) and benchmarks (--bench)",
   NULL
 };
 
@@ -96,6 +157,13 @@ void vPrintUsage(void)
 
     ii++;
   }
+
+  printf("Shell completion:\n"
+         "  %s\n"
+         "    Print the bash completion script\n\n"
+         "  %s <cword> <words...>\n"
+         "    Print the candidates of the word <cword> of <words...>, one by line\n\n",
+         COMPLETION_SCRIPT_OPTION, COMPLETE_OPTION);
 }
 
 void vPrintVersion(void)
@@ -176,6 +244,73 @@ bool bCommandLineIsOK(int argc, char **argv)
       case 'V':
         gbVerbose = true;
         break;
+      case 'u':
+        gbUnityBuild = true;
+        break;
+      case 'b':
+        snprintf(gstCmdLine.szUnityBatch, sizeof(gstCmdLine.szUnityBatch), "%s", optarg);
+
+        if(strtol(gstCmdLine.szUnityBatch, &pchEndPtr, 10) <= 0 || *pchEndPtr != '\0')
+        {
+          return false;
+        }
+
+        gbUnityBuild = true;
+        break;
+      case 'P':
+        gbPrecompiledHeader = true;
+        break;
+      case 'T':
+        snprintf(gstCmdLine.szTemplateDir, sizeof(gstCmdLine.szTemplateDir), "%s", optarg);
+        break;
+      case 'w':
+        gbWatch = true;
+        break;
+      case 'A':
+        snprintf(gstCmdLine.szTemplateArchive, sizeof(gstCmdLine.szTemplateArchive), "%s", optarg);
+        break;
+      case 'O':
+        snprintf(gstCmdLine.szOutputTar, sizeof(gstCmdLine.szOutputTar), "%s", optarg);
+        break;
+      case 'N':
+        gbNonInteractive = true;
+        break;
+      case 'S':
+        gbDedupStore = true;
+        break;
+      case 'E':
+        snprintf(gstCmdLine.szTraceEvents, sizeof(gstCmdLine.szTraceEvents), "%s", optarg);
+        break;
+      case 'X':
+        snprintf(gstCmdLine.szExtractTemplate, sizeof(gstCmdLine.szExtractTemplate), "%s", optarg);
+        break;
+      case 'M':
+        gbMonorepo = true;
+        break;
+      case 'L':
+        gbMergeLogs = true;
+        break;
+      case 'm':
+        gbManifest = true;
+        break;
+      case 'K':
+        snprintf(gstCmdLine.szVerify, sizeof(gstCmdLine.szVerify), "%s", optarg);
+        break;
+      case 'B':
+        gbBench = true;
+        break;
+      case 'R':
+        snprintf(gstCmdLine.szRename, sizeof(gstCmdLine.szRename), "%s", optarg);
+        break;
+      case 'a':
+        snprintf(gstCmdLine.szAddModule, sizeof(gstCmdLine.szAddModule), "%s", optarg);
+        break;
+      case 'W':
+        snprintf(gstCmdLine.szWith, sizeof(gstCmdLine.szWith), "%s", optarg);
+
+        /* The benchmarks of the modules need the runner of bench/ */
+        gbBench = true;
+        break;
       case '?':
       default:
         return false;
@@ -189,7 +324,7 @@ void vTraceCommandLine(int argc, char **argv)
 {
   int ii;
 
-  vTraceInfo(_("%s - begin"), __func__);
+  vTraceEvent(_("%s - begin"), __func__);
 
   vTraceAll("argc == %d", argc);
 
@@ -198,14 +333,14 @@ void vTraceCommandLine(int argc, char **argv)
     vTraceAll("0x%08lX argv[%d] == %s", (long) &argv[ii], ii, argv[ii]);
   }
 
-  vTraceInfo(_("%s - end"), __func__);
+  vTraceEvent(_("%s - end"), __func__);
 }
 
 void vTraceEnvp(char **envp)
 {
   int ii;
 
-  vTraceInfo(_("%s - begin"), __func__);
+  vTraceEvent(_("%s - begin"), __func__);
 
   if(envp != NULL)
   {
@@ -215,17 +350,17 @@ void vTraceEnvp(char **envp)
     }
   }
 
-  vTraceInfo(_("%s - end"), __func__);
+  vTraceEvent(_("%s - end"), __func__);
 }
 
 void vInfoShowProjectInformations(void)
 {
-  vTraceInfo("Project....: %s", gstCmdLine.szProjName);
-  vTraceInfo("Developer..: %s", gstCmdLine.szDevName);
-  vTraceInfo("Dev e-mail.: %s", gstCmdLine.szDevMail);
-  vTraceInfo("Description: %s", gstCmdLine.szProjDescription);
-  vTraceInfo("License....: %s", gstCmdLine.szLicense);
-  vTraceInfo("Verbose....: %s", gbVerbose == false ? "false" : "true");
+  vTraceEvent("Project....: %s", gstCmdLine.szProjName);
+  vTraceEvent("Developer..: %s", gstCmdLine.szDevName);
+  vTraceEvent("Dev e-mail.: %s", gstCmdLine.szDevMail);
+  vTraceEvent("Description: %s", gstCmdLine.szProjDescription);
+  vTraceEvent("License....: %s", gstCmdLine.szLicense);
+  vTraceEvent("Verbose....: %s", gbVerbose == false ? "false" : "true");
 }
 
 void vTraceSystemInfo(void)
@@ -249,7 +384,7 @@ void vTraceSystemInfo(void)
   time(&tCurrentDateTime);
   pstDateTime = localtime(&tCurrentDateTime);
 
-  vTraceInfo(_("%s - begin"), __func__);
+  vTraceEvent(_("%s - begin"), __func__);
  
   if(uname(&stSysInfo) != 0)
   {
@@ -292,7 +427,7 @@ void vTraceSystemInfo(void)
   vTraceAll(_("Default Shell...........: %s"), pstUserInfo->pw_shell);
   vTraceAll(_("-------------------------"));
   
-  vTraceInfo(_("%s - end"), __func__);
+  vTraceEvent(_("%s - end"), __func__);
 }
 
 void vTraceProgramInfo(void)
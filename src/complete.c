@@ -0,0 +1,468 @@
+/**
+ * complete.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Shell completion of the command line, generated
+ *              from the table of options (astCmdOpt)
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "profile.h"
+#include "complete.h"
+
+const char *kaszLicenseIds[] = {
+  "AGPL", "AGPL3", "APACHE", "Apache", "Artistic2.0", "Boost", "CCPL",
+  "CDDL", "CPL", "EPL", "FDL", "FDL1.2", "FDL1.3", "GPL", "GPL2", "GPL3",
+  "GPLv2", "GPLv3", "LGPL", "LGPL2.1", "LGPL3", "LPPL", "MPL", "MPL2",
+  "PHP", "PSF", "PerlArtistic", "RUBY", "Unlicense", "W3C", "ZPL",
+  NULL
+};
+
+int iGetCmdOptIndex(const char *kpszWord, const char **ppszValue)
+{
+  size_t lNameLen = 0;
+  int ii;
+
+  *ppszValue = NULL;
+
+  if(strncmp(kpszWord, "--", 2) == 0 && kpszWord[2] != '\0')
+  {
+    lNameLen = strcspn(kpszWord + 2, "=");
+
+    for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+    {
+      if(strlen(astCmdOpt[ii].name) == lNameLen && strncmp(astCmdOpt[ii].name, kpszWord + 2, lNameLen) == 0)
+      {
+        if(kpszWord[2 + lNameLen] == '=')
+        {
+          *ppszValue = kpszWord + 3 + lNameLen;
+        }
+
+        return ii;
+      }
+    }
+  }
+  else if(kpszWord[0] == '-' && kpszWord[1] != '\0' && kpszWord[1] != '-' && kpszWord[2] == '\0')
+  {
+    for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+    {
+      if(astCmdOpt[ii].val == kpszWord[1])
+      {
+        return ii;
+      }
+    }
+  }
+
+  return -1;
+}
+
+ENUM_COMPLETE_KIND eGetCompleteKind(int ii)
+{
+  if(astCmdOpt[ii].has_arg != required_argument)
+  {
+    return COMPLETE_NONE;
+  }
+
+  switch(astCmdOpt[ii].val)
+  {
+    case 'l':
+      return COMPLETE_LICENSE;
+    case 'T':
+      return COMPLETE_TEMPLATE_DIR;
+    default:
+      break;
+  }
+
+  if(strcmp(pszCmdArguments[ii], "dir") == 0)
+  {
+    return COMPLETE_DIR;
+  }
+
+  if(strcmp(pszCmdArguments[ii], "file") == 0)
+  {
+    return COMPLETE_FILE;
+  }
+
+  return COMPLETE_TEXT;
+}
+
+void vCompleteOptions(const char *kpszCur)
+{
+  size_t lCurLen = strlen(kpszCur);
+  int ii;
+
+  for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+  {
+    if(lCurLen <= 2 || strncmp(astCmdOpt[ii].name, kpszCur + 2, lCurLen - 2) == 0)
+    {
+      if(lCurLen < 2 || kpszCur[1] == '-')
+      {
+        printf("--%s\n", astCmdOpt[ii].name);
+      }
+    }
+  }
+
+  /* "-" or "-x" */
+  if(lCurLen <= 2 && kpszCur[1] != '-')
+  {
+    for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+    {
+      if(lCurLen < 2 || astCmdOpt[ii].val == kpszCur[1])
+      {
+        printf("-%c\n", astCmdOpt[ii].val);
+      }
+    }
+  }
+}
+
+void vCompleteLicenses(const char *kpszCur, const char *kpszOptPrefix)
+{
+  size_t lCurLen = strlen(kpszCur);
+  int ii;
+
+  for(ii = 0; kaszLicenseIds[ii] != NULL; ii++)
+  {
+    if(strncasecmp(kaszLicenseIds[ii], kpszCur, lCurLen) == 0)
+    {
+      printf("%s%s\n", kpszOptPrefix, kaszLicenseIds[ii]);
+    }
+  }
+}
+
+void vCompletePath(const char *kpszCur, bool bOnlyDirs, const char *kpszOptPrefix)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stStat;
+  const char *kpszSlash = strrchr(kpszCur, '/');
+  const char *kpszBase = kpszSlash != NULL ? kpszSlash + 1 : kpszCur;
+  char szDir[_MAX_PATH];
+  char szPath[_MAX_PATH * 2];
+  size_t lBaseLen = strlen(kpszBase);
+  int iDirLen = kpszSlash != NULL ? (int) (kpszSlash - kpszCur) : 0;
+  bool bIsDir = false;
+
+  /* "dir/ba" -> entries of "dir" that begin with "ba" */
+  snprintf(szDir, sizeof(szDir), "%.*s", iDirLen, kpszCur);
+
+  if((pDir = opendir(kpszSlash == NULL ? "." : iDirLen == 0 ? "/" : szDir)) == NULL)
+  {
+    return;
+  }
+
+  while((pstEntry = readdir(pDir)) != NULL)
+  {
+    if(strcmp(pstEntry->d_name, ".") == 0 || strcmp(pstEntry->d_name, "..") == 0 ||
+       (pstEntry->d_name[0] == '.' && kpszBase[0] != '.') ||
+       strncmp(pstEntry->d_name, kpszBase, lBaseLen) != 0)
+    {
+      continue;
+    }
+
+    snprintf(szPath, sizeof(szPath), "%.*s%s", kpszSlash != NULL ? iDirLen + 1 : 0, kpszCur, pstEntry->d_name);
+
+    /* Only the symbolic links and the file systems without d_type need the stat() */
+    bIsDir = pstEntry->d_type == DT_DIR;
+
+    if((pstEntry->d_type == DT_LNK || pstEntry->d_type == DT_UNKNOWN) && stat(szPath, &stStat) == 0)
+    {
+      bIsDir = S_ISDIR(stStat.st_mode);
+    }
+
+    if(bOnlyDirs && !bIsDir)
+    {
+      continue;
+    }
+
+    printf("%s%s%s\n", kpszOptPrefix, szPath, bIsDir ? "/" : "");
+  }
+
+  closedir(pDir);
+}
+
+void vCompleteTemplateDirs(const char *kpszCur, const char *kpszOptPrefix)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stStat;
+  char aszRootDirs[2][_MAX_PATH];
+  char szPath[_MAX_PATH * 2];
+  char *pszSlash = NULL;
+  size_t lCurLen = strlen(kpszCur);
+  int iRootDirsCount = 0;
+  int ii;
+
+  memset(aszRootDirs, 0, sizeof(aszRootDirs));
+
+  iLoadProfile();
+
+  if(HOME != NULL)
+  {
+    snprintf(aszRootDirs[iRootDirsCount++], sizeof(aszRootDirs[0]), "%s/%s", HOME, TEMPLATES_DIR);
+  }
+
+  /* The directory with the template of the profile has the other templates too */
+  if(!bStrIsEmpty(gstProfile.szTemplateDir))
+  {
+    snprintf(aszRootDirs[iRootDirsCount], sizeof(aszRootDirs[0]), "%s", gstProfile.szTemplateDir);
+
+    if((pszSlash = strrchr(aszRootDirs[iRootDirsCount], '/')) != NULL && pszSlash != aszRootDirs[iRootDirsCount])
+    {
+      *pszSlash = '\0';
+
+      if(iRootDirsCount == 0 || strcmp(aszRootDirs[0], aszRootDirs[iRootDirsCount]) != 0)
+      {
+        iRootDirsCount++;
+      }
+    }
+  }
+
+  for(ii = 0; ii < iRootDirsCount; ii++)
+  {
+    if((pDir = opendir(aszRootDirs[ii])) == NULL)
+    {
+      continue;
+    }
+
+    while((pstEntry = readdir(pDir)) != NULL)
+    {
+      if(pstEntry->d_name[0] == '.')
+      {
+        continue;
+      }
+
+      snprintf(szPath, sizeof(szPath), "%s/%s", aszRootDirs[ii], pstEntry->d_name);
+
+      if(strncmp(szPath, kpszCur, lCurLen) == 0 && stat(szPath, &stStat) == 0 && S_ISDIR(stStat.st_mode))
+      {
+        printf("%s%s/\n", kpszOptPrefix, szPath);
+      }
+    }
+
+    closedir(pDir);
+  }
+
+  /* Relative and absolute paths typed by the user */
+  vCompletePath(kpszCur, true, kpszOptPrefix);
+}
+
+/**
+ * Print the candidates of the argument of the option ii of astCmdOpt
+ */
+static void vCompleteArgument(int ii, const char *kpszCur, const char *kpszOptPrefix)
+{
+  switch(eGetCompleteKind(ii))
+  {
+    case COMPLETE_LICENSE:
+      vCompleteLicenses(kpszCur, kpszOptPrefix);
+      break;
+    case COMPLETE_TEMPLATE_DIR:
+      vCompleteTemplateDirs(kpszCur, kpszOptPrefix);
+      break;
+    case COMPLETE_DIR:
+      vCompletePath(kpszCur, true, kpszOptPrefix);
+      break;
+    case COMPLETE_FILE:
+      vCompletePath(kpszCur, false, kpszOptPrefix);
+      break;
+    case COMPLETE_TEXT:
+    case COMPLETE_NONE:
+    default:
+      break;
+  }
+}
+
+int iCompleteCommandLine(int iWordsCount, char **ppszWords)
+{
+  const char *kpszCur = "";
+  const char *kpszPrev = NULL;
+  const char *kpszValue = NULL;
+  char szOptPrefix[_MAX_PATH];
+  char *pchEndPtr = NULL;
+  long lCurWord = 0;
+  int ii;
+
+  memset(szOptPrefix, 0, sizeof(szOptPrefix));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(iWordsCount < 1 || (lCurWord = strtol(ppszWords[0], &pchEndPtr, 10)) < 0 || *pchEndPtr != '\0')
+  {
+    vPrintErrorMessage(_("Usage: %s %s <cword> <words...>"), gkpszProgramName, COMPLETE_OPTION);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* <words...> begin with the name of the program, like COMP_WORDS */
+  ppszWords++;
+  iWordsCount--;
+
+  if(lCurWord < iWordsCount)
+  {
+    kpszCur = ppszWords[lCurWord];
+  }
+
+  if(lCurWord > 0 && lCurWord - 1 < iWordsCount)
+  {
+    kpszPrev = ppszWords[lCurWord - 1];
+  }
+
+  /* bash splits "--option=value" in "--option" "=" "value" */
+  if(strcmp(kpszCur, "=") == 0)
+  {
+    kpszCur = "";
+  }
+  else if(kpszPrev != NULL && strcmp(kpszPrev, "=") == 0 && lCurWord >= 2)
+  {
+    kpszPrev = ppszWords[lCurWord - 2];
+  }
+
+  if(strncmp(kpszCur, "--", 2) == 0 && strchr(kpszCur, '=') != NULL)
+  {
+    /* --option=value in a single word */
+    if((ii = iGetCmdOptIndex(kpszCur, &kpszValue)) >= 0 && kpszValue != NULL)
+    {
+      snprintf(szOptPrefix, sizeof(szOptPrefix), "%.*s", (int) (kpszValue - kpszCur), kpszCur);
+      vCompleteArgument(ii, kpszValue, szOptPrefix);
+    }
+  }
+  else if(kpszPrev != NULL && (ii = iGetCmdOptIndex(kpszPrev, &kpszValue)) >= 0 &&
+          kpszValue == NULL && astCmdOpt[ii].has_arg == required_argument)
+  {
+    vCompleteArgument(ii, kpszCur, "");
+  }
+  else if(kpszCur[0] == '-')
+  {
+    vCompleteOptions(kpszCur);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+/**
+ * Write the "--name|-x|..." pattern of the options
+ * with the argument completed as eKind
+ */
+static void vWriteCasePattern(FILE *fpScript, ENUM_COMPLETE_KIND eKind)
+{
+  const char *kpszSeparator = "    ";
+  int ii;
+
+  for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+  {
+    if(eGetCompleteKind(ii) == eKind)
+    {
+      fprintf(fpScript, "%s--%s|-%c", kpszSeparator, astCmdOpt[ii].name, astCmdOpt[ii].val);
+      kpszSeparator = "|";
+    }
+  }
+
+  fprintf(fpScript, ")\n");
+}
+
+int iWriteCompletionScript(FILE *fpScript)
+{
+  int ii;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  fprintf(fpScript,
+    "##\n"
+    "# _%s_complete.sh\n"
+    "#\n"
+    "# Description: Autocomplete script of %s, the generator of new C projects\n"
+    "#\n"
+    "# Generated by %s %s, don't edit it.\n"
+    "# Run \"make completion\" to generate it again.\n"
+    "#\n"
+    "\n"
+    "_%s_complete()\n"
+    "{\n"
+    "  local cur_word=\"${COMP_WORDS[COMP_CWORD]}\"\n"
+    "  local prev_word=\"${COMP_WORDS[COMP_CWORD-1]}\"\n",
+    gkpszProgramName, gkpszProgramName, gkpszProgramName, COMPLETION_SCRIPT_OPTION, gkpszProgramName);
+
+  /* The options and the licenses are in the script, without run the program */
+  fprintf(fpScript, "  local long_opts=\"");
+
+  for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+  {
+    fprintf(fpScript, "%s--%s", ii > 0 ? " " : "", astCmdOpt[ii].name);
+  }
+
+  fprintf(fpScript, "\"\n  local short_opts=\"");
+
+  for(ii = 0; astCmdOpt[ii].name != NULL; ii++)
+  {
+    fprintf(fpScript, "%s-%c", ii > 0 ? " " : "", astCmdOpt[ii].val);
+  }
+
+  fprintf(fpScript, "\"\n  local licenses=\"");
+
+  for(ii = 0; kaszLicenseIds[ii] != NULL; ii++)
+  {
+    fprintf(fpScript, "%s%s", ii > 0 ? " " : "", kaszLicenseIds[ii]);
+  }
+
+  fprintf(fpScript,
+    "\"\n"
+    "\n"
+    "  # bash splits --option=value in \"--option\" \"=\" \"value\"\n"
+    "  if [[ \"${cur_word}\" == \"=\" ]]; then\n"
+    "    cur_word=\"\"\n"
+    "  elif [[ \"${prev_word}\" == \"=\" ]]; then\n"
+    "    prev_word=\"${COMP_WORDS[COMP_CWORD-2]}\"\n"
+    "  fi\n"
+    "\n"
+    "  case \"${prev_word}\" in\n");
+
+  vWriteCasePattern(fpScript, COMPLETE_LICENSE);
+  fprintf(fpScript,
+    "      COMPREPLY=( $(compgen -W \"${licenses}\" -- \"${cur_word}\") )\n"
+    "      return 0;;\n");
+
+  vWriteCasePattern(fpScript, COMPLETE_TEMPLATE_DIR);
+  fprintf(fpScript,
+    "      compopt -o nospace\n"
+    "      COMPREPLY=( $(%s %s 2 %s -T \"${cur_word}\") )\n"
+    "      return 0;;\n", gkpszProgramName, COMPLETE_OPTION, gkpszProgramName);
+
+  vWriteCasePattern(fpScript, COMPLETE_DIR);
+  fprintf(fpScript,
+    "      compopt -o filenames\n"
+    "      COMPREPLY=( $(compgen -d -- \"${cur_word}\") )\n"
+    "      return 0;;\n");
+
+  vWriteCasePattern(fpScript, COMPLETE_FILE);
+  fprintf(fpScript,
+    "      compopt -o filenames\n"
+    "      COMPREPLY=( $(compgen -f -- \"${cur_word}\") )\n"
+    "      return 0;;\n");
+
+  vWriteCasePattern(fpScript, COMPLETE_TEXT);
+  fprintf(fpScript,
+    "      COMPREPLY=()\n"
+    "      return 0;;\n"
+    "  esac\n"
+    "\n"
+    "  case \"${cur_word}\" in\n"
+    "    --*) COMPREPLY=( $(compgen -W \"${long_opts}\" -- \"${cur_word}\") );;\n"
+    "    -*) COMPREPLY=( $(compgen -W \"${short_opts}\" -- \"${cur_word}\") );;\n"
+    "  esac\n"
+    "\n"
+    "  return 0\n"
+    "}\n"
+    "\n"
+    "complete -F _%s_complete -o default %s\n", gkpszProgramName, gkpszProgramName);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return fflush(fpScript) == 0 ? 0 : -1;
+}
@@ -0,0 +1,599 @@
+/**
+ * extract.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Create a template directory from an existing
+ *              project (--extract-template), replacing the name
+ *              of the project by "template" and "TEMPLATE"
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "rename.h"
+#include "extract.h"
+
+bool bIsExtractIgnored(const char *kpszRelativePath, const char *kpszName, bool bDir)
+{
+  size_t lNameLen = strlen(kpszName);
+  bool bTopLevel = strchr(kpszRelativePath, '/') == NULL;
+
+  /* ".", "..", .git, .mkcproj, ... (the template index skips them too) */
+  if(kpszName[0] == '.')
+  {
+    return true;
+  }
+
+  /* What "make distclean" removes */
+  if(bTopLevel && bDir && (strcmp(kpszName, "obj") == 0 || strcmp(kpszName, "bin") == 0))
+  {
+    return true;
+  }
+
+  if(bTopLevel && !bDir && ((lNameLen > 4 && strcmp(kpszName + lNameLen - 4, ".log") == 0) ||
+                            strcmp(kpszName, "bench.json") == 0))
+  {
+    return true;
+  }
+
+  /* Files generated by mkcproj, not by the developer */
+  if(!bDir && (strncmp(kpszRelativePath, "src/unity_", 10) == 0 ||
+               strcmp(kpszRelativePath, "include/pch.h") == 0 ||
+               (lNameLen > strlen(TMP_FILE_SUFFIX) &&
+                strcmp(kpszName + lNameLen - strlen(TMP_FILE_SUFFIX), TMP_FILE_SUFFIX) == 0)))
+  {
+    return true;
+  }
+
+  return false;
+}
+
+int iWriteTemplateName(FILE *fpTemplate, const char *kpszContent, size_t lSize,
+                       PSTRUCT_EXTRACT_QUEUE pstQueue)
+{
+  const char *kpszBegin = kpszContent;
+  const char *kpszEnd = kpszContent + lSize;
+  const char *kpszLower = NULL;
+  const char *kpszUpper = NULL;
+  size_t lNameLen = strlen(pstQueue->szProjName);
+  bool bSearchUpper = strcmp(pstQueue->szProjName, pstQueue->szUpperProjName) != 0;
+
+  /* Only whole words, a project "io" don't change stdio.h */
+  kpszLower = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szProjName, lNameLen);
+
+  if(bSearchUpper)
+  {
+    kpszUpper = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szUpperProjName, lNameLen);
+  }
+
+  /* Each search runs again only when its match was consumed */
+  while(kpszLower != NULL || kpszUpper != NULL)
+  {
+    if(kpszLower != NULL && (kpszUpper == NULL || kpszLower < kpszUpper))
+    {
+      fwrite(kpszContent, 1, kpszLower - kpszContent, fpTemplate);
+      fputs("template", fpTemplate);
+      kpszContent = kpszLower + lNameLen;
+    }
+    else
+    {
+      fwrite(kpszContent, 1, kpszUpper - kpszContent, fpTemplate);
+      fputs("TEMPLATE", fpTemplate);
+      kpszContent = kpszUpper + lNameLen;
+    }
+
+    if(kpszLower != NULL && kpszLower < kpszContent)
+    {
+      kpszLower = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szProjName, lNameLen);
+    }
+
+    if(kpszUpper != NULL && kpszUpper < kpszContent)
+    {
+      kpszUpper = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szUpperProjName, lNameLen);
+    }
+  }
+
+  fwrite(kpszContent, 1, kpszEnd - kpszContent, fpTemplate);
+
+  return ferror(fpTemplate) ? -1 : 0;
+}
+
+void vGetTemplatePath(const char *kpszRelativePath, char *pszTemplatePath, size_t lTemplatePathSize,
+                      PSTRUCT_EXTRACT_QUEUE pstQueue)
+{
+  FILE *fpPath = NULL;
+
+  memset(pszTemplatePath, 0, lTemplatePathSize);
+
+  if((fpPath = fmemopen(pszTemplatePath, lTemplatePathSize, "w")) == NULL)
+  {
+    snprintf(pszTemplatePath, lTemplatePathSize, "%s", kpszRelativePath);
+
+    return;
+  }
+
+  /* The buffer of fmemopen is the path, without the last byte for the '\0' */
+  setvbuf(fpPath, NULL, _IONBF, 0);
+
+  iWriteTemplateName(fpPath, kpszRelativePath, strlen(kpszRelativePath), pstQueue);
+
+  fclose(fpPath);
+
+  pszTemplatePath[lTemplatePathSize - 1] = '\0';
+}
+
+bool bPushExtractJob(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath, bool bDir)
+{
+  PSTRUCT_EXTRACT_JOB pastTmp = NULL;
+  PSTRUCT_EXTRACT_JOB pstJob = NULL;
+
+  if(pstQueue->iJobsCount == pstQueue->iJobsAlloc)
+  {
+    pstQueue->iJobsAlloc = pstQueue->iJobsAlloc == 0 ? 256 : pstQueue->iJobsAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_EXTRACT_JOB) realloc(pstQueue->pastJobs,
+                                                pstQueue->iJobsAlloc * sizeof(STRUCT_EXTRACT_JOB))) == NULL)
+    {
+      pstQueue->iJobsAlloc = pstQueue->iJobsCount;
+
+      return false;
+    }
+
+    pstQueue->pastJobs = pastTmp;
+  }
+
+  pstJob = &pstQueue->pastJobs[pstQueue->iJobsCount++];
+
+  snprintf(pstJob->szRelativePath, sizeof(pstJob->szRelativePath), "%s", kpszRelativePath);
+  pstJob->bDir = bDir;
+
+  pstQueue->iPending++;
+
+  return true;
+}
+
+int iExtractDir(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stFileStat;
+  bool bDir = false;
+  int iRsl = 0;
+  ssize_t lLinkLen = 0;
+  char szDirPath[sizeof(pstQueue->szSrcDir) + _MAX_PATH + 2];
+  char szRelativePath[_MAX_PATH];
+  char szTemplatePath[_MAX_PATH];
+  char szDestPath[sizeof(pstQueue->szDestDir) + _MAX_PATH + 2];
+  char szLink[_MAX_PATH];
+
+  memset(szDirPath, 0, sizeof(szDirPath));
+  memset(szRelativePath, 0, sizeof(szRelativePath));
+  memset(szTemplatePath, 0, sizeof(szTemplatePath));
+  memset(szDestPath, 0, sizeof(szDestPath));
+  memset(szLink, 0, sizeof(szLink));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szDirPath, sizeof(szDirPath), "%s%s%s", pstQueue->szSrcDir,
+           bStrIsEmpty(kpszRelativePath) ? "" : "/", kpszRelativePath);
+
+  if((pDir = opendir(szDirPath)) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the directory %s: %s"), szDirPath, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  while((pstEntry = readdir(pDir)) != NULL)
+  {
+    if(snprintf(szRelativePath, sizeof(szRelativePath), "%s%s%s", kpszRelativePath,
+                bStrIsEmpty(kpszRelativePath) ? "" : "/", pstEntry->d_name) >= (int) sizeof(szRelativePath))
+    {
+      vPrintErrorMessage(_("Path too long: %s/%s"), szDirPath, pstEntry->d_name);
+
+      iRsl = -1;
+      continue;
+    }
+
+    /* d_type saves the stat of most of the entries */
+    if(pstEntry->d_type == DT_UNKNOWN)
+    {
+      if(fstatat(dirfd(pDir), pstEntry->d_name, &stFileStat, AT_SYMLINK_NOFOLLOW) != 0)
+      {
+        continue;
+      }
+
+      bDir = S_ISDIR(stFileStat.st_mode);
+    }
+    else
+    {
+      bDir = pstEntry->d_type == DT_DIR;
+    }
+
+    if(bIsExtractIgnored(szRelativePath, pstEntry->d_name, bDir))
+    {
+      continue;
+    }
+
+    vGetTemplatePath(szRelativePath, szTemplatePath, sizeof(szTemplatePath), pstQueue);
+    snprintf(szDestPath, sizeof(szDestPath), "%s/%s", pstQueue->szDestDir, szTemplatePath);
+
+    /* The links are created again, with the name of the project replaced in the target */
+    if(pstEntry->d_type == DT_LNK)
+    {
+      if((lLinkLen = readlinkat(dirfd(pDir), pstEntry->d_name, szLink, sizeof(szLink) - 1)) >= 0)
+      {
+        szLink[lLinkLen] = '\0';
+        vGetTemplatePath(szLink, szTemplatePath, sizeof(szTemplatePath), pstQueue);
+      }
+
+      if(lLinkLen < 0 || symlink(szTemplatePath, szDestPath) != 0)
+      {
+        vPrintErrorMessage(_("Impossible copy the link %s/%s: %s"), szDirPath, pstEntry->d_name, strerror(errno));
+
+        iRsl = -1;
+      }
+
+      continue;
+    }
+
+    /* The directory exists before the threads write its files */
+    if(bDir && mkdir(szDestPath, 0755) != 0 && errno != EEXIST)
+    {
+      vPrintErrorMessage(_("Impossible create the directory %s: %s"), szDestPath, strerror(errno));
+
+      iRsl = -1;
+      continue;
+    }
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(!bPushExtractJob(pstQueue, szRelativePath, bDir))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szRelativePath);
+
+      iRsl = -1;
+    }
+
+    pthread_cond_signal(&pstQueue->stCond);
+    pthread_mutex_unlock(&pstQueue->stMutex);
+  }
+
+  closedir(pDir);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iExtractFile(PSTRUCT_EXTRACT_QUEUE pstQueue, const char *kpszRelativePath)
+{
+  FILE *fpTemplate = NULL;
+  struct stat stFileStat;
+  char *pszContent = NULL;
+  int iFd = -1;
+  int iRsl = 0;
+  bool bBinary = false;
+  char szSrcPath[sizeof(pstQueue->szSrcDir) + _MAX_PATH + 2];
+  char szTemplatePath[_MAX_PATH];
+  char szDestPath[sizeof(pstQueue->szDestDir) + _MAX_PATH + 2];
+  char szTmpPath[sizeof(szDestPath) + 32];
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szSrcPath, 0, sizeof(szSrcPath));
+  memset(szTemplatePath, 0, sizeof(szTemplatePath));
+  memset(szDestPath, 0, sizeof(szDestPath));
+  memset(szTmpPath, 0, sizeof(szTmpPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szSrcPath, sizeof(szSrcPath), "%s/%s", pstQueue->szSrcDir, kpszRelativePath);
+
+  vGetTemplatePath(kpszRelativePath, szTemplatePath, sizeof(szTemplatePath), pstQueue);
+  snprintf(szDestPath, sizeof(szDestPath), "%s/%s", pstQueue->szDestDir, szTemplatePath);
+  snprintf(szTmpPath, sizeof(szTmpPath), "%s%s", szDestPath, TMP_FILE_SUFFIX);
+
+  if((iFd = open(szSrcPath, O_RDONLY | O_CLOEXEC)) < 0 || fstat(iFd, &stFileStat) != 0)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), szSrcPath, strerror(errno));
+
+    if(iFd >= 0)
+    {
+      close(iFd);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* FIFOs, sockets, devices, ... */
+  if(!S_ISREG(stFileStat.st_mode))
+  {
+    close(iFd);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return 0;
+  }
+
+  if(stFileStat.st_size > 0)
+  {
+    if((pszContent = mmap(NULL, stFileStat.st_size, PROT_READ, MAP_PRIVATE, iFd, 0)) == MAP_FAILED)
+    {
+      vPrintErrorMessage(_("Impossible map the file %s: %s"), szSrcPath, strerror(errno));
+
+      close(iFd);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+
+    madvise(pszContent, stFileStat.st_size, MADV_SEQUENTIAL);
+  }
+
+  close(iFd);
+
+  if((fpTemplate = fopen(szTmpPath, "w")) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), szTmpPath, strerror(errno));
+
+    iRsl = -1;
+  }
+  else
+  {
+    bBinary = pszContent != NULL &&
+              memchr(pszContent, '\0', stFileStat.st_size < EXTRACT_BINARY_CHECK_SIZE ?
+                                       stFileStat.st_size : EXTRACT_BINARY_CHECK_SIZE) != NULL;
+
+    if(pszContent == NULL)
+    {
+      iRsl = 0;
+    }
+    else if(bBinary)
+    {
+      iRsl = fwrite(pszContent, 1, stFileStat.st_size, fpTemplate) == (size_t) stFileStat.st_size ? 0 : -1;
+    }
+    else
+    {
+      iRsl = iWriteTemplateName(fpTemplate, pszContent, stFileStat.st_size, pstQueue);
+    }
+
+    fchmod(fileno(fpTemplate), stFileStat.st_mode & 0777);
+
+    if(fclose(fpTemplate) != 0 || iRsl != 0 || rename(szTmpPath, szDestPath) != 0)
+    {
+      vPrintErrorMessage(_("Impossible write the file %s: %s"), szDestPath, strerror(errno));
+
+      unlink(szTmpPath);
+
+      iRsl = -1;
+    }
+  }
+
+  if(pszContent != NULL)
+  {
+    munmap(pszContent, stFileStat.st_size);
+  }
+
+  if(iRsl == 0)
+  {
+    vPrintVerbose(_("Created file %s\n"), szDestPath);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+void *pvExtractWorker(void *pvQueue)
+{
+  PSTRUCT_EXTRACT_QUEUE pstQueue = (PSTRUCT_EXTRACT_QUEUE) pvQueue;
+  STRUCT_EXTRACT_JOB stJob;
+  int iRsl = 0;
+
+  memset(&stJob, 0, sizeof(stJob));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  pthread_mutex_lock(&pstQueue->stMutex);
+
+  while(true)
+  {
+    /* Other thread can still add the entries of a directory */
+    while(pstQueue->iJobsCount == 0 && pstQueue->iPending > 0)
+    {
+      pthread_cond_wait(&pstQueue->stCond, &pstQueue->stMutex);
+    }
+
+    if(pstQueue->iPending == 0)
+    {
+      break;
+    }
+
+    stJob = pstQueue->pastJobs[--pstQueue->iJobsCount];
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+
+    iRsl = stJob.bDir ? iExtractDir(pstQueue, stJob.szRelativePath) :
+                        iExtractFile(pstQueue, stJob.szRelativePath);
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(iRsl != 0)
+    {
+      pstQueue->iErrors++;
+    }
+    else if(!stJob.bDir)
+    {
+      pstQueue->lFilesCount++;
+    }
+
+    /* The last job wakes up every thread to finish */
+    if(--pstQueue->iPending == 0)
+    {
+      pthread_cond_broadcast(&pstQueue->stCond);
+    }
+  }
+
+  pthread_mutex_unlock(&pstQueue->stMutex);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return NULL;
+}
+
+int iExtractTemplate(const char *kpszProjectPathDir)
+{
+  STRUCT_EXTRACT_QUEUE stQueue;
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stFileStat;
+  pthread_t atThreads[EXTRACT_MAX_THREADS];
+  const char *kpszBaseName = NULL;
+  char szInfoPath[_MAX_PATH + 32];
+  long lThreadsCount = sysconf(_SC_NPROCESSORS_ONLN);
+  int iThreadsStarted = 0;
+  int ii;
+
+  memset(&stQueue, 0, sizeof(stQueue));
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szInfoPath, 0, sizeof(szInfoPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(stat(kpszProjectPathDir, &stFileStat) != 0 || !S_ISDIR(stFileStat.st_mode))
+  {
+    vPrintErrorMessage(_("%s is not a directory"), kpszProjectPathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  snprintf(stQueue.szSrcDir, sizeof(stQueue.szSrcDir), "%s", kpszProjectPathDir);
+  snprintf(stQueue.szDestDir, sizeof(stQueue.szDestDir), "%s", gszTemplatePathDir);
+
+  /* Name of the project: --project-name, the .mkcproj file or the directory */
+  snprintf(szInfoPath, sizeof(szInfoPath), "%s/%s", kpszProjectPathDir, PROJECT_INFO_FILE);
+
+  if(bStrIsEmpty(gstCmdLine.szProjName) && access(szInfoPath, R_OK) == 0)
+  {
+    bLoadProjectInfo(kpszProjectPathDir);
+  }
+
+  if(!bStrIsEmpty(gstCmdLine.szProjName))
+  {
+    snprintf(stQueue.szProjName, sizeof(stQueue.szProjName), "%s", gstCmdLine.szProjName);
+  }
+  else
+  {
+    for(ii = strlen(stQueue.szSrcDir); ii > 1 && stQueue.szSrcDir[ii - 1] == '/'; ii--)
+    {
+      stQueue.szSrcDir[ii - 1] = '\0';
+    }
+
+    kpszBaseName = strrchr(stQueue.szSrcDir, '/');
+    snprintf(stQueue.szProjName, sizeof(stQueue.szProjName), "%s",
+             kpszBaseName != NULL ? kpszBaseName + 1 : stQueue.szSrcDir);
+  }
+
+  for(ii = 0; stQueue.szProjName[ii] != '\0'; ii++)
+  {
+    stQueue.szUpperProjName[ii] = toupper((unsigned char) stQueue.szProjName[ii]);
+  }
+
+  if(bStrIsEmpty(stQueue.szProjName))
+  {
+    vPrintErrorMessage(_("Impossible know the name of the project %s, use --project-name"), kpszProjectPathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* Never mix the files of the project with a template that already exists */
+  if((pDir = opendir(stQueue.szDestDir)) != NULL)
+  {
+    while((pstEntry = readdir(pDir)) != NULL &&
+          (strcmp(pstEntry->d_name, ".") == 0 || strcmp(pstEntry->d_name, "..") == 0));
+
+    closedir(pDir);
+
+    if(pstEntry != NULL)
+    {
+      vPrintErrorMessage(_("The template directory %s is not empty"), stQueue.szDestDir);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+  }
+  else if(mkdir(stQueue.szDestDir, 0755) != 0)
+  {
+    vPrintErrorMessage(_("Impossible create the directory %s: %s"), stQueue.szDestDir, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  pthread_mutex_init(&stQueue.stMutex, NULL);
+  pthread_cond_init(&stQueue.stCond, NULL);
+
+  bPushExtractJob(&stQueue, "", true);
+
+  if(lThreadsCount < 1)
+  {
+    lThreadsCount = 1;
+  }
+  else if(lThreadsCount > EXTRACT_MAX_THREADS)
+  {
+    lThreadsCount = EXTRACT_MAX_THREADS;
+  }
+
+  for(ii = 0; ii < lThreadsCount; ii++)
+  {
+    if(pthread_create(&atThreads[ii], NULL, pvExtractWorker, &stQueue) != 0)
+    {
+      break;
+    }
+
+    iThreadsStarted++;
+  }
+
+  /* Without threads, the walk runs in this one */
+  if(iThreadsStarted == 0)
+  {
+    pvExtractWorker(&stQueue);
+  }
+
+  for(ii = 0; ii < iThreadsStarted; ii++)
+  {
+    pthread_join(atThreads[ii], NULL);
+  }
+
+  pthread_cond_destroy(&stQueue.stCond);
+  pthread_mutex_destroy(&stQueue.stMutex);
+  free(stQueue.pastJobs);
+
+  if(stQueue.iErrors > 0)
+  {
+    vPrintErrorMessage(_("Impossible copy %d files of %s"), stQueue.iErrors, kpszProjectPathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  printf(_("Created the template %s from %s (%ld files, \"%s\" replaced by \"template\")\n"),
+         stQueue.szDestDir, kpszProjectPathDir, stQueue.lFilesCount, stQueue.szProjName);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
@@ -0,0 +1,410 @@
+/**
+ * libmkcproj.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: libmkcproj (make lib), the API to create a project
+ *              without run the mkcproj binary. The spec and the
+ *              context are opaque to the caller, and the calls of
+ *              iMkcprojGenerate are serialized by the mutex of the
+ *              library, because they use the globals of mkcproj.
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "manifest.h"
+#include "store.h"
+#include "tar.h"
+#include "libmkcproj.h"
+
+/**
+ * What to create, the same fields of the command line
+ */
+struct STRUCT_MKCPROJ_SPEC
+{
+  char szProjName[_MAX_PATH];
+  char szDevName[_MAX_PATH];
+  char szDevMail[_MAX_PATH];
+  char szProjDescription[_MAX_PATH];
+  char szLicense[_MAX_PATH];
+  char szTemplateDir[_MAX_PATH];
+  char szProjectsDir[_MAX_PATH];
+  char szWith[_MAX_PATH];
+  int iUnityBatch;
+  unsigned int uiOptions;
+};
+
+/**
+ * State of the caller between the generations
+ */
+struct STRUCT_MKCPROJ_CTX
+{
+  int iRsl;
+  char szError[1024];
+  bool bPrintErrors;
+  bool bVerbose;
+  bool bSink;                       /* false: the directory of the spec        */
+  STRUCT_OUTPUT_SINK stSink;
+  STRUCT_PROJECT_FILES stFiles;
+};
+
+/**
+ * The generation uses the globals of mkcproj, so
+ * only one thread generates a project at a time
+ */
+static pthread_mutex_t gstMkcprojMutex = PTHREAD_MUTEX_INITIALIZER;
+
+PSTRUCT_MKCPROJ_SPEC pstMkcprojNewSpec(void)
+{
+  return (PSTRUCT_MKCPROJ_SPEC) calloc(1, sizeof(STRUCT_MKCPROJ_SPEC));
+}
+
+void vMkcprojFreeSpec(PSTRUCT_MKCPROJ_SPEC pstSpec)
+{
+  free(pstSpec);
+}
+
+bool bMkcprojSetSpecText(PSTRUCT_MKCPROJ_SPEC pstSpec, ENUM_MKCPROJ_SPEC_FIELD eField, const char *kpszValue)
+{
+  char *pszField = NULL;
+
+  switch(eField)
+  {
+    case MKCPROJ_SPEC_PROJ_NAME:
+      pszField = pstSpec->szProjName;
+      break;
+    case MKCPROJ_SPEC_DEV_NAME:
+      pszField = pstSpec->szDevName;
+      break;
+    case MKCPROJ_SPEC_DEV_MAIL:
+      pszField = pstSpec->szDevMail;
+      break;
+    case MKCPROJ_SPEC_PROJ_DESCRIPTION:
+      pszField = pstSpec->szProjDescription;
+      break;
+    case MKCPROJ_SPEC_LICENSE:
+      pszField = pstSpec->szLicense;
+      break;
+    case MKCPROJ_SPEC_TEMPLATE_DIR:
+      pszField = pstSpec->szTemplateDir;
+      break;
+    case MKCPROJ_SPEC_PROJECTS_DIR:
+      pszField = pstSpec->szProjectsDir;
+      break;
+    case MKCPROJ_SPEC_WITH:
+      pszField = pstSpec->szWith;
+      break;
+    default:
+      return false;
+  }
+
+  /* All the fields have the same size */
+  if(kpszValue == NULL)
+  {
+    kpszValue = "";
+  }
+
+  return snprintf(pszField, _MAX_PATH, "%s", kpszValue) < _MAX_PATH;
+}
+
+void vMkcprojSetSpecUnityBatch(PSTRUCT_MKCPROJ_SPEC pstSpec, int iUnityBatch)
+{
+  pstSpec->iUnityBatch = iUnityBatch;
+}
+
+void vMkcprojSetSpecOptions(PSTRUCT_MKCPROJ_SPEC pstSpec, unsigned int uiOptions)
+{
+  pstSpec->uiOptions = uiOptions;
+}
+
+PSTRUCT_MKCPROJ_CTX pstMkcprojNewCtx(void)
+{
+  return (PSTRUCT_MKCPROJ_CTX) calloc(1, sizeof(STRUCT_MKCPROJ_CTX));
+}
+
+void vMkcprojFreeCtx(PSTRUCT_MKCPROJ_CTX pstCtx)
+{
+  if(pstCtx == NULL)
+  {
+    return;
+  }
+
+  free(pstCtx->stFiles.pastFiles);
+  free(pstCtx);
+}
+
+void vMkcprojSetCtxOutput(PSTRUCT_MKCPROJ_CTX pstCtx, bool bPrintErrors, bool bVerbose)
+{
+  pstCtx->bPrintErrors = bPrintErrors;
+  pstCtx->bVerbose = bVerbose;
+}
+
+void vMkcprojSetSink(PSTRUCT_MKCPROJ_CTX pstCtx,
+                     bool (*pbWriteDir)(void *pvData, const char *kpszPath, mode_t iMode),
+                     bool (*pbWriteFile)(void *pvData, const char *kpszPath, mode_t iMode,
+                                         const char *kpszContent, size_t lSize),
+                     bool (*pbFinish)(void *pvData), void *pvData)
+{
+  memset(&pstCtx->stSink, 0, sizeof(pstCtx->stSink));
+
+  pstCtx->stSink.pbWriteDir = pbWriteDir;
+  pstCtx->stSink.pbWriteFile = pbWriteFile;
+  pstCtx->stSink.pbFinish = pbFinish;
+  pstCtx->stSink.pvData = pvData;
+  pstCtx->bSink = true;
+}
+
+void vMkcprojSetTarSink(PSTRUCT_MKCPROJ_CTX pstCtx, FILE *fpTar)
+{
+  vInitTarSink(&pstCtx->stSink, fpTar);
+  pstCtx->bSink = true;
+}
+
+int iMkcprojGetResult(const STRUCT_MKCPROJ_CTX *kpstCtx)
+{
+  return kpstCtx->iRsl;
+}
+
+const char *kpszMkcprojGetError(const STRUCT_MKCPROJ_CTX *kpstCtx)
+{
+  return kpstCtx->szError;
+}
+
+int iMkcprojGetFilesCount(const STRUCT_MKCPROJ_CTX *kpstCtx)
+{
+  return kpstCtx->stFiles.iFilesCount;
+}
+
+const char *kpszMkcprojGetFile(const STRUCT_MKCPROJ_CTX *kpstCtx, int iFile, mode_t *piMode)
+{
+  if(iFile < 0 || iFile >= kpstCtx->stFiles.iFilesCount)
+  {
+    return NULL;
+  }
+
+  if(piMode != NULL)
+  {
+    *piMode = kpstCtx->stFiles.pastFiles[iFile].iMode;
+  }
+
+  return kpstCtx->stFiles.pastFiles[iFile].szRelativePath;
+}
+
+/**
+ * Next entry of the memory sink
+ */
+static PSTRUCT_MKCPROJ_MEMORY_FILE pstPushMemoryFile(PSTRUCT_MKCPROJ_MEMORY pstMemory, const char *kpszPath,
+                                                     mode_t iMode)
+{
+  PSTRUCT_MKCPROJ_MEMORY_FILE pastTmp = NULL;
+  PSTRUCT_MKCPROJ_MEMORY_FILE pstFile = NULL;
+
+  if(pstMemory->iFilesCount == pstMemory->iFilesAlloc)
+  {
+    pstMemory->iFilesAlloc = pstMemory->iFilesAlloc == 0 ? 64 : pstMemory->iFilesAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_MKCPROJ_MEMORY_FILE) realloc(pstMemory->pastFiles,
+                                                        pstMemory->iFilesAlloc * sizeof(STRUCT_MKCPROJ_MEMORY_FILE))) == NULL)
+    {
+      pstMemory->iFilesAlloc = pstMemory->iFilesCount;
+
+      return NULL;
+    }
+
+    pstMemory->pastFiles = pastTmp;
+  }
+
+  pstFile = &pstMemory->pastFiles[pstMemory->iFilesCount++];
+
+  memset(pstFile, 0, sizeof(STRUCT_MKCPROJ_MEMORY_FILE));
+
+  snprintf(pstFile->szPath, sizeof(pstFile->szPath), "%s", kpszPath);
+  pstFile->iMode = iMode;
+
+  return pstFile;
+}
+
+static bool bWriteMemoryDir(void *pvMemory, const char *kpszPath, mode_t iMode)
+{
+  PSTRUCT_MKCPROJ_MEMORY_FILE pstFile = NULL;
+
+  if((pstFile = pstPushMemoryFile((PSTRUCT_MKCPROJ_MEMORY) pvMemory, kpszPath, iMode)) == NULL)
+  {
+    return false;
+  }
+
+  pstFile->bDir = true;
+
+  return true;
+}
+
+static bool bWriteMemoryFile(void *pvMemory, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize)
+{
+  PSTRUCT_MKCPROJ_MEMORY pstMemory = (PSTRUCT_MKCPROJ_MEMORY) pvMemory;
+  PSTRUCT_MKCPROJ_MEMORY_FILE pstFile = NULL;
+  char *pszContent = NULL;
+
+  /* The content is always ended by '\0', to be used as a string */
+  if((pszContent = (char *) malloc(lSize + 1)) == NULL)
+  {
+    return false;
+  }
+
+  memcpy(pszContent, kpszContent, lSize);
+  pszContent[lSize] = '\0';
+
+  if((pstFile = pstPushMemoryFile(pstMemory, kpszPath, iMode)) == NULL)
+  {
+    free(pszContent);
+
+    return false;
+  }
+
+  pstFile->pszContent = pszContent;
+  pstFile->lSize = lSize;
+
+  return true;
+}
+
+void vMkcprojSetMemorySink(PSTRUCT_MKCPROJ_CTX pstCtx, PSTRUCT_MKCPROJ_MEMORY pstMemory)
+{
+  vMkcprojSetSink(pstCtx, bWriteMemoryDir, bWriteMemoryFile, NULL, pstMemory);
+}
+
+void vMkcprojFreeMemory(PSTRUCT_MKCPROJ_MEMORY pstMemory)
+{
+  int ii;
+
+  for(ii = 0; ii < pstMemory->iFilesCount; ii++)
+  {
+    free(pstMemory->pastFiles[ii].pszContent);
+  }
+
+  free(pstMemory->pastFiles);
+
+  memset(pstMemory, 0, sizeof(STRUCT_MKCPROJ_MEMORY));
+}
+
+/**
+ * Copy the spec to the globals of mkcproj (gstCmdLine, paths, ...),
+ * only with gstMkcprojMutex locked
+ */
+static bool bSetMkcprojSpec(const STRUCT_MKCPROJ_SPEC *kpstSpec)
+{
+  struct stat stFileStat;
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+
+  if(bStrIsEmpty(kpstSpec->szProjName) || strchr(kpstSpec->szProjName, '/') != NULL)
+  {
+    vPrintErrorMessage(_("Invalid name of project: %s"), kpstSpec->szProjName);
+
+    return false;
+  }
+
+  /* Nothing of the last generation (or of the command line) is kept */
+  memset(&gstCmdLine, 0, sizeof(gstCmdLine));
+
+  snprintf(gstCmdLine.szProjName, sizeof(gstCmdLine.szProjName), "%s", kpstSpec->szProjName);
+  snprintf(gstCmdLine.szDevName, sizeof(gstCmdLine.szDevName), "%s", kpstSpec->szDevName);
+  snprintf(gstCmdLine.szDevMail, sizeof(gstCmdLine.szDevMail), "%s", kpstSpec->szDevMail);
+  snprintf(gstCmdLine.szProjDescription, sizeof(gstCmdLine.szProjDescription), "%s", kpstSpec->szProjDescription);
+  snprintf(gstCmdLine.szLicense, sizeof(gstCmdLine.szLicense), "%s",
+           bStrIsEmpty(kpstSpec->szLicense) ? "GPLv2" : kpstSpec->szLicense);
+
+  snprintf(gstCmdLine.szWith, sizeof(gstCmdLine.szWith), "%s", kpstSpec->szWith);
+
+  if(kpstSpec->iUnityBatch > 0)
+  {
+    snprintf(gstCmdLine.szUnityBatch, sizeof(gstCmdLine.szUnityBatch), "%d", kpstSpec->iUnityBatch);
+  }
+
+  if(bStrIsEmpty(kpstSpec->szTemplateDir))
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s/Template/%s", HOME, TEMPLATE_DIR);
+  }
+  else
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", kpstSpec->szTemplateDir);
+  }
+
+  /* A file is a .tar or .tar.gz of the template (--template-archive) */
+  if(stat(gszTemplatePathDir, &stFileStat) == 0 && S_ISREG(stFileStat.st_mode))
+  {
+    snprintf(gstCmdLine.szTemplateArchive, sizeof(gstCmdLine.szTemplateArchive), "%s", kpstSpec->szTemplateDir);
+  }
+
+  if(bStrIsEmpty(kpstSpec->szProjectsDir))
+  {
+    snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s/%s", HOME, PROJECTS_DIR);
+  }
+  else
+  {
+    snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s", kpstSpec->szProjectsDir);
+  }
+
+  snprintf(gszFullNewProjectPathDir, sizeof(gszFullNewProjectPathDir), "%s/%s", gszProjectsPathDir,
+           gstCmdLine.szProjName);
+
+  gbUnityBuild = kpstSpec->iUnityBatch > 0;
+  gbPrecompiledHeader = (kpstSpec->uiOptions & MKCPROJ_OPTION_PCH) != 0;
+  gbBench = (kpstSpec->uiOptions & MKCPROJ_OPTION_BENCH) != 0 || !bStrIsEmpty(kpstSpec->szWith);
+  gbManifest = (kpstSpec->uiOptions & MKCPROJ_OPTION_MANIFEST) != 0;
+  gbMonorepo = false;
+  gbDedupStore = false;
+
+  if(gkpszProgramName == NULL)
+  {
+    gkpszProgramName = "libmkcproj";
+  }
+
+  return true;
+}
+
+int iMkcprojGenerate(PSTRUCT_MKCPROJ_CTX pstCtx, const STRUCT_MKCPROJ_SPEC *kpstSpec)
+{
+  int iRsl = 0;
+
+  pthread_mutex_lock(&gstMkcprojMutex);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  gbPrintErrors = pstCtx->bPrintErrors;
+  gbVerbose = pstCtx->bVerbose;
+  memset(gszLastError, 0, sizeof(gszLastError));
+
+  free(pstCtx->stFiles.pastFiles);
+  memset(&pstCtx->stFiles, 0, sizeof(pstCtx->stFiles));
+
+  if(!bSetMkcprojSpec(kpstSpec))
+  {
+    iRsl = -1;
+  }
+  else
+  {
+    iRsl = iGenerateProject(pstCtx->bSink ? &pstCtx->stSink : NULL);
+  }
+
+  /* The context takes the list of files, the index isn't used anymore */
+  pstCtx->stFiles = gstProjectFiles;
+  memset(&gstProjectFiles, 0, sizeof(gstProjectFiles));
+  vFreeTemplateIndex();
+
+  pstCtx->iRsl = iRsl;
+  snprintf(pstCtx->szError, sizeof(pstCtx->szError), "%s", iRsl == 0 ? "" : gszLastError);
+
+  if(iRsl != 0 && bStrIsEmpty(pstCtx->szError))
+  {
+    snprintf(pstCtx->szError, sizeof(pstCtx->szError), _("Impossible create the project (%d)"), iRsl);
+  }
+
+  gbPrintErrors = true;
+  gbVerbose = false;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  pthread_mutex_unlock(&gstMkcprojMutex);
+
+  return iRsl;
+}
@@ -0,0 +1,303 @@
+/**
+ * lock.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Many mkcproj running at the same time: a log file
+ *              for each process and a lock for each project
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "lock.h"
+
+bool gbMergeLogs = false;
+
+/**
+ * Descriptors that keep the locks, -1 without lock
+ */
+static int giLogLockFd = -1;
+static int giProjectLockFd = -1;
+
+void vGetLogShardName(const char *kpszLogFileName, long lPid, char *pszShardName, size_t lShardNameSize)
+{
+  size_t lStemLen = strlen(kpszLogFileName);
+
+  if(lStemLen > 4 && strcmp(kpszLogFileName + lStemLen - 4, ".log") == 0)
+  {
+    lStemLen -= 4;
+  }
+
+  snprintf(pszShardName, lShardNameSize, "%.*s.%ld.log", (int) lStemLen, kpszLogFileName, lPid);
+}
+
+void vSetSharedLogFileName(const char *kpszLogFileName)
+{
+  char szShardName[_MAX_PATH + 32];
+
+  memset(szShardName, 0, sizeof(szShardName));
+
+  if((giLogLockFd = open(kpszLogFileName, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) < 0)
+  {
+    /* The log library reports the errors of the file */
+    vSetLogFileName(kpszLogFileName);
+
+    return;
+  }
+
+  if(flock(giLogLockFd, LOCK_EX | LOCK_NB) == 0)
+  {
+    vSetLogFileName(kpszLogFileName);
+
+    return;
+  }
+
+  close(giLogLockFd);
+
+  /* Other mkcproj writes in the log file, so this process has its own log */
+  vGetLogShardName(kpszLogFileName, (long) getpid(), szShardName, sizeof(szShardName));
+
+  if((giLogLockFd = open(szShardName, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) >= 0)
+  {
+    flock(giLogLockFd, LOCK_EX | LOCK_NB);
+  }
+
+  vSetLogFileName(szShardName);
+}
+
+/**
+ * Append the log shard kpszShardPath in the log file iLogFd and
+ * remove it, when its process already ended (it isn't locked)
+ */
+static int iMergeLogShard(int iLogFd, const char *kpszShardPath)
+{
+  struct stat stStat;
+  char *pszRecord = NULL;
+  ssize_t lRead = 0;
+  size_t lHeaderLen = 0;
+  size_t lOffset = 0;
+  int iShardFd = -1;
+  int iRsl = 0;
+
+  if((iShardFd = open(kpszShardPath, O_RDONLY | O_CLOEXEC)) < 0)
+  {
+    return 0;
+  }
+
+  if(flock(iShardFd, LOCK_EX | LOCK_NB) != 0)
+  {
+    /* The process of this log is running */
+    close(iShardFd);
+
+    return 0;
+  }
+
+  if(fstat(iShardFd, &stStat) != 0 ||
+     (pszRecord = (char *) malloc(_MAX_PATH + 32 + stStat.st_size)) == NULL)
+  {
+    close(iShardFd);
+
+    return -1;
+  }
+
+  /* Header and content in a single write(), O_APPEND keeps it in one piece */
+  lHeaderLen = snprintf(pszRecord, _MAX_PATH + 32, "==> %s <==\n", kpszShardPath);
+  lOffset = lHeaderLen;
+
+  while(lOffset < lHeaderLen + (size_t) stStat.st_size &&
+        (lRead = read(iShardFd, pszRecord + lOffset, lHeaderLen + stStat.st_size - lOffset)) > 0)
+  {
+    lOffset += lRead;
+  }
+
+  if(lRead < 0 || write(iLogFd, pszRecord, lOffset) != (ssize_t) lOffset)
+  {
+    vPrintErrorMessage(_("Impossible merge the log %s: %s"), kpszShardPath, strerror(errno));
+
+    iRsl = -1;
+  }
+  else if(unlink(kpszShardPath) != 0)
+  {
+    iRsl = -1;
+  }
+
+  free(pszRecord);
+  close(iShardFd);
+
+  return iRsl;
+}
+
+int iMergeLogShards(const char *kpszLogFileName)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  const char *kpszSlash = strrchr(kpszLogFileName, '/');
+  const char *kpszBase = kpszSlash != NULL ? kpszSlash + 1 : kpszLogFileName;
+  char szDir[_MAX_PATH];
+  char szStem[_MAX_PATH];
+  char szShardPath[_MAX_PATH * 2];
+  char *pchEndPtr = NULL;
+  size_t lStemLen = 0;
+  int iLogFd = -1;
+  int iMerged = 0;
+  int iRsl = 0;
+
+  memset(szDir, 0, sizeof(szDir));
+  memset(szStem, 0, sizeof(szStem));
+  memset(szShardPath, 0, sizeof(szShardPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szDir, sizeof(szDir), "%.*s", kpszSlash != NULL ? (int) (kpszSlash - kpszLogFileName) + 1 : 2,
+                                         kpszSlash != NULL ? kpszLogFileName : "./");
+
+  /* "mkcproj.log" -> the shards are "mkcproj.<pid>.log" */
+  vGetLogShardName(kpszBase, 0, szStem, sizeof(szStem));
+  lStemLen = strlen(szStem) - strlen("0.log");
+
+  if((iLogFd = open(kpszLogFileName, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) < 0 ||
+     (pDir = opendir(szDir)) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), iLogFd < 0 ? kpszLogFileName : szDir, strerror(errno));
+
+    if(iLogFd >= 0)
+    {
+      close(iLogFd);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  while((pstEntry = readdir(pDir)) != NULL)
+  {
+    if(strncmp(pstEntry->d_name, szStem, lStemLen) != 0 ||
+       strtol(pstEntry->d_name + lStemLen, &pchEndPtr, 10) <= 0 ||
+       pchEndPtr == pstEntry->d_name + lStemLen || strcmp(pchEndPtr, ".log") != 0)
+    {
+      continue;
+    }
+
+    snprintf(szShardPath, sizeof(szShardPath), "%s%s", szDir, pstEntry->d_name);
+
+    if(iMergeLogShard(iLogFd, szShardPath) != 0)
+    {
+      iRsl = -1;
+      continue;
+    }
+
+    iMerged++;
+  }
+
+  closedir(pDir);
+  close(iLogFd);
+
+  vPrintVerbose(_("Merged %d logs in %s\n"), iMerged, kpszLogFileName);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+void vGetProjectLockPath(const char *kpszProjectPathDir, char *pszLockPath, size_t lLockPathSize)
+{
+  const char *kpszParent = ".";
+  const char *kpszName = NULL;
+  char *pszRealPath = NULL;
+  char *pszSlash = NULL;
+  char szPath[_MAX_PATH * 2];
+
+  memset(szPath, 0, sizeof(szPath));
+
+  /* "proj/", "./proj" and "/abs/proj" are the same project */
+  if((pszRealPath = realpath(kpszProjectPathDir, NULL)) != NULL)
+  {
+    snprintf(szPath, sizeof(szPath), "%s", pszRealPath);
+    free(pszRealPath);
+    pszRealPath = NULL;
+  }
+  else
+  {
+    snprintf(szPath, sizeof(szPath), "%s", kpszProjectPathDir);
+  }
+
+  while(strlen(szPath) > 1 && szPath[strlen(szPath) - 1] == '/')
+  {
+    szPath[strlen(szPath) - 1] = '\0';
+  }
+
+  /* "<projects>/<name>" -> "<projects>/.<name>.lock" */
+  kpszName = szPath;
+
+  if((pszSlash = strrchr(szPath, '/')) != NULL)
+  {
+    *pszSlash = '\0';
+    kpszParent = pszSlash == szPath ? "/" : szPath;
+    kpszName = pszSlash + 1;
+  }
+
+  /* The project isn't created yet, but its parent directory exists */
+  if((pszRealPath = realpath(kpszParent, NULL)) != NULL)
+  {
+    kpszParent = pszRealPath;
+  }
+
+  snprintf(pszLockPath, lLockPathSize, "%s/.%s%s", strcmp(kpszParent, "/") == 0 ? "" : kpszParent,
+                                                  kpszName, PROJECT_LOCK_SUFFIX);
+
+  free(pszRealPath);
+}
+
+bool bLockProject(const char *kpszProjectPathDir)
+{
+  char szLockPath[_MAX_PATH * 2];
+  int iErrno = 0;
+
+  memset(szLockPath, 0, sizeof(szLockPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  vUnlockProject();
+
+  vGetProjectLockPath(kpszProjectPathDir, szLockPath, sizeof(szLockPath));
+
+  if((giProjectLockFd = open(szLockPath, O_RDWR | O_CREAT | O_CLOEXEC, 0644)) < 0)
+  {
+    iErrno = errno;
+
+    /* Without the projects directory there is nothing to lock, the creation reports it */
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (%s: %s)"), __func__, szLockPath, strerror(iErrno));
+
+    return iErrno == ENOENT;
+  }
+
+  if(flock(giProjectLockFd, LOCK_EX | LOCK_NB) != 0)
+  {
+    vPrintErrorMessage(_("Other mkcproj is using the project %s"), kpszProjectPathDir);
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible lock %s: %s"), szLockPath, strerror(errno));
+
+    close(giProjectLockFd);
+    giProjectLockFd = -1;
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+void vUnlockProject(void)
+{
+  /* The lock file is kept, remove it would let two processes lock different files */
+  if(giProjectLockFd >= 0)
+  {
+    close(giProjectLockFd);
+    giProjectLockFd = -1;
+  }
+}
@@ -0,0 +1,495 @@
+/**
+ * manifest.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Manifest with the hash of each file of the project,
+ *              to find the files changed after the creation
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "manifest.h"
+
+bool gbManifest = false;
+
+/**
+ * Primes of XXH64
+ */
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+#define XXH_ROTL64(ui64Value, iBits) (((ui64Value) << (iBits)) | ((ui64Value) >> (64 - (iBits))))
+
+static inline uint64_t ui64ReadLE64(const unsigned char *kpucData)
+{
+  uint64_t ui64Value;
+
+  memcpy(&ui64Value, kpucData, sizeof(ui64Value));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  ui64Value = __builtin_bswap64(ui64Value);
+#endif
+
+  return ui64Value;
+}
+
+static inline uint32_t ui32ReadLE32(const unsigned char *kpucData)
+{
+  uint32_t ui32Value;
+
+  memcpy(&ui32Value, kpucData, sizeof(ui32Value));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  ui32Value = __builtin_bswap32(ui32Value);
+#endif
+
+  return ui32Value;
+}
+
+static inline uint64_t ui64Xxh64Round(uint64_t ui64Acc, uint64_t ui64Input)
+{
+  ui64Acc += ui64Input * XXH_PRIME64_2;
+  ui64Acc = XXH_ROTL64(ui64Acc, 31);
+
+  return ui64Acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t ui64Xxh64MergeRound(uint64_t ui64Acc, uint64_t ui64Value)
+{
+  ui64Acc ^= ui64Xxh64Round(0, ui64Value);
+
+  return ui64Acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t ui64HashXxh64(const void *kpvData, size_t lSize, uint64_t ui64Seed)
+{
+  const unsigned char *kpucData = (const unsigned char *) kpvData;
+  const unsigned char *kpucEnd = kpucData + lSize;
+  uint64_t aui64Acc[4];
+  uint64_t ui64Hash = 0;
+
+  if(lSize >= 32)
+  {
+    aui64Acc[0] = ui64Seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    aui64Acc[1] = ui64Seed + XXH_PRIME64_2;
+    aui64Acc[2] = ui64Seed;
+    aui64Acc[3] = ui64Seed - XXH_PRIME64_1;
+
+    /* 4 independent lanes of 8 bytes, the CPU runs them in parallel */
+    do
+    {
+      aui64Acc[0] = ui64Xxh64Round(aui64Acc[0], ui64ReadLE64(kpucData));
+      aui64Acc[1] = ui64Xxh64Round(aui64Acc[1], ui64ReadLE64(kpucData + 8));
+      aui64Acc[2] = ui64Xxh64Round(aui64Acc[2], ui64ReadLE64(kpucData + 16));
+      aui64Acc[3] = ui64Xxh64Round(aui64Acc[3], ui64ReadLE64(kpucData + 24));
+      kpucData += 32;
+    } while(kpucEnd - kpucData >= 32);
+
+    ui64Hash = XXH_ROTL64(aui64Acc[0], 1) + XXH_ROTL64(aui64Acc[1], 7) +
+               XXH_ROTL64(aui64Acc[2], 12) + XXH_ROTL64(aui64Acc[3], 18);
+
+    ui64Hash = ui64Xxh64MergeRound(ui64Hash, aui64Acc[0]);
+    ui64Hash = ui64Xxh64MergeRound(ui64Hash, aui64Acc[1]);
+    ui64Hash = ui64Xxh64MergeRound(ui64Hash, aui64Acc[2]);
+    ui64Hash = ui64Xxh64MergeRound(ui64Hash, aui64Acc[3]);
+  }
+  else
+  {
+    ui64Hash = ui64Seed + XXH_PRIME64_5;
+  }
+
+  ui64Hash += (uint64_t) lSize;
+
+  while(kpucEnd - kpucData >= 8)
+  {
+    ui64Hash ^= ui64Xxh64Round(0, ui64ReadLE64(kpucData));
+    ui64Hash = XXH_ROTL64(ui64Hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    kpucData += 8;
+  }
+
+  if(kpucEnd - kpucData >= 4)
+  {
+    ui64Hash ^= (uint64_t) ui32ReadLE32(kpucData) * XXH_PRIME64_1;
+    ui64Hash = XXH_ROTL64(ui64Hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+    kpucData += 4;
+  }
+
+  while(kpucData < kpucEnd)
+  {
+    ui64Hash ^= (*kpucData++) * XXH_PRIME64_5;
+    ui64Hash = XXH_ROTL64(ui64Hash, 11) * XXH_PRIME64_1;
+  }
+
+  /* Avalanche */
+  ui64Hash ^= ui64Hash >> 33;
+  ui64Hash *= XXH_PRIME64_2;
+  ui64Hash ^= ui64Hash >> 29;
+  ui64Hash *= XXH_PRIME64_3;
+  ui64Hash ^= ui64Hash >> 32;
+
+  return ui64Hash;
+}
+
+bool bSetManifestEntry(PSTRUCT_MANIFEST pstManifest, const char *kpszRelativePath, uint64_t ui64Hash)
+{
+  PSTRUCT_MANIFEST_ENTRY pastTmp = NULL;
+  int ii;
+
+  for(ii = 0; ii < pstManifest->iEntriesCount; ii++)
+  {
+    if(strcmp(pstManifest->pastEntries[ii].szRelativePath, kpszRelativePath) == 0)
+    {
+      pstManifest->pastEntries[ii].ui64Hash = ui64Hash;
+
+      return true;
+    }
+  }
+
+  if(pstManifest->iEntriesCount == pstManifest->iEntriesAlloc)
+  {
+    pstManifest->iEntriesAlloc = pstManifest->iEntriesAlloc == 0 ? 64 : pstManifest->iEntriesAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_MANIFEST_ENTRY) realloc(pstManifest->pastEntries,
+                                                   pstManifest->iEntriesAlloc * sizeof(STRUCT_MANIFEST_ENTRY))) == NULL)
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the manifest"));
+
+      return false;
+    }
+
+    pstManifest->pastEntries = pastTmp;
+  }
+
+  snprintf(pstManifest->pastEntries[pstManifest->iEntriesCount].szRelativePath,
+           sizeof(pstManifest->pastEntries[0].szRelativePath), "%s", kpszRelativePath);
+  pstManifest->pastEntries[pstManifest->iEntriesCount++].ui64Hash = ui64Hash;
+
+  return true;
+}
+
+int iReadManifest(const char *kpszProjectPathDir, PSTRUCT_MANIFEST pstManifest)
+{
+  FILE *fpManifest = NULL;
+  char szManifestPath[_MAX_PATH + 32];
+  char szLine[_MAX_PATH + 32];
+  char *pchEndPtr = NULL;
+  uint64_t ui64Hash = 0;
+  int iRsl = 0;
+
+  memset(szManifestPath, 0, sizeof(szManifestPath));
+  memset(szLine, 0, sizeof(szLine));
+
+  snprintf(szManifestPath, sizeof(szManifestPath), "%s/%s", kpszProjectPathDir, MANIFEST_FILE);
+
+  if((fpManifest = fopen(szManifestPath, "r")) == NULL)
+  {
+    return -1;
+  }
+
+  while(fgets(szLine, sizeof(szLine), fpManifest) != NULL)
+  {
+    szLine[strcspn(szLine, "\n")] = '\0';
+
+    /* "<16 hex digits>  <path>" */
+    ui64Hash = strtoull(szLine, &pchEndPtr, 16);
+
+    if(pchEndPtr != szLine + 16 || strncmp(pchEndPtr, "  ", 2) != 0 || pchEndPtr[2] == '\0')
+    {
+      vPrintErrorMessage(_("Invalid line in %s: %s"), szManifestPath, szLine);
+
+      iRsl = -1;
+      break;
+    }
+
+    if(!bSetManifestEntry(pstManifest, pchEndPtr + 2, ui64Hash))
+    {
+      iRsl = -1;
+      break;
+    }
+  }
+
+  fclose(fpManifest);
+
+  return iRsl;
+}
+
+int iCompareManifestEntries(const void *kpvEntry1, const void *kpvEntry2)
+{
+  return strcmp(((const STRUCT_MANIFEST_ENTRY *) kpvEntry1)->szRelativePath,
+                ((const STRUCT_MANIFEST_ENTRY *) kpvEntry2)->szRelativePath);
+}
+
+int iWriteManifest(void)
+{
+  STRUCT_MANIFEST stManifest;
+  STRUCT_NEW_FILE stNewFile;
+  PSTRUCT_PROJECT_FILE pstFile = NULL;
+  char szManifestPath[sizeof(gszFullNewProjectPathDir) + 32];
+  int iRsl = 0;
+  int ii;
+
+  memset(&stManifest, 0, sizeof(stManifest));
+  memset(szManifestPath, 0, sizeof(szManifestPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* The lines of the files that were not created again are kept */
+  if(gpstOutputSink == NULL)
+  {
+    iReadManifest(gszFullNewProjectPathDir, &stManifest);
+  }
+
+  /* The hashes were calculated while the files were written (bCloseNewFile) */
+  for(ii = 0; ii < gstProjectFiles.iFilesCount; ii++)
+  {
+    pstFile = &gstProjectFiles.pastFiles[ii];
+
+    if(!pstFile->bHashed || pstFile->szRelativePath[0] == '/' ||
+       strcmp(pstFile->szRelativePath, MANIFEST_FILE) == 0)
+    {
+      continue;
+    }
+
+    if(!bSetManifestEntry(&stManifest, pstFile->szRelativePath, pstFile->ui64Hash))
+    {
+      free(stManifest.pastEntries);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+  }
+
+  qsort(stManifest.pastEntries, stManifest.iEntriesCount, sizeof(STRUCT_MANIFEST_ENTRY), iCompareManifestEntries);
+
+  snprintf(szManifestPath, sizeof(szManifestPath), "%s/%s", gszFullNewProjectPathDir, MANIFEST_FILE);
+
+  if(!bOpenNewFile(&stNewFile, szManifestPath, 0))
+  {
+    free(stManifest.pastEntries);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  for(ii = 0; ii < stManifest.iEntriesCount; ii++)
+  {
+    fprintf(stNewFile.fpFile, "%016llx  %s\n", (unsigned long long) stManifest.pastEntries[ii].ui64Hash,
+                                                stManifest.pastEntries[ii].szRelativePath);
+  }
+
+  if(!bCloseNewFile(&stNewFile, 0644))
+  {
+    iRsl = -1;
+  }
+
+  free(stManifest.pastEntries);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+/**
+ * Hash of the file kpszPath, mapped in the memory
+ */
+static int iHashFile(const char *kpszPath, uint64_t *pui64Hash)
+{
+  struct stat stFileStat;
+  void *pvContent = NULL;
+  int iFd = -1;
+
+  if((iFd = open(kpszPath, O_RDONLY | O_CLOEXEC)) < 0)
+  {
+    return -1;
+  }
+
+  if(fstat(iFd, &stFileStat) != 0)
+  {
+    close(iFd);
+
+    return -1;
+  }
+
+  if(stFileStat.st_size == 0)
+  {
+    close(iFd);
+    *pui64Hash = ui64HashXxh64("", 0, 0);
+
+    return 0;
+  }
+
+  pvContent = mmap(NULL, stFileStat.st_size, PROT_READ, MAP_PRIVATE, iFd, 0);
+  close(iFd);
+
+  if(pvContent == MAP_FAILED)
+  {
+    return -1;
+  }
+
+  madvise(pvContent, stFileStat.st_size, MADV_SEQUENTIAL);
+
+  *pui64Hash = ui64HashXxh64(pvContent, stFileStat.st_size, 0);
+
+  munmap(pvContent, stFileStat.st_size);
+
+  return 0;
+}
+
+void *pvVerifyWorker(void *pvQueue)
+{
+  PSTRUCT_VERIFY_QUEUE pstQueue = (PSTRUCT_VERIFY_QUEUE) pvQueue;
+  PSTRUCT_VERIFY_JOB pstJob = NULL;
+  uint64_t ui64Hash = 0;
+  int iRsl = 0;
+  int iErrno = 0;
+
+  while(true)
+  {
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(pstQueue->iNextJob >= pstQueue->iJobsCount)
+    {
+      pthread_mutex_unlock(&pstQueue->stMutex);
+      break;
+    }
+
+    pstJob = &pstQueue->pastJobs[pstQueue->iNextJob++];
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+
+    iRsl = iHashFile(pstJob->szPath, &ui64Hash);
+    iErrno = errno;
+
+    if(iRsl == 0 && ui64Hash == pstJob->ui64Hash)
+    {
+      continue;
+    }
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(iRsl != 0 && iErrno == ENOENT)
+    {
+      printf(_("%s: MISSING\n"), pstJob->szPath);
+      pstQueue->iMissing++;
+    }
+    else
+    {
+      printf(_("%s: FAILED\n"), pstJob->szPath);
+      pstQueue->iChanged++;
+    }
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+  }
+
+  return NULL;
+}
+
+int iVerifyManifests(int iProjectsCount, char **ppszProjectsPathDir)
+{
+  STRUCT_VERIFY_QUEUE stQueue;
+  STRUCT_MANIFEST stManifest;
+  PSTRUCT_VERIFY_JOB pastTmp = NULL;
+  pthread_t atThreads[MANIFEST_MAX_THREADS];
+  long lThreadsCount = sysconf(_SC_NPROCESSORS_ONLN);
+  int iThreadsStarted = 0;
+  int iInvalid = 0;
+  int ii;
+  int jj;
+
+  memset(&stQueue, 0, sizeof(stQueue));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* The files of every project in a single queue */
+  for(ii = 0; ii < iProjectsCount; ii++)
+  {
+    memset(&stManifest, 0, sizeof(stManifest));
+
+    if(iReadManifest(ppszProjectsPathDir[ii], &stManifest) != 0)
+    {
+      vPrintErrorMessage(_("Impossible read the manifest %s/%s"), ppszProjectsPathDir[ii], MANIFEST_FILE);
+
+      free(stManifest.pastEntries);
+      iInvalid++;
+      continue;
+    }
+
+    if(stQueue.iJobsCount + stManifest.iEntriesCount > stQueue.iJobsAlloc)
+    {
+      stQueue.iJobsAlloc = (stQueue.iJobsCount + stManifest.iEntriesCount) * 2;
+
+      if((pastTmp = (PSTRUCT_VERIFY_JOB) realloc(stQueue.pastJobs,
+                                                 stQueue.iJobsAlloc * sizeof(STRUCT_VERIFY_JOB))) == NULL)
+      {
+        vPrintErrorMessage(_("Impossible allocate memory to verify the projects"));
+
+        free(stManifest.pastEntries);
+        free(stQueue.pastJobs);
+
+        if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+        return -1;
+      }
+
+      stQueue.pastJobs = pastTmp;
+    }
+
+    for(jj = 0; jj < stManifest.iEntriesCount; jj++)
+    {
+      snprintf(stQueue.pastJobs[stQueue.iJobsCount].szPath, sizeof(stQueue.pastJobs[0].szPath), "%s/%s",
+               ppszProjectsPathDir[ii], stManifest.pastEntries[jj].szRelativePath);
+      stQueue.pastJobs[stQueue.iJobsCount++].ui64Hash = stManifest.pastEntries[jj].ui64Hash;
+    }
+
+    free(stManifest.pastEntries);
+  }
+
+  pthread_mutex_init(&stQueue.stMutex, NULL);
+
+  if(lThreadsCount < 1)
+  {
+    lThreadsCount = 1;
+  }
+  else if(lThreadsCount > MANIFEST_MAX_THREADS)
+  {
+    lThreadsCount = MANIFEST_MAX_THREADS;
+  }
+
+  for(ii = 0; ii < lThreadsCount && ii < stQueue.iJobsCount; ii++)
+  {
+    if(pthread_create(&atThreads[ii], NULL, pvVerifyWorker, &stQueue) != 0)
+    {
+      break;
+    }
+
+    iThreadsStarted++;
+  }
+
+  /* Without threads, the files are checked in this one */
+  if(iThreadsStarted == 0)
+  {
+    pvVerifyWorker(&stQueue);
+  }
+
+  for(ii = 0; ii < iThreadsStarted; ii++)
+  {
+    pthread_join(atThreads[ii], NULL);
+  }
+
+  pthread_mutex_destroy(&stQueue.stMutex);
+  free(stQueue.pastJobs);
+
+  printf(_("Checked %d files of %d projects: %d changed, %d missing\n"), stQueue.iJobsCount,
+         iProjectsCount - iInvalid, stQueue.iChanged, stQueue.iMissing);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return stQueue.iChanged == 0 && stQueue.iMissing == 0 && iInvalid == 0 ? 0 : -1;
+}
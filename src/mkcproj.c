@@ -29,8 +29,23 @@
 #include "cutils/color.h"
 #include "cmdline.h"
 #include "mkcproj.h"
-
+#include "tar.h"
+#include "profile.h"
+#include "store.h"
+#include "extract.h"
+#include "banner.h"
+#include "complete.h"
+#include "lock.h"
+#include "manifest.h"
+#include "rename.h"
+#include "module.h"
+#include "tree.h"
+#include "with.h"
+
+/* libmkcproj (make lib) has no command line */
+#ifndef MKCPROJ_LIBRARY
 int opterr = 0;
+#endif /* MKCPROJ_LIBRARY */
 
 char gszConfFileName[_MAX_PATH];
 char gszLogFileName[_MAX_PATH];
@@ -38,155 +53,258 @@ DebugLevel giDebugLevel = 0;
 bool gbColoredLogLevel = false;
 
 bool gbVerbose = false;
+bool gbUnityBuild = false;
+bool gbPrecompiledHeader = false;
+bool gbWatch = false;
+bool gbNonInteractive = false;
+bool gbMonorepo = false;
+bool gbBench = false;
 char gszTemplatePathDir[2048];
 char gszProjectsPathDir[2048];
 char gszFullNewProjectPathDir[2048+2048];
 char gszFullNewFileNamePath[2048+2048+2048];
+STRUCT_TEMPLATE_INDEX gstTemplateIndex;
+STRUCT_PROJECT_FILES gstProjectFiles;
+FILE *gfpOutputTar = NULL;
+PSTRUCT_OUTPUT_SINK gpstOutputSink = NULL;
+pthread_mutex_t gstProjectFilesMutex = PTHREAD_MUTEX_INITIALIZER;
+char gszLastError[1024];
+bool gbPrintErrors = true;
 
 const char *gkpszProgramName;
 STRUCT_COMMAND_LINE gstCmdLine;
 
 void vPrintErrorMessage(const char *kpszFmt, ...)
 {
+  static pthread_mutex_t stErrorMutex = PTHREAD_MUTEX_INITIALIZER;
   va_list args;
-  char szMsg[_MAX_PATH];
+  char szMsg[sizeof(gszLastError)];
   
   memset(szMsg, 0, sizeof(szMsg));
    
   va_start(args, kpszFmt);
-  
+  vsnprintf(szMsg, sizeof(szMsg), kpszFmt, args);
+  va_end(args);
+
+  /* The threads of the template tree can fail at the same time */
+  pthread_mutex_lock(&stErrorMutex);
+  snprintf(gszLastError, sizeof(gszLastError), "%s", szMsg);
+  pthread_mutex_unlock(&stErrorMutex);
+
+  if(!gbPrintErrors)
+  {
+    return;
+  }
+
   /**
    * Check if the terminal suport colors
    */
   if(bTerminalSupportColors() == false)
   {
-    snprintf(szMsg, sizeof(szMsg), _("E: %s\n"), kpszFmt);
-
-    vfprintf(stderr, szMsg, args);
+    fprintf(stderr, _("E: %s\n"), szMsg);
     return;
   }
   
-  snprintf(szMsg, sizeof(szMsg), _("\033[1;31mE:\033[m %s\n"), kpszFmt);
-  
-  vfprintf(stderr, szMsg, args);
+  fprintf(stderr, _("\033[1;31mE:\033[m %s\n"), szMsg);
+}
+
+void vPrintVerbose(const char *kpszFmt, ...)
+{
+  va_list args;
+
+  if(!gbVerbose)
+  {
+    return;
+  }
+
+  va_start(args, kpszFmt);
+
+  /* With --output-tar - the stdout is the archive */
+  vfprintf(gfpOutputTar == stdout ? stderr : stdout, kpszFmt, args);
 
   va_end(args);
 }
 
 int iInitMkcproj(void)
 {
-  snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s/Template/%s", HOME,
-                                                                             TEMPLATE_DIR);
-  snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s/%s", HOME,
-                                                                    PROJECTS_DIR);
+  iLoadProfile();
+
+  /* The messages about the template files show the path of the archive */
+  if(!bStrIsEmpty(gstCmdLine.szTemplateArchive))
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", gstCmdLine.szTemplateArchive);
+  }
+  else if(!bStrIsEmpty(gstCmdLine.szTemplateDir))
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", gstCmdLine.szTemplateDir);
+  }
+  else if(!bStrIsEmpty(gstProfile.szTemplateDir))
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", gstProfile.szTemplateDir);
+  }
+  else
+  {
+    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s/Template/%s", HOME,
+                                                                               TEMPLATE_DIR);
+  }
+
+  if(!bStrIsEmpty(gstProfile.szProjectsDir))
+  {
+    snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s", gstProfile.szProjectsDir);
+  }
+  else
+  {
+    snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s/%s", HOME,
+                                                                      PROJECTS_DIR);
+  }
+
   return 0;
 }
 
-int iGetProjInfo(void)
+int iGetUnityBatchSize(void)
+{
+  if(bStrIsEmpty(gstCmdLine.szUnityBatch))
+  {
+    return UNITY_BATCH_SIZE;
+  }
+
+  return atoi(gstCmdLine.szUnityBatch);
+}
+
+int iCompareStrings(const void *kpvFirst, const void *kpvSecond)
+{
+  return strcmp(*(const char **) kpvFirst, *(const char **) kpvSecond);
+}
+
+bool bAskRequiredField(const char *kpszPrompt, const char *kpszError, const char *kpszRetry,
+                       char *pszField, size_t lFieldSize)
 {
   char szAnswer[2048];
 
   memset(szAnswer, 0, sizeof(szAnswer));
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - begin"), __func__);
-  
+  /* Given in the command line or in the profile */
+  if(!bStrIsEmpty(pszField))
+  {
+    return true;
+  }
+
   do
   {
-    printf(_("Developer name: "));
+    printf("%s", kpszPrompt);
     vFgets(szAnswer, sizeof(szAnswer), stdin);
 
-    if(bStrIsEmpty(szAnswer))
+    /* Don't ask forever when the stdin is closed */
+    if(feof(stdin) || ferror(stdin))
     {
-      vPrintErrorMessage(_("You don't type a name!"));
-      puts(_("Please, type your name below"));
+      vPrintErrorMessage(_("%s"), kpszError);
 
-      memset(szAnswer, 0, sizeof(szAnswer));
+      return false;
     }
-  } while(bStrIsEmpty(szAnswer));
-  
-  strcpy(gstCmdLine.szDevName, szAnswer);
-
-  memset(szAnswer, 0, sizeof(szAnswer));
-
-  do
-  {
-    printf(_("Developer e-mail: "));
-    vFgets(szAnswer, sizeof(szAnswer), stdin);
 
     if(bStrIsEmpty(szAnswer))
     {
-      vPrintErrorMessage(_("You don't type your e-mail!"));
-      puts(_("Please, type your e-mail below"));
+      vPrintErrorMessage(_("%s"), kpszError);
+      puts(kpszRetry);
 
       memset(szAnswer, 0, sizeof(szAnswer));
     }
   } while(bStrIsEmpty(szAnswer));
-  
-  strcpy(gstCmdLine.szDevMail, szAnswer);
-  
+
+  snprintf(pszField, lFieldSize, "%s", szAnswer);
+
+  return true;
+}
+
+int iGetProjInfo(void)
+{
+  bool bAskDefaults = bStrIsEmpty(gstCmdLine.szProjName);
+  char szAnswer[2048];
+  char szTemplateAnswer[sizeof(gszTemplatePathDir)];
+
   memset(szAnswer, 0, sizeof(szAnswer));
+  memset(szTemplateAnswer, 0, sizeof(szTemplateAnswer));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
   
-  printf(_("Template directory (default %s): "), gszTemplatePathDir);
-  vFgets(szAnswer, sizeof(szAnswer), stdin);
-  
-  if(!bStrIsEmpty(szAnswer))
+  if(!bAskRequiredField(_("Developer name: "), _("You don't type a name!"),
+                        _("Please, type your name below"),
+                        gstCmdLine.szDevName, sizeof(gstCmdLine.szDevName)))
   {
-    snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", szAnswer);
-  }
-
-  memset(szAnswer, 0, sizeof(szAnswer));
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
 
-  printf(_("Projects directory (default %s): "), gszProjectsPathDir);
-  vFgets(szAnswer, sizeof(szAnswer), stdin);
+    return -1;
+  }
 
-  if(!bStrIsEmpty(szAnswer))
+  if(!bAskRequiredField(_("Developer e-mail: "), _("You don't type your e-mail!"),
+                        _("Please, type your e-mail below"),
+                        gstCmdLine.szDevMail, sizeof(gstCmdLine.szDevMail)))
   {
-    snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s", szAnswer);
-  }
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
 
-  do
+    return -1;
+  }
+  
+  /* The directories are asked only when nothing was given */
+  if(bAskDefaults && bStrIsEmpty(gstCmdLine.szTemplateDir) &&
+     bStrIsEmpty(gstCmdLine.szTemplateArchive) && bStrIsEmpty(gstProfile.szTemplateDir))
   {
-    printf(_("Project name: "));
+    printf(_("Template directory (default %s): "), gszTemplatePathDir);
     vFgets(szAnswer, sizeof(szAnswer), stdin);
-
-    if(bStrIsEmpty(szAnswer))
+    
+    if(!bStrIsEmpty(szAnswer))
     {
-      vPrintErrorMessage(_("You don't type the name of your project!"));
-      puts(_("Please, type the name of the project below"));
-
-      memset(szAnswer, 0, sizeof(szAnswer));
+      snprintf(gszTemplatePathDir, sizeof(gszTemplatePathDir), "%s", szAnswer);
+      snprintf(szTemplateAnswer, sizeof(szTemplateAnswer), "%s", szAnswer);
     }
-  } while(bStrIsEmpty(szAnswer));
-  
-  strcpy(gstCmdLine.szProjName, szAnswer);
 
-  memset(szAnswer, 0, sizeof(szAnswer));
+    memset(szAnswer, 0, sizeof(szAnswer));
+  }
 
-  do
+  if(bAskDefaults && bStrIsEmpty(gstProfile.szProjectsDir))
   {
-    printf(_("Description: "));
+    printf(_("Projects directory (default %s): "), gszProjectsPathDir);
     vFgets(szAnswer, sizeof(szAnswer), stdin);
 
-    if(bStrIsEmpty(szAnswer))
+    if(!bStrIsEmpty(szAnswer))
     {
-      vPrintErrorMessage(_("You don't type the description of your software!"));
-      puts(_("Please, type the description below"));
-      
-      memset(szAnswer, 0, sizeof(szAnswer));
+      snprintf(gszProjectsPathDir, sizeof(gszProjectsPathDir), "%s", szAnswer);
     }
-  } while(bStrIsEmpty(szAnswer));
 
-  strcpy(gstCmdLine.szProjDescription, szAnswer);
+    memset(szAnswer, 0, sizeof(szAnswer));
+  }
 
-  memset(szAnswer, 0, sizeof(szAnswer));
+  if(!bAskRequiredField(_("Project name: "), _("You don't type the name of your project!"),
+                        _("Please, type the name of the project below"),
+                        gstCmdLine.szProjName, sizeof(gstCmdLine.szProjName)))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(!bAskRequiredField(_("Description: "), _("You don't type the description of your software!"),
+                        _("Please, type the description below"),
+                        gstCmdLine.szProjDescription, sizeof(gstCmdLine.szProjDescription)))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(bStrIsEmpty(gstCmdLine.szLicense))
+  {
+    printf(_("License (Default is GPLv2): "));
+    vFgets(szAnswer, sizeof(szAnswer), stdin);
 
-  printf(_("License (Default is GPLv2): "));
-  vFgets(szAnswer, sizeof(szAnswer), stdin);
+    snprintf(gstCmdLine.szLicense, sizeof(gstCmdLine.szLicense), "%.*s", (int) sizeof(gstCmdLine.szLicense) - 1,
+                                                                 bStrIsEmpty(szAnswer) ? "GPLv2" : szAnswer);
+  }
 
-  bStrIsEmpty(szAnswer) ? strcpy(gstCmdLine.szLicense, "GPLv2") : 
-                          strcpy(gstCmdLine.szLicense, szAnswer);
+  /* The next projects don't ask the same questions again */
+  iSaveProfile(szTemplateAnswer);
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - end"), __func__);
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
 
   return 0;
 }
@@ -253,6 +371,36 @@ int iGetTemplateFileName(uint64_t ui64Flag, char *pszTemplateFileName)
     sprintf(pszTemplateFileName, "mkstrip");
   }
 
+  if(ui64Flag & MKPGO_FILE)
+  {
+    sprintf(pszTemplateFileName, "mkpgo");
+  }
+
+  if(ui64Flag & MKPROF_FILE)
+  {
+    sprintf(pszTemplateFileName, "mkprof");
+  }
+
+  if(ui64Flag & BENCH_HEADER_FILE)
+  {
+    sprintf(pszTemplateFileName, "bench.h");
+  }
+
+  if(ui64Flag & BENCH_FILE)
+  {
+    sprintf(pszTemplateFileName, "bench.c");
+  }
+
+  if(ui64Flag & BENCH_PROJECT_FILE)
+  {
+    sprintf(pszTemplateFileName, "bench_template.c");
+  }
+
+  if(ui64Flag & MKBENCH_FILE)
+  {
+    sprintf(pszTemplateFileName, "mkbench");
+  }
+
   if(ui64Flag & INSTALL_FILE)
   {
     sprintf(pszTemplateFileName, "INSTALL");
@@ -383,6 +531,36 @@ int iGetFullTemplateFileNamePath(uint64_t ui64Flag, char *pszFullTemplateFileNam
     sprintf(pszFullTemplateFileNamePath, "%s/mkstrip", gszTemplatePathDir);
   }
 
+  if(ui64Flag & MKPGO_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/mkpgo", gszTemplatePathDir);
+  }
+
+  if(ui64Flag & MKPROF_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/mkprof", gszTemplatePathDir);
+  }
+
+  if(ui64Flag & BENCH_HEADER_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/bench/bench.h", gszTemplatePathDir);
+  }
+
+  if(ui64Flag & BENCH_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/bench/bench.c", gszTemplatePathDir);
+  }
+
+  if(ui64Flag & BENCH_PROJECT_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/bench/bench_template.c", gszTemplatePathDir);
+  }
+
+  if(ui64Flag & MKBENCH_FILE)
+  {
+    sprintf(pszFullTemplateFileNamePath, "%s/mkbench", gszTemplatePathDir);
+  }
+
   if(ui64Flag & INSTALL_FILE)
   {
     sprintf(pszFullTemplateFileNamePath, "%s/INSTALL", gszTemplatePathDir);
@@ -513,6 +691,36 @@ int iGetNewFileName(uint64_t ui64Flag, char *pszNewFileName)
     sprintf(pszNewFileName, "mkstrip");
   }
 
+  if(ui64Flag & MKPGO_FILE)
+  {
+    sprintf(pszNewFileName, "mkpgo");
+  }
+
+  if(ui64Flag & MKPROF_FILE)
+  {
+    sprintf(pszNewFileName, "mkprof");
+  }
+
+  if(ui64Flag & BENCH_HEADER_FILE)
+  {
+    sprintf(pszNewFileName, "bench.h");
+  }
+
+  if(ui64Flag & BENCH_FILE)
+  {
+    sprintf(pszNewFileName, "bench.c");
+  }
+
+  if(ui64Flag & BENCH_PROJECT_FILE)
+  {
+    sprintf(pszNewFileName, "bench_%s.c", gstCmdLine.szProjName);
+  }
+
+  if(ui64Flag & MKBENCH_FILE)
+  {
+    sprintf(pszNewFileName, "mkbench");
+  }
+
   if(ui64Flag & INSTALL_FILE)
   {
     sprintf(pszNewFileName, "INSTALL");
@@ -645,6 +853,36 @@ int iGetFullNewFileNamePath(uint64_t ui64Flag)
     sprintf(gszFullNewFileNamePath, "%s/mkstrip", gszFullNewProjectPathDir);
   }
 
+  if(ui64Flag & MKPGO_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/mkpgo", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & MKPROF_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/mkprof", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & BENCH_HEADER_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/bench/bench.h", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & BENCH_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/bench/bench.c", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & BENCH_PROJECT_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/bench/bench_%s.c", gszFullNewProjectPathDir, gstCmdLine.szProjName);
+  }
+
+  if(ui64Flag & MKBENCH_FILE)
+  {
+    sprintf(gszFullNewFileNamePath, "%s/mkbench", gszFullNewProjectPathDir);
+  }
+
   if(ui64Flag & INSTALL_FILE)
   {
     sprintf(gszFullNewFileNamePath, "%s/INSTALL", gszFullNewProjectPathDir);
@@ -716,229 +954,1810 @@ int iGetFullNewFileNamePath(uint64_t ui64Flag)
   return 0;
 }
 
-/**
- * TODO: Implement it.
- */
-int iCreateFile(uint64_t ui64Flag)
+int iIndexTemplateDir(const char *kpszRelativeDir)
 {
-  FILE *fpFile = NULL;
-  uint64_t u64FileType = 0;
-  bool bFileType = false;
-  char szTemplateFileName[_MAX_PATH];
-  char szNewFileName[_MAX_PATH];
-  char szFullTemplateFileNamePath[_MAX_PATH];
-  
-  UNUSED(fpFile);
-  UNUSED(u64FileType);
-  UNUSED(bFileType);
-
-  memset(szNewFileName, 0, sizeof(szNewFileName));
-
-  if(INFO_DETAILS) vTraceInfo(_("%s - begin"), __func__);
-  
-  iGetTemplateFileName(ui64Flag, szTemplateFileName);
-  puts(szTemplateFileName);
-
-  iGetFullTemplateFileNamePath(ui64Flag, szFullTemplateFileNamePath);
-  puts(szFullTemplateFileNamePath);
-
-  iGetNewFileName(ui64Flag, szNewFileName);
-  puts(szNewFileName);
-  
-  iGetFullNewFileNamePath(ui64Flag);
-  puts(gszFullNewFileNamePath);
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stFileStat;
+  PSTRUCT_TEMPLATE_FILE pastTmp = NULL;
+  PSTRUCT_TEMPLATE_FILE pstFile = NULL;
+  int iRsl = 0;
+  char szDirPath[sizeof(gszTemplatePathDir) + _MAX_PATH + 2];
+  char szRelativePath[_MAX_PATH];
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - end"), __func__);
-  
-  return 0;
-}
+  memset(szDirPath, 0, sizeof(szDirPath));
+  memset(szRelativePath, 0, sizeof(szRelativePath));
 
-/**
- * TODO: Implement it.
- */
-int iCreateDirectories(uint64_t ui64Flag)
-{
-  bool bDirType = false;
-  uint64_t u64DirType = 0;
-  
-  UNUSED(u64DirType);
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - begin"), __func__);
-  
-  if(ui64Flag & PROJ_DIR)
+  if(bStrIsEmpty(kpszRelativeDir))
   {
-    puts("PROJECTS_DIR");
+    snprintf(szDirPath, sizeof(szDirPath), "%s", gszTemplatePathDir);
   }
-
-  if(ui64Flag & SRC_DIR)
+  else
   {
-    puts("SRC_DIR");
+    snprintf(szDirPath, sizeof(szDirPath), "%s/%s", gszTemplatePathDir, kpszRelativeDir);
   }
 
-  if(ui64Flag & INC_DIR)
+  if((pDir = opendir(szDirPath)) == NULL)
   {
-    puts("INC_DIR");
-  }
+    vPrintErrorMessage(_("Impossible open the directory %s: %s"), szDirPath, strerror(errno));
 
-  if(ui64Flag & DOC_DIR)
-  {
-    puts("DOC_DIR");
-  }
-  
-  if(ui64Flag & MAN_DIR)
-  {
-    puts("MAN_DIR");
-  }
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the directory %s: %s"), szDirPath, strerror(errno));
 
-  if(ui64Flag & LIB_DIR)
-  {
-    puts("LIB_DIR");
-  }
-  
-  if(bDirType == false)
-  {
-    if(INFO_DETAILS) vTraceInfo(_("Invalid directory type!"));
-    
-    return false;
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
   }
-  
-  if(INFO_DETAILS) vTraceInfo(_("%s - end"), __func__);
-  
-  return 0;
-}
 
-/**
- * NOTE: This is a prototype
- * TODO: Concat the PATH of file.
- */
-bool bCreateHeaderComment(uint64_t ui64Flag)
-{
-  PSTRUCT_DATE pstDate = (PSTRUCT_DATE) malloc(sizeof(STRUCT_DATE));
-  FILE *fpFile = NULL;
-  bool bFileType = false;
-  uint64_t u64FileType = 0;
-  char szFileName[_MAX_PATH];
+  while(iRsl == 0 && (pstEntry = readdir(pDir)) != NULL)
+  {
+    /* ".", ".." and the version control directories (.git, ...) */
+    if(pstEntry->d_name[0] == '.')
+    {
+      continue;
+    }
 
-  memset(szFileName, 0, sizeof(szFileName));
+    if(snprintf(szRelativePath, sizeof(szRelativePath), "%s%s%s", kpszRelativeDir,
+                bStrIsEmpty(kpszRelativeDir) ? "" : "/", pstEntry->d_name) >= (int) sizeof(szRelativePath))
+    {
+      if(WARNING_DETAILS) vTraceWarning(_("Path too long: %s/%s"), szDirPath, pstEntry->d_name);
+      continue;
+    }
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - begin"), __func__);
+    /* d_type saves the stat of the directories */
+    if(pstEntry->d_type == DT_DIR)
+    {
+      iRsl = iIndexTemplateDir(szRelativePath);
+      continue;
+    }
 
-  if(ui64Flag & HEADER_FILE)
-  {
-    u64FileType = HEADER_FILE;
-    strcat(szFileName, gstCmdLine.szProjName);
-    strcat(szFileName, ".h");
-  }
+    if(fstatat(dirfd(pDir), pstEntry->d_name, &stFileStat, 0) != 0)
+    {
+      if(WARNING_DETAILS) vTraceWarning(_("Impossible stat the file %s/%s"), szDirPath, pstEntry->d_name);
+      continue;
+    }
 
-  if(ui64Flag & SOURCE_FILE)
+    /* File systems that don't fill d_type */
+    if(S_ISDIR(stFileStat.st_mode))
+    {
+      iRsl = iIndexTemplateDir(szRelativePath);
+      continue;
+    }
+
+    if(!S_ISREG(stFileStat.st_mode))
+    {
+      continue;
+    }
+
+    if(gstTemplateIndex.iFilesCount == gstTemplateIndex.iFilesAlloc)
+    {
+      gstTemplateIndex.iFilesAlloc = gstTemplateIndex.iFilesAlloc == 0 ? 64 : gstTemplateIndex.iFilesAlloc * 2;
+
+      if((pastTmp = (PSTRUCT_TEMPLATE_FILE) realloc(gstTemplateIndex.pastFiles,
+                                                     gstTemplateIndex.iFilesAlloc * sizeof(STRUCT_TEMPLATE_FILE))) == NULL)
+      {
+        vPrintErrorMessage(_("Impossible allocate memory to the template index"));
+
+        iRsl = -1;
+        break;
+      }
+
+      gstTemplateIndex.pastFiles = pastTmp;
+    }
+
+    pstFile = &gstTemplateIndex.pastFiles[gstTemplateIndex.iFilesCount++];
+
+    snprintf(pstFile->szRelativePath, sizeof(pstFile->szRelativePath), "%s", szRelativePath);
+    pstFile->lSize = stFileStat.st_size;
+    pstFile->iMode = stFileStat.st_mode;
+    pstFile->pszContent = NULL;
+
+    if(DEBUG_DETAILS) vTraceAll("%s %o %ld", pstFile->szRelativePath, pstFile->iMode & 0777, (long) pstFile->lSize);
+  }
+
+  closedir(pDir);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iIndexTemplate(void)
+{
+  int iRsl = 0;
+
+  vFreeTemplateIndex();
+
+  if(!bStrIsEmpty(gstCmdLine.szTemplateArchive))
+  {
+    iRsl = iIndexTemplateArchive(gstCmdLine.szTemplateArchive);
+  }
+  else
+  {
+    iRsl = iIndexTemplateDir("");
+  }
+
+  vSortTemplateIndex();
+
+  return iRsl;
+}
+
+int iCompareTemplateFiles(const void *kpvFirst, const void *kpvSecond)
+{
+  return strcmp(((const STRUCT_TEMPLATE_FILE *) kpvFirst)->szRelativePath,
+                ((const STRUCT_TEMPLATE_FILE *) kpvSecond)->szRelativePath);
+}
+
+void vSortTemplateIndex(void)
+{
+  if(gstTemplateIndex.iFilesCount > 0)
+  {
+    qsort(gstTemplateIndex.pastFiles, gstTemplateIndex.iFilesCount,
+          sizeof(STRUCT_TEMPLATE_FILE), iCompareTemplateFiles);
+  }
+}
+
+void vFreeTemplateIndex(void)
+{
+  int ii;
+
+  for(ii = 0; ii < gstTemplateIndex.iFilesCount; ii++)
+  {
+    free(gstTemplateIndex.pastFiles[ii].pszContent);
+  }
+
+  free(gstTemplateIndex.pastFiles);
+
+  memset(&gstTemplateIndex, 0, sizeof(gstTemplateIndex));
+}
+
+PSTRUCT_TEMPLATE_FILE pstGetTemplateFile(uint64_t ui64Flag)
+{
+  STRUCT_TEMPLATE_FILE stKey;
+  char szFullTemplateFileNamePath[sizeof(gszTemplatePathDir) + _MAX_PATH];
+  size_t lTemplatePathLen = strlen(gszTemplatePathDir);
+
+  memset(&stKey, 0, sizeof(stKey));
+  memset(szFullTemplateFileNamePath, 0, sizeof(szFullTemplateFileNamePath));
+
+  if(gstTemplateIndex.iFilesCount == 0)
+  {
+    return NULL;
+  }
+
+  iGetFullTemplateFileNamePath(ui64Flag, szFullTemplateFileNamePath);
+
+  /* Skip "gszTemplatePathDir/" */
+  snprintf(stKey.szRelativePath, sizeof(stKey.szRelativePath), "%s",
+           szFullTemplateFileNamePath + lTemplatePathLen + 1);
+
+  return (PSTRUCT_TEMPLATE_FILE) bsearch(&stKey, gstTemplateIndex.pastFiles,
+                                         gstTemplateIndex.iFilesCount,
+                                         sizeof(STRUCT_TEMPLATE_FILE),
+                                         iCompareTemplateFiles);
+}
+
+bool bRequiredTemplateFilesExist(void)
+{
+  uint64_t ui64Flag;
+  bool bExist = true;
+  char szFullTemplateFileNamePath[sizeof(gszTemplatePathDir) + _MAX_PATH];
+
+  memset(szFullTemplateFileNamePath, 0, sizeof(szFullTemplateFileNamePath));
+
+  for(ui64Flag = 1; ui64Flag != 0 && ui64Flag <= REQUIRED_FILES; ui64Flag <<= 1)
+  {
+    if(!(ui64Flag & REQUIRED_FILES) || pstGetTemplateFile(ui64Flag) != NULL)
+    {
+      continue;
+    }
+
+    iGetFullTemplateFileNamePath(ui64Flag, szFullTemplateFileNamePath);
+
+    vPrintErrorMessage(_("The template file %s doesn't exist"), szFullTemplateFileNamePath);
+
+    if(DEBUG_DETAILS) vTraceFatal(_("The template file %s doesn't exist"), szFullTemplateFileNamePath);
+
+    bExist = false;
+  }
+
+  return bExist;
+}
+
+void vReplaceTemplateName(FILE *fpNewFile, const char *kpszLine)
+{
+  const char *kpszLower = NULL;
+  const char *kpszUpper = NULL;
+  char szUpperProjName[_MAX_PATH];
+  int ii;
+
+  memset(szUpperProjName, 0, sizeof(szUpperProjName));
+
+  for(ii = 0; gstCmdLine.szProjName[ii] != '\0' && ii < (int) sizeof(szUpperProjName) - 1; ii++)
+  {
+    szUpperProjName[ii] = toupper((unsigned char) gstCmdLine.szProjName[ii]);
+  }
+
+  while(*kpszLine != '\0')
+  {
+    kpszLower = strstr(kpszLine, "template");
+    kpszUpper = strstr(kpszLine, "TEMPLATE");
+
+    if(kpszLower == NULL && kpszUpper == NULL)
+    {
+      fputs(kpszLine, fpNewFile);
+      return;
+    }
+
+    /* Replace the first occurrence, "template" or "TEMPLATE" */
+    if(kpszLower != NULL && (kpszUpper == NULL || kpszLower < kpszUpper))
+    {
+      fwrite(kpszLine, 1, kpszLower - kpszLine, fpNewFile);
+      fputs(gstCmdLine.szProjName, fpNewFile);
+      kpszLine = kpszLower + strlen("template");
+    }
+    else
+    {
+      fwrite(kpszLine, 1, kpszUpper - kpszLine, fpNewFile);
+      fputs(szUpperProjName, fpNewFile);
+      kpszLine = kpszUpper + strlen("TEMPLATE");
+    }
+  }
+}
+
+int iCreateFile(uint64_t ui64Flag)
+{
+  FILE *fpTemplate = NULL;
+  STRUCT_NEW_FILE stNewFile;
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile = NULL;
+  ENUM_COMMENT_STYLE eStyle = eGetCommentStyle(ui64Flag);
+  char szFullTemplateFileNamePath[sizeof(gszTemplatePathDir) + _MAX_PATH];
+  char szLine[4096];
+
+  memset(&stNewFile, 0, sizeof(stNewFile));
+  memset(szFullTemplateFileNamePath, 0, sizeof(szFullTemplateFileNamePath));
+  memset(szLine, 0, sizeof(szLine));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* Optional files missing in the template directory are skipped */
+  if((pstTemplateFile = pstGetTemplateFile(ui64Flag)) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (template file not found)"), __func__);
+
+    return (ui64Flag & REQUIRED_FILES) ? -1 : 0;
+  }
+  
+  iGetFullTemplateFileNamePath(ui64Flag, szFullTemplateFileNamePath);
+  iGetFullNewFileNamePath(ui64Flag);
+
+  if(DEBUG_DETAILS) vTraceAll("%s -> %s", szFullTemplateFileNamePath, gszFullNewFileNamePath);
+
+  if((fpTemplate = fpOpenTemplateFile(pstTemplateFile, szFullTemplateFileNamePath)) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(!bOpenNewFile(&stNewFile, gszFullNewFileNamePath, ui64Flag))
+  {
+    bCloseFile(&fpTemplate);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* The header comment of the template is replaced, the scripts keep your "#!" line first */
+  if(eStyle != COMMENT_STYLE_NONE && (ui64Flag & BANNER_REPLACE_FILES))
+  {
+    bCreateHeaderComment(stNewFile.fpFile, ui64Flag);
+    vSkipTemplateHeaderComment(fpTemplate);
+  }
+  else if(eStyle != COMMENT_STYLE_NONE)
+  {
+    vCopyTemplateShebang(fpTemplate, stNewFile.fpFile);
+    bCreateHeaderComment(stNewFile.fpFile, ui64Flag);
+    vSkipTemplateBanner(fpTemplate, eStyle);
+  }
+
+  while(fgets(szLine, sizeof(szLine), fpTemplate) != NULL)
+  {
+    /* Keep the batch size of the unity build chosen in the command line */
+    if((ui64Flag & MAKEFILE_FILE) && gbUnityBuild && strncmp(szLine, "UNITY_BATCH ", 12) == 0)
+    {
+      fprintf(stNewFile.fpFile, "UNITY_BATCH  = %d\n", iGetUnityBatchSize());
+      continue;
+    }
+
+    vReplaceTemplateName(stNewFile.fpFile, szLine);
+  }
+
+  bCloseFile(&fpTemplate);
+
+  /* The scripts of template (mk, install.sh, ...) must keep your permissions */
+  if(!bCloseNewFile(&stNewFile, pstTemplateFile->iMode))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+  
+  return 0;
+}
+
+bool bLoadTemplateFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile, const char *kpszFullTemplateFileNamePath)
+{
+  struct stat stFileStat;
+  char *pszContent = NULL;
+  ssize_t lRead = 0;
+  size_t lOffset = 0;
+  int iFd = -1;
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+
+  if((iFd = open(kpszFullTemplateFileNamePath, O_RDONLY | O_CLOEXEC)) < 0 || fstat(iFd, &stFileStat) != 0 ||
+     (pszContent = (char *) malloc(stFileStat.st_size + 1)) == NULL)
+  {
+    if(iFd >= 0)
+    {
+      close(iFd);
+    }
+
+    return false;
+  }
+
+  /* A regular file is read by a single read(), the loop is for the signals */
+  while(lOffset < (size_t) stFileStat.st_size &&
+        ((lRead = read(iFd, pszContent + lOffset, stFileStat.st_size - lOffset)) > 0 ||
+         (lRead < 0 && errno == EINTR)))
+  {
+    lOffset += lRead > 0 ? (size_t) lRead : 0;
+  }
+
+  close(iFd);
+
+  if(lRead < 0)
+  {
+    free(pszContent);
+
+    return false;
+  }
+
+  pszContent[lOffset] = '\0';
+
+  pstTemplateFile->pszContent = pszContent;
+  pstTemplateFile->lSize = lOffset;
+
+  return true;
+}
+
+FILE *fpOpenTemplateFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile, const char *kpszFullTemplateFileNamePath)
+{
+  FILE *fpTemplate = NULL;
+
+  /**
+   * The templates of an archive are already in the memory, the ones
+   * of a directory are loaded once and freed with the index
+   */
+  if(pstTemplateFile->pszContent == NULL && pstTemplateFile->lSize > 0)
+  {
+    bLoadTemplateFile(pstTemplateFile, kpszFullTemplateFileNamePath);
+  }
+
+  if(pstTemplateFile->pszContent != NULL && pstTemplateFile->lSize > 0)
+  {
+    fpTemplate = fmemopen(pstTemplateFile->pszContent, pstTemplateFile->lSize, "r");
+  }
+  else
+  {
+    bOpenFile(&fpTemplate, kpszFullTemplateFileNamePath, "r");
+  }
+
+  if(fpTemplate == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s"), kpszFullTemplateFileNamePath);
+    
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the file %s"), kpszFullTemplateFileNamePath);
+  }
+
+  return fpTemplate;
+}
+
+bool bOpenNewFile(PSTRUCT_NEW_FILE pstNewFile, const char *kpszPath, uint64_t ui64Flag)
+{
+  memset(pstNewFile, 0, sizeof(STRUCT_NEW_FILE));
+
+  snprintf(pstNewFile->szPath, sizeof(pstNewFile->szPath), "%s", kpszPath);
+
+  /**
+   * The file is written in a temporary file renamed at the end,
+   * so who is reading the project never sees a partial file
+   */
+  snprintf(pstNewFile->szTmpPath, sizeof(pstNewFile->szTmpPath), "%s%s", kpszPath, TMP_FILE_SUFFIX);
+
+  pstNewFile->ui64Flag = ui64Flag;
+
+  /**
+   * --output-tar and --dedup: the file is kept in the memory until
+   * be written in the archive or be found in the store. --manifest:
+   * the hash is calculated in the memory, without read the file again.
+   */
+  pstNewFile->bDedup = gbDedupStore && ((ui64Flag & DEDUP_FILES) || bIsStoreTreeFile(kpszPath));
+  pstNewFile->bInMemory = gpstOutputSink != NULL || gbManifest || pstNewFile->bDedup;
+
+  if(pstNewFile->bInMemory)
+  {
+    pstNewFile->fpFile = open_memstream(&pstNewFile->pszBuffer, &pstNewFile->lBufferSize);
+  }
+  else
+  {
+    bOpenFile(&pstNewFile->fpFile, pstNewFile->szTmpPath, "w");
+  }
+
+  if(pstNewFile->fpFile == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s"), kpszPath);
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the file %s"), kpszPath);
+
+    return false;
+  }
+
+  return true;
+}
+
+bool bCloseNewFile(PSTRUCT_NEW_FILE pstNewFile, mode_t iMode)
+{
+  FILE *fpFile = NULL;
+  uint64_t ui64Hash = 0;
+  bool bClosed = true;
+
+  if(pstNewFile->bInMemory)
+  {
+    bClosed = fclose(pstNewFile->fpFile) == 0;
+    pstNewFile->fpFile = NULL;
+
+    if(bClosed && gbManifest)
+    {
+      ui64Hash = ui64HashXxh64(pstNewFile->pszBuffer, pstNewFile->lBufferSize, 0);
+    }
+
+    if(bClosed && gpstOutputSink != NULL)
+    {
+      pthread_mutex_lock(&gstProjectFilesMutex);
+
+      bClosed = gpstOutputSink->pbWriteFile(gpstOutputSink->pvData, pszGetTarPath(pstNewFile->szPath), iMode,
+                                            pstNewFile->pszBuffer, pstNewFile->lBufferSize);
+
+      pthread_mutex_unlock(&gstProjectFilesMutex);
+    }
+    else if(bClosed && !(pstNewFile->bDedup &&
+                         bLinkStoreFile(pstNewFile->szPath, pstNewFile->szTmpPath, pstNewFile->ui64Flag,
+                                        pstNewFile->pszBuffer, pstNewFile->lBufferSize, iMode)))
+    {
+      /* Without the store, the file is written as usual */
+      bClosed = bOpenFile(&fpFile, pstNewFile->szTmpPath, "w") &&
+                fwrite(pstNewFile->pszBuffer, 1, pstNewFile->lBufferSize, fpFile) == pstNewFile->lBufferSize;
+
+      if(fpFile != NULL)
+      {
+        fchmod(fileno(fpFile), iMode & 0777);
+
+        bClosed = bCloseFile(&fpFile) && bClosed;
+      }
+
+      bClosed = bClosed && rename(pstNewFile->szTmpPath, pstNewFile->szPath) == 0;
+
+      if(!bClosed)
+      {
+        unlink(pstNewFile->szTmpPath);
+      }
+    }
+
+    free(pstNewFile->pszBuffer);
+    pstNewFile->pszBuffer = NULL;
+  }
+  else
+  {
+    fchmod(fileno(pstNewFile->fpFile), iMode & 0777);
+
+    bClosed = bCloseFile(&pstNewFile->fpFile) &&
+              rename(pstNewFile->szTmpPath, pstNewFile->szPath) == 0;
+
+    if(!bClosed)
+    {
+      unlink(pstNewFile->szTmpPath);
+    }
+  }
+
+  if(!bClosed)
+  {
+    vPrintErrorMessage(_("Impossible write the file %s: %s"), pstNewFile->szPath, strerror(errno));
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible write the file %s: %s"), pstNewFile->szPath, strerror(errno));
+
+    return false;
+  }
+
+  vPrintVerbose(_("Created file %s\n"), pstNewFile->szPath);
+
+  pthread_mutex_lock(&gstProjectFilesMutex);
+
+  if(!bAddProjectFile(pstNewFile->szPath, iMode))
+  {
+    pthread_mutex_unlock(&gstProjectFilesMutex);
+
+    return false;
+  }
+
+  gstProjectFiles.pastFiles[gstProjectFiles.iFilesCount - 1].bHashed = pstNewFile->bInMemory && gbManifest;
+  gstProjectFiles.pastFiles[gstProjectFiles.iFilesCount - 1].ui64Hash = ui64Hash;
+
+  pthread_mutex_unlock(&gstProjectFilesMutex);
+
+  return true;
+}
+
+bool bAddProjectFile(const char *kpszPath, mode_t iMode)
+{
+  PSTRUCT_PROJECT_FILE pastTmp = NULL;
+  PSTRUCT_PROJECT_FILE pstFile = NULL;
+  size_t lProjectPathLen = strlen(gszFullNewProjectPathDir);
+
+  if(gstProjectFiles.iFilesCount == gstProjectFiles.iFilesAlloc)
+  {
+    gstProjectFiles.iFilesAlloc = gstProjectFiles.iFilesAlloc == 0 ? 64 : gstProjectFiles.iFilesAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_PROJECT_FILE) realloc(gstProjectFiles.pastFiles,
+                                                  gstProjectFiles.iFilesAlloc * sizeof(STRUCT_PROJECT_FILE))) == NULL)
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the list of files of the project"));
+
+      return false;
+    }
+
+    gstProjectFiles.pastFiles = pastTmp;
+  }
+
+  pstFile = &gstProjectFiles.pastFiles[gstProjectFiles.iFilesCount++];
+
+  memset(pstFile, 0, sizeof(STRUCT_PROJECT_FILE));
+
+  /* Relative to gszFullNewProjectPathDir */
+  if(strncmp(kpszPath, gszFullNewProjectPathDir, lProjectPathLen) == 0 && kpszPath[lProjectPathLen] == '/')
+  {
+    kpszPath += lProjectPathLen + 1;
+  }
+
+  snprintf(pstFile->szRelativePath, sizeof(pstFile->szRelativePath), "%s", kpszPath);
+  pstFile->iMode = iMode;
+
+  return true;
+}
+
+const char *pszGetTarPath(const char *kpszPath)
+{
+  size_t lProjectsPathLen = strlen(gszProjectsPathDir);
+
+  /* MyProj/src/MyProj.c */
+  if(strncmp(kpszPath, gszProjectsPathDir, lProjectsPathLen) == 0 && kpszPath[lProjectsPathLen] == '/')
+  {
+    return kpszPath + lProjectsPathLen + 1;
+  }
+
+  while(*kpszPath == '/')
+  {
+    kpszPath++;
+  }
+
+  return kpszPath;
+}
+
+int iCreateDirectories(uint64_t ui64Flag)
+{
+  bool bDirType = false;
+  char szDirPath[sizeof(gszFullNewProjectPathDir) + 16];
+  
+  memset(szDirPath, 0, sizeof(szDirPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+  
+  if(ui64Flag & PROJ_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & SRC_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/src", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & INC_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/include", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & DOC_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/doc", gszFullNewProjectPathDir);
+  }
+  
+  if(ui64Flag & MAN_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/man", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & LIB_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/lib", gszFullNewProjectPathDir);
+  }
+
+  if(ui64Flag & BENCH_DIR)
+  {
+    bDirType = true;
+    snprintf(szDirPath, sizeof(szDirPath), "%s/bench", gszFullNewProjectPathDir);
+  }
+  
+  if(bDirType == false)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("Invalid directory type!"));
+    
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(gpstOutputSink != NULL)
+  {
+    if(!gpstOutputSink->pbWriteDir(gpstOutputSink->pvData, pszGetTarPath(szDirPath), 0755))
+    {
+      vPrintErrorMessage(_("Impossible write the directory %s"), szDirPath);
+
+      if(DEBUG_DETAILS) vTraceFatal(_("Impossible write the directory %s"), szDirPath);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+  }
+  else if(mkdir(szDirPath, 0755) != 0 && errno != EEXIST)
+  {
+    vPrintErrorMessage(_("Impossible create the directory %s: %s"), szDirPath, strerror(errno));
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible create the directory %s: %s"), szDirPath, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  vPrintVerbose(_("Created directory %s\n"), szDirPath);
+  
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+  
+  return 0;
+}
+
+bool bCreateHeaderComment(FILE *fpFile, uint64_t ui64Flag)
+{
+  ENUM_COMMENT_STYLE eStyle = eGetCommentStyle(ui64Flag);
+  char szNewFileName[sizeof(gstCmdLine.szProjName) + 16];
+  char szFileName[sizeof(szNewFileName) + sizeof(gstCmdLine.szProjName) + 8];
+
+  memset(szFileName, 0, sizeof(szFileName));
+  memset(szNewFileName, 0, sizeof(szNewFileName));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(eStyle == COMMENT_STYLE_NONE || iGetNewFileName(ui64Flag, szNewFileName) != 0)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("Invalid file type!"));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("Create Header Comment"));
+
+  /* The Makefile says of what project it is */
+  if(ui64Flag & MAKEFILE_FILE)
+  {
+    snprintf(szFileName, sizeof(szFileName), "%s for %s", szNewFileName, gstCmdLine.szProjName);
+  }
+  else
+  {
+    snprintf(szFileName, sizeof(szFileName), "%s", szNewFileName);
+  }
+
+  if(!bWriteBanner(fpFile, eStyle, szFileName))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+void vSkipTemplateHeaderComment(FILE *fpTemplate)
+{
+  char szLine[4096];
+  long lLinePos = 0;
+
+  memset(szLine, 0, sizeof(szLine));
+
+  lLinePos = ftell(fpTemplate);
+
+  if(fgets(szLine, sizeof(szLine), fpTemplate) == NULL)
+  {
+    return;
+  }
+
+  /* .c and .h files: skip until the end of the comment block */
+  if(strncmp(szLine, "/*", 2) == 0)
+  {
+    while(strstr(szLine, "*/") == NULL)
+    {
+      if(fgets(szLine, sizeof(szLine), fpTemplate) == NULL)
+      {
+        return;
+      }
+    }
+
+    return;
+  }
+
+  /* Makefile: skip the first lines beginning with '#' */
+  while(szLine[0] == '#')
+  {
+    lLinePos = ftell(fpTemplate);
+
+    if(fgets(szLine, sizeof(szLine), fpTemplate) == NULL)
+    {
+      return;
+    }
+  }
+
+  fseek(fpTemplate, lLinePos, SEEK_SET);
+}
+
+int iCreateUnityFiles(void)
+{
+  STRUCT_NEW_FILE stUnity;
+  const char *kpszSource = NULL;
+  const char **ppszSources = NULL;
+  int iSourcesCount = 0;
+  int iBatchSize = iGetUnityBatchSize();
+  int iUnityCount = 0;
+  int iRsl = 0;
+  int ii;
+  size_t lNameLen = 0;
+  char szUnityPath[sizeof(gszFullNewProjectPathDir) + 64];
+
+  memset(&stUnity, 0, sizeof(stUnity));
+  memset(szUnityPath, 0, sizeof(szUnityPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if((ppszSources = (const char **) calloc(gstProjectFiles.iFilesCount + 1, sizeof(char *))) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the unity build files"));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /**
+   * Every .c file created in src, except the unity files themselves.
+   * The list of created files is used instead of read the directory,
+   * so it works with --output-tar too
+   */
+  for(ii = 0; ii < gstProjectFiles.iFilesCount; ii++)
+  {
+    if(strncmp(gstProjectFiles.pastFiles[ii].szRelativePath, "src/", 4) != 0)
+    {
+      continue;
+    }
+
+    kpszSource = gstProjectFiles.pastFiles[ii].szRelativePath + 4;
+    lNameLen = strlen(kpszSource);
+
+    if(lNameLen < 3 || strcmp(kpszSource + lNameLen - 2, ".c") != 0 ||
+       strchr(kpszSource, '/') != NULL || strncmp(kpszSource, "unity_", 6) == 0)
+    {
+      continue;
+    }
+
+    ppszSources[iSourcesCount++] = kpszSource;
+  }
+
+  /* Same batches on every run, whatever the order of the template files */
+  if(iSourcesCount > 0)
+  {
+    qsort(ppszSources, iSourcesCount, sizeof(char *), iCompareStrings);
+  }
+
+  for(ii = 0; ii < iSourcesCount; ii++)
+  {
+    if(ii % iBatchSize == 0)
+    {
+      if(stUnity.fpFile != NULL && !bCloseNewFile(&stUnity, 0644))
+      {
+        iRsl = -1;
+        break;
+      }
+
+      iUnityCount++;
+
+      snprintf(szUnityPath, sizeof(szUnityPath), "%s/src/unity_%d.c", gszFullNewProjectPathDir, iUnityCount);
+
+      if(!bOpenNewFile(&stUnity, szUnityPath, 0))
+      {
+        iRsl = -1;
+        break;
+      }
+
+      fprintf(stUnity.fpFile,
+          "/* Unity build file generated by %s, don't edit it. */\n"
+          "/* Run \"make unity\" to generate it again. */\n",
+          gkpszProgramName
+      );
+    }
+
+    fprintf(stUnity.fpFile, "#include \"%s\"\n", ppszSources[ii]);
+  }
+
+  if(iRsl == 0 && stUnity.fpFile != NULL && !bCloseNewFile(&stUnity, 0644))
+  {
+    iRsl = -1;
+  }
+
+  free(ppszSources);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+char *pszGetDirective(char *pszLine)
+{
+  for(pszLine++; *pszLine == ' ' || *pszLine == '\t'; pszLine++);
+
+  return pszLine;
+}
+
+bool bIsIncludeGuard(char *pszIfLine, char *pszDefineLine)
+{
+  char szIfMacro[256];
+  char szDefineMacro[256];
+
+  memset(szIfMacro, 0, sizeof(szIfMacro));
+  memset(szDefineMacro, 0, sizeof(szDefineMacro));
+
+  return sscanf(pszGetDirective(pszIfLine), "ifndef %255s", szIfMacro) == 1 &&
+         sscanf(pszGetDirective(pszDefineLine), "define %255s", szDefineMacro) == 1 &&
+         strcmp(szIfMacro, szDefineMacro) == 0;
+}
+
+int iCreatePrecompiledHeader(void)
+{
+  FILE *fpHeader = NULL;
+  FILE *fpHeaderLines = NULL;
+  STRUCT_NEW_FILE stPch;
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile = NULL;
+  char *pszHeaderLines = NULL;
+  size_t lHeaderLinesSize = 0;
+  char *pszLine = NULL;
+  char *pszNextLine = NULL;
+  char *pszDirective = NULL;
+  char **ppszPchLines = NULL;
+  int *paiPchLinesDepth = NULL;
+  int iPchLinesAlloc = 1;
+  int iPchLinesCount = 0;
+  int iDepth = 0;
+  int iGuardDepth = 0;
+  int ii = 0;
+  char szLine[4096];
+  char szTemplatePath[sizeof(gszTemplatePathDir) + _MAX_PATH];
+  char szPchPath[sizeof(gszFullNewProjectPathDir) + 32];
+
+  memset(&stPch, 0, sizeof(stPch));
+  memset(szLine, 0, sizeof(szLine));
+  memset(szTemplatePath, 0, sizeof(szTemplatePath));
+  memset(szPchPath, 0, sizeof(szPchPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if((pstTemplateFile = pstGetTemplateFile(HEADER_FILE)) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  iGetFullTemplateFileNamePath(HEADER_FILE, szTemplatePath);
+  snprintf(szPchPath, sizeof(szPchPath), "%s/include/pch.h", gszFullNewProjectPathDir);
+
+  /**
+   * The includes are read from the template of the header, with the
+   * name of the project already replaced, instead of the header
+   * created in the disk (that doesn't exist with --output-tar)
+   */
+  if((fpHeader = fpOpenTemplateFile(pstTemplateFile, szTemplatePath)) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if((fpHeaderLines = open_memstream(&pszHeaderLines, &lHeaderLinesSize)) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szPchPath);
+
+    bCloseFile(&fpHeader);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  while(fgets(szLine, sizeof(szLine), fpHeader) != NULL)
+  {
+    vReplaceTemplateName(fpHeaderLines, szLine);
+  }
+
+  bCloseFile(&fpHeader);
+  fclose(fpHeaderLines);
+
+  /* One line of the pch.h for each line of the header, at most */
+  for(pszLine = pszHeaderLines; (pszLine = strchr(pszLine, '\n')) != NULL; pszLine++, iPchLinesAlloc++);
+
+  if((ppszPchLines = (char **) calloc(iPchLinesAlloc, sizeof(char *))) == NULL ||
+     (paiPchLinesDepth = (int *) calloc(iPchLinesAlloc, sizeof(int))) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szPchPath);
+
+    free(ppszPchLines);
+    free(pszHeaderLines);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(!bOpenNewFile(&stPch, szPchPath, 0))
+  {
+    free(paiPchLinesDepth);
+    free(ppszPchLines);
+    free(pszHeaderLines);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  fprintf(stPch.fpFile,
+      "/**\n"
+      " * pch.h\n"
+      " *\n"
+      " * Description: Precompiled header of %s, generated by %s.\n"
+      " *              The Makefile includes it before every .c file,\n"
+      " *              so keep here only headers that rarely change.\n"
+      " */\n"
+      "\n"
+      "#ifndef _PCH_H_\n"
+      "#define _PCH_H_\n"
+      "\n", gstCmdLine.szProjName, gkpszProgramName
+  );
+
+  /**
+   * The system and library headers included by the header of the project,
+   * with the #if blocks around them (e.g. <unistd.h> only on __linux__).
+   * The include guard and the blocks without includes are left out.
+   */
+  for(pszLine = pszHeaderLines; pszLine != NULL && *pszLine != '\0'; pszLine = pszNextLine)
+  {
+    if((pszNextLine = strchr(pszLine, '\n')) != NULL)
+    {
+      *pszNextLine++ = '\0';
+    }
+
+    for(; *pszLine == ' ' || *pszLine == '\t'; pszLine++);
+
+    if(*pszLine != '#')
+    {
+      continue;
+    }
+
+    pszDirective = pszGetDirective(pszLine);
+
+    if(strncmp(pszDirective, "include", 7) == 0)
+    {
+      paiPchLinesDepth[iPchLinesCount] = iDepth;
+      ppszPchLines[iPchLinesCount++] = pszLine;
+    }
+    else if(strncmp(pszDirective, "if", 2) == 0)
+    {
+      iDepth++;
+      paiPchLinesDepth[iPchLinesCount] = iDepth;
+      ppszPchLines[iPchLinesCount++] = pszLine;
+    }
+    else if(strncmp(pszDirective, "elif", 4) == 0 || strncmp(pszDirective, "else", 4) == 0)
+    {
+      paiPchLinesDepth[iPchLinesCount] = iDepth;
+      ppszPchLines[iPchLinesCount++] = pszLine;
+    }
+    else if(strncmp(pszDirective, "endif", 5) == 0 && iDepth > 0)
+    {
+      /* The #elif and #else without includes before it */
+      while(iPchLinesCount > 0 && paiPchLinesDepth[iPchLinesCount - 1] == iDepth &&
+            strncmp(pszGetDirective(ppszPchLines[iPchLinesCount - 1]), "el", 2) == 0)
+      {
+        iPchLinesCount--;
+      }
+
+      if(iDepth == iGuardDepth)
+      {
+        iGuardDepth = 0;
+      }
+      else if(iPchLinesCount > 0 && paiPchLinesDepth[iPchLinesCount - 1] == iDepth &&
+              strncmp(pszGetDirective(ppszPchLines[iPchLinesCount - 1]), "if", 2) == 0)
+      {
+        /* The whole block has no includes */
+        iPchLinesCount--;
+      }
+      else
+      {
+        paiPchLinesDepth[iPchLinesCount] = iDepth;
+        ppszPchLines[iPchLinesCount++] = pszLine;
+      }
+
+      iDepth--;
+    }
+    else if(strncmp(pszDirective, "define", 6) == 0 && iGuardDepth == 0 && iPchLinesCount > 0 &&
+            paiPchLinesDepth[iPchLinesCount - 1] == iDepth && bIsIncludeGuard(ppszPchLines[iPchLinesCount - 1], pszLine))
+    {
+      /* #ifndef _PROJ_H_ followed by #define _PROJ_H_ */
+      iGuardDepth = iDepth;
+      iPchLinesCount--;
+    }
+  }
+
+  for(ii = 0; ii < iPchLinesCount; ii++)
+  {
+    fprintf(stPch.fpFile, "%s\n", ppszPchLines[ii]);
+  }
+
+  fprintf(stPch.fpFile, "\n#endif /* _PCH_H_ */\n");
+
+  free(paiPchLinesDepth);
+  free(ppszPchLines);
+  free(pszHeaderLines);
+
+  if(!bCloseNewFile(&stPch, 0644))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iCreateBench(void)
+{
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* The other files of the bench are optional, but not the runner */
+  if(pstGetTemplateFile(BENCH_FILE) == NULL)
+  {
+    vPrintErrorMessage(_("The template directory %s doesn't have the bench/bench.c file"), gszTemplatePathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(iCreateDirectories(BENCH_DIR) != 0 ||
+     iCreateFile(BENCH_HEADER_FILE) != 0 ||
+     iCreateFile(BENCH_FILE) != 0 ||
+     iCreateFile(BENCH_PROJECT_FILE) != 0 ||
+     iCreateFile(MKBENCH_FILE) != 0)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iCreateProjectInfoFile(void)
+{
+  STRUCT_NEW_FILE stInfo;
+  char szInfoPath[sizeof(gszFullNewProjectPathDir) + 32];
+
+  memset(&stInfo, 0, sizeof(stInfo));
+  memset(szInfoPath, 0, sizeof(szInfoPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szInfoPath, sizeof(szInfoPath), "%s/%s", gszFullNewProjectPathDir, PROJECT_INFO_FILE);
+
+  if(!bOpenNewFile(&stInfo, szInfoPath, 0))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  fprintf(stInfo.fpFile,
+      "# Information of the project created by %s, used to\n"
+      "# create its files again (e.g. %s --watch)\n"
+      "PROJECT_NAME = %s\n"
+      "DEV_NAME = %s\n"
+      "DEV_MAIL = %s\n"
+      "DESCRIPTION = %s\n"
+      "LICENSE = %s\n", gkpszProgramName, gkpszProgramName, gstCmdLine.szProjName,
+                        gstCmdLine.szDevName, gstCmdLine.szDevMail,
+                        gstCmdLine.szProjDescription, gstCmdLine.szLicense
+  );
+
+  if(gbUnityBuild)
+  {
+    fprintf(stInfo.fpFile, "UNITY_BATCH = %d\n", iGetUnityBatchSize());
+  }
+
+  if(!bCloseNewFile(&stInfo, 0644))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iCreateMonorepoMakefile(void)
+{
+  FILE *fpMakefile = NULL;
+  STRUCT_NEW_FILE stMakefile;
+  char szLine[4096];
+  char szMakefilePath[sizeof(gszProjectsPathDir) + 32];
+
+  memset(&stMakefile, 0, sizeof(stMakefile));
+  memset(szLine, 0, sizeof(szLine));
+  memset(szMakefilePath, 0, sizeof(szMakefilePath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szMakefilePath, sizeof(szMakefilePath), "%s/Makefile", gszProjectsPathDir);
+
+  /* Never overwrite a Makefile written by the developer */
+  if(gpstOutputSink == NULL && bOpenFile(&fpMakefile, szMakefilePath, "r"))
+  {
+    if(fgets(szLine, sizeof(szLine), fpMakefile) == NULL || strstr(szLine, MONOREPO_MAKEFILE_MARK) == NULL)
+    {
+      vPrintErrorMessage(_("%s was not generated by %s, remove it to use --monorepo"), szMakefilePath,
+                                                                                       gkpszProgramName);
+
+      bCloseFile(&fpMakefile);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+
+    bCloseFile(&fpMakefile);
+  }
+
+  if(!bOpenNewFile(&stMakefile, szMakefilePath, 0))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /**
+   * The projects are found by make (*\/.mkcproj), so this file
+   * is the same for any number of projects
+   */
+  fprintf(stMakefile.fpFile,
+      "# Makefile of the monorepo, " MONOREPO_MAKEFILE_MARK ", don't edit it.\n"
+      "# Run \"%s --monorepo\" to generate it again.\n"
+      "#\n"
+      "# Builds every project of this directory (the directories with a\n"
+      "# .mkcproj file) in a single make, without recursion, so \"make -j\"\n"
+      "# compiles the files of all the projects at the same time.\n"
+      "#\n"
+      "# A project uses the headers of other projects, and is linked\n"
+      "# with their objects (all but the one with main()), with this\n"
+      "# line in your .mkcproj file:\n"
+      "#\n"
+      "#   DEPENDS = other_project another_project\n"
+      "#\n"
+      "# The unity build and the precompiled header are options of the\n"
+      "# Makefile of each project, they aren't used here.\n"
+      "\n"
+      "CC           = gcc\n"
+      "CFLAGS       = -Wall -Wextra\n"
+      "LDFLAGS      =\n"
+      "LDLIBS       = -lm -pthread -ltrace -lcutils\n"
+      "DEBUGFLAGS   = -g -O0 -DDEBUG_COMPILATION\n"
+      "\n"
+      "ifdef DEBUG_COMPILATION\n"
+      "\tPROFILE  = debug\n"
+      "\tCFLAGS  += $(DEBUGFLAGS)\n"
+      "\tLDFLAGS += $(DEBUGFLAGS)\n"
+      "else\n"
+      "\tPROFILE  = release\n"
+      "\tCFLAGS  += -O3\n"
+      "endif\n"
+      "\n"
+      "PROJECTS     = $(patsubst %%/.mkcproj,%%,$(wildcard */.mkcproj))\n"
+      "\n"
+      "all:\n"
+      "\n"
+      "# Variables of a project, $(1) is your directory. They are defined\n"
+      "# for all the projects before the rules, which use the objects of\n"
+      "# the dependencies (and of their dependencies).\n"
+      "define PROJECT_VARS\n"
+      "$(1)_OBJDIR   = $(1)/obj/monorepo-$(PROFILE)\n"
+      "$(1)_SRC      = $$(filter-out $(1)/src/unity_%%.c,$$(wildcard $(1)/src/*.c))\n"
+      "$(1)_OBJ      = $$(patsubst $(1)/src/%%.c,$$($(1)_OBJDIR)/%%.o,$$($(1)_SRC))\n"
+      "$(1)_LIBOBJ   = $$(filter-out $$($(1)_OBJDIR)/$(1).o,$$($(1)_OBJ))\n"
+      "$(1)_DEPENDS  = $$(shell sed -n 's/^DEPENDS *= *//p' $(1)/.mkcproj)\n"
+      "$(1)_LINKOBJ  = $$(sort $$(foreach dep,$$($(1)_DEPENDS),$$($$(dep)_LIBOBJ) $$($$(dep)_LINKOBJ)))\n"
+      "$(1)_CPPFLAGS = -I $(1)/include -I $(1)/include/trace -I $(1)/include/cutils \\\n"
+      "                $$(foreach dep,$$($(1)_DEPENDS),-I $$(dep)/include) -MMD -MP\n"
+      "$(1)_BIN      = $(1)/bin/$(1)\n"
+      "endef\n"
+      "\n"
+      "# Rules of a project, $(1) is your directory\n"
+      "define PROJECT_RULES\n"
+      "all: $$($(1)_BIN)\n"
+      "\n"
+      "$$($(1)_BIN): $$($(1)_OBJ) $$($(1)_LINKOBJ) | $(1)/bin\n"
+      "\t$$(CC) -o $$@ $$($(1)_OBJ) $$($(1)_LINKOBJ) $$(CFLAGS) -L $(1)/lib $$(LDFLAGS) $$(LDLIBS)\n"
+      "\n"
+      "$$($(1)_OBJDIR)/%%.o: $(1)/src/%%.c | $$($(1)_OBJDIR)\n"
+      "\t$$(CC) -c $$< -o $$@ $$($(1)_CPPFLAGS) $$(CFLAGS)\n"
+      "\n"
+      "$(1)/bin $$($(1)_OBJDIR):\n"
+      "\tmkdir -p $$@\n"
+      "\n"
+      "clean-$(1):\n"
+      "\trm -rvf $$($(1)_OBJDIR)\n"
+      "\n"
+      "clean: clean-$(1)\n"
+      "\n"
+      ".PHONY: clean-$(1)\n"
+      "\n"
+      "-include $$($(1)_OBJ:.o=.d)\n"
+      "endef\n"
+      "\n"
+      "$(foreach project,$(PROJECTS),$(eval $(call PROJECT_VARS,$(project))))\n"
+      "$(foreach project,$(PROJECTS),$(eval $(call PROJECT_RULES,$(project))))\n"
+      "\n"
+      "clean:\n"
+      "\n"
+      ".PHONY: all clean\n", gkpszProgramName
+  );
+
+  if(!bCloseNewFile(&stMakefile, 0644))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+bool bLoadProjectInfo(const char *kpszProjectPathDir)
+{
+  FILE *fpInfo = NULL;
+  char *pszValue = NULL;
+  char *pszEnd = NULL;
+  char szLine[4096];
+  char szInfoPath[sizeof(gszFullNewProjectPathDir) + 32];
+
+  memset(szLine, 0, sizeof(szLine));
+  memset(szInfoPath, 0, sizeof(szInfoPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szInfoPath, sizeof(szInfoPath), "%s/%s", kpszProjectPathDir, PROJECT_INFO_FILE);
+
+  if(!bOpenFile(&fpInfo, szInfoPath, "r"))
+  {
+    vPrintErrorMessage(_("Impossible open the file %s"), szInfoPath);
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the file %s"), szInfoPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  memset(&gstCmdLine.szProjName, 0, sizeof(gstCmdLine.szProjName));
+  memset(&gstCmdLine.szUnityBatch, 0, sizeof(gstCmdLine.szUnityBatch));
+  gbUnityBuild = false;
+
+  /* KEY = value */
+  while(fgets(szLine, sizeof(szLine), fpInfo) != NULL)
+  {
+    szLine[strcspn(szLine, "\r\n")] = '\0';
+
+    if(szLine[0] == '#' || (pszValue = strchr(szLine, '=')) == NULL)
+    {
+      continue;
+    }
+
+    /* Trim the key and the value */
+    for(pszEnd = pszValue; pszEnd > szLine && (pszEnd[-1] == ' ' || pszEnd[-1] == '\t'); pszEnd--);
+    *pszEnd = '\0';
+    for(pszValue++; *pszValue == ' ' || *pszValue == '\t'; pszValue++);
+
+    if(strcmp(szLine, "PROJECT_NAME") == 0)
+    {
+      snprintf(gstCmdLine.szProjName, sizeof(gstCmdLine.szProjName), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "DEV_NAME") == 0)
+    {
+      snprintf(gstCmdLine.szDevName, sizeof(gstCmdLine.szDevName), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "DEV_MAIL") == 0)
+    {
+      snprintf(gstCmdLine.szDevMail, sizeof(gstCmdLine.szDevMail), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "DESCRIPTION") == 0)
+    {
+      snprintf(gstCmdLine.szProjDescription, sizeof(gstCmdLine.szProjDescription), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "LICENSE") == 0)
+    {
+      snprintf(gstCmdLine.szLicense, sizeof(gstCmdLine.szLicense), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "UNITY_BATCH") == 0)
+    {
+      snprintf(gstCmdLine.szUnityBatch, sizeof(gstCmdLine.szUnityBatch), "%s", pszValue);
+      gbUnityBuild = true;
+    }
+  }
+
+  bCloseFile(&fpInfo);
+
+  if(bStrIsEmpty(gstCmdLine.szProjName))
+  {
+    vPrintErrorMessage(_("PROJECT_NAME not found in %s"), szInfoPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  snprintf(gszFullNewProjectPathDir, sizeof(gszFullNewProjectPathDir), "%s", kpszProjectPathDir);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+uint64_t ui64GetTemplateFileFlag(const char *kpszRelativePath)
+{
+  uint64_t ui64Flag;
+  char szFullTemplateFileNamePath[sizeof(gszTemplatePathDir) + _MAX_PATH];
+  size_t lTemplatePathLen = strlen(gszTemplatePathDir);
+
+  for(ui64Flag = HEADER_FILE; ui64Flag != 0 && ui64Flag <= PROJECT_FILES; ui64Flag <<= 1)
+  {
+    if(!(ui64Flag & PROJECT_FILES))
+    {
+      continue;
+    }
+
+    memset(szFullTemplateFileNamePath, 0, sizeof(szFullTemplateFileNamePath));
+
+    iGetFullTemplateFileNamePath(ui64Flag, szFullTemplateFileNamePath);
+
+    if(strcmp(szFullTemplateFileNamePath + lTemplatePathLen + 1, kpszRelativePath) == 0)
+    {
+      return ui64Flag;
+    }
+  }
+
+  return 0;
+}
+
+int iUpdateProjectFiles(uint64_t ui64Flags)
+{
+  uint64_t ui64Flag;
+  int iRsl = 0;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  gstProjectFiles.iFilesCount = 0;
+
+  for(ui64Flag = HEADER_FILE; ui64Flag != 0 && ui64Flag <= ui64Flags; ui64Flag <<= 1)
+  {
+    if(!(ui64Flag & ui64Flags & PROJECT_FILES))
+    {
+      continue;
+    }
+
+    if(iCreateFile(ui64Flag) != 0)
+    {
+      iRsl = -1;
+      continue;
+    }
+
+    /* Deleted templates are not in the index, nothing was written */
+    if(pstGetTemplateFile(ui64Flag) != NULL)
+    {
+      printf(_("Updated %s\n"), gszFullNewFileNamePath);
+    }
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iAddTemplateWatches(PSTRUCT_TEMPLATE_WATCH pstWatch, const char *kpszRelativeDir)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  PSTRUCT_WATCH_DIR pastTmp = NULL;
+  int iWatchDescriptor = 0;
+  int iRsl = 0;
+  char szDirPath[sizeof(gszTemplatePathDir) + _MAX_PATH + 2];
+  char szRelativePath[_MAX_PATH];
+
+  memset(szDirPath, 0, sizeof(szDirPath));
+  memset(szRelativePath, 0, sizeof(szRelativePath));
+
+  snprintf(szDirPath, sizeof(szDirPath), "%s%s%s", gszTemplatePathDir,
+           bStrIsEmpty(kpszRelativeDir) ? "" : "/", kpszRelativeDir);
+
+  if((iWatchDescriptor = inotify_add_watch(pstWatch->iInotifyFd, szDirPath, WATCH_EVENTS)) < 0)
+  {
+    vPrintErrorMessage(_("Impossible watch the directory %s: %s"), szDirPath, strerror(errno));
+
+    return -1;
+  }
+
+  if((pastTmp = (PSTRUCT_WATCH_DIR) realloc(pstWatch->pastDirs,
+                                            (pstWatch->iDirsCount + 1) * sizeof(STRUCT_WATCH_DIR))) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to watch the directory %s"), szDirPath);
+
+    return -1;
+  }
+
+  pstWatch->pastDirs = pastTmp;
+  pstWatch->pastDirs[pstWatch->iDirsCount].iWatchDescriptor = iWatchDescriptor;
+  snprintf(pstWatch->pastDirs[pstWatch->iDirsCount].szRelativeDir,
+           sizeof(pstWatch->pastDirs[pstWatch->iDirsCount].szRelativeDir), "%s", kpszRelativeDir);
+  pstWatch->iDirsCount++;
+
+  if((pDir = opendir(szDirPath)) == NULL)
+  {
+    return 0;
+  }
+
+  while(iRsl == 0 && (pstEntry = readdir(pDir)) != NULL)
+  {
+    if(pstEntry->d_name[0] == '.' || pstEntry->d_type != DT_DIR)
+    {
+      continue;
+    }
+
+    if(snprintf(szRelativePath, sizeof(szRelativePath), "%s%s%s", kpszRelativeDir,
+                bStrIsEmpty(kpszRelativeDir) ? "" : "/", pstEntry->d_name) >= (int) sizeof(szRelativePath))
+    {
+      continue;
+    }
+
+    iRsl = iAddTemplateWatches(pstWatch, szRelativePath);
+  }
+
+  closedir(pDir);
+
+  return iRsl;
+}
+
+bool bAddWatchTreePath(PSTRUCT_TEMPLATE_WATCH pstWatch, const char *kpszRelativePath)
+{
+  char **ppszTmp = NULL;
+  int ii;
+
+  /* An editor writes the same file many times */
+  for(ii = 0; ii < pstWatch->iTreePathsCount; ii++)
+  {
+    if(strcmp(pstWatch->ppszTreePaths[ii], kpszRelativePath) == 0)
+    {
+      return true;
+    }
+  }
+
+  if((ppszTmp = (char **) realloc(pstWatch->ppszTreePaths,
+                                  (pstWatch->iTreePathsCount + 1) * sizeof(char *))) == NULL)
+  {
+    return false;
+  }
+
+  pstWatch->ppszTreePaths = ppszTmp;
+
+  if((pstWatch->ppszTreePaths[pstWatch->iTreePathsCount] = strdup(kpszRelativePath)) == NULL)
+  {
+    return false;
+  }
+
+  pstWatch->iTreePathsCount++;
+
+  return true;
+}
+
+void vFreeWatchTreePaths(PSTRUCT_TEMPLATE_WATCH pstWatch)
+{
+  int ii;
+
+  for(ii = 0; ii < pstWatch->iTreePathsCount; ii++)
+  {
+    free(pstWatch->ppszTreePaths[ii]);
+  }
+
+  free(pstWatch->ppszTreePaths);
+
+  pstWatch->ppszTreePaths = NULL;
+  pstWatch->iTreePathsCount = 0;
+}
+
+uint64_t ui64ReadTemplateEvents(PSTRUCT_TEMPLATE_WATCH pstWatch)
+{
+  char acBuffer[16 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+  const struct inotify_event *kpstEvent = NULL;
+  uint64_t ui64Flags = 0;
+  uint64_t ui64Flag = 0;
+  ssize_t lBytes = 0;
+  char *pchEvent = NULL;
+  int ii;
+  char szRelativePath[_MAX_PATH];
+
+  memset(szRelativePath, 0, sizeof(szRelativePath));
+
+  if((lBytes = read(pstWatch->iInotifyFd, acBuffer, sizeof(acBuffer))) <= 0)
   {
-    u64FileType = SOURCE_FILE;
-    strcat(szFileName, gstCmdLine.szProjName);
-    strcat(szFileName, ".c");
+    return 0;
   }
 
-  if(ui64Flag & MAKEFILE_FILE)
+  for(pchEvent = acBuffer; pchEvent < acBuffer + lBytes; pchEvent += sizeof(struct inotify_event) + kpstEvent->len)
   {
-    u64FileType = MAKEFILE_FILE;
-    snprintf(szFileName, sizeof(szFileName), "Makefile");
+    kpstEvent = (const struct inotify_event *) pchEvent;
+
+    /* Editors temporary files: .file.swp, file~, ... */
+    if(kpstEvent->len == 0 || kpstEvent->name[0] == '.' ||
+       kpstEvent->name[strlen(kpstEvent->name) - 1] == '~')
+    {
+      continue;
+    }
+
+    for(ii = 0; ii < pstWatch->iDirsCount; ii++)
+    {
+      if(pstWatch->pastDirs[ii].iWatchDescriptor == kpstEvent->wd)
+      {
+        break;
+      }
+    }
+
+    if(ii == pstWatch->iDirsCount)
+    {
+      continue;
+    }
+
+    snprintf(szRelativePath, sizeof(szRelativePath), "%s%s%s", pstWatch->pastDirs[ii].szRelativeDir,
+             bStrIsEmpty(pstWatch->pastDirs[ii].szRelativeDir) ? "" : "/", kpstEvent->name);
+
+    /* New subdirectory of the template */
+    if(kpstEvent->mask & IN_ISDIR)
+    {
+      if(kpstEvent->mask & (IN_CREATE | IN_MOVED_TO))
+      {
+        iAddTemplateWatches(pstWatch, szRelativePath);
+      }
+
+      continue;
+    }
+
+    if((ui64Flag = ui64GetTemplateFileFlag(szRelativePath)) == 0 && !bAddWatchTreePath(pstWatch, szRelativePath))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szRelativePath);
+    }
+
+    ui64Flags |= ui64Flag;
+
+    if(DEBUG_DETAILS) vTraceAll("inotify: %s 0x%08X", szRelativePath, kpstEvent->mask);
   }
-  
-  if(bFileType == false)
+
+  return ui64Flags;
+}
+
+int iWatchTemplateDir(int iProjectsCount, char **ppszProjectsPathDir)
+{
+  STRUCT_TEMPLATE_WATCH stWatch;
+  struct pollfd stPollFd;
+  uint64_t ui64Flags = 0;
+  bool bManifestOption = gbManifest;
+  char szManifestPath[sizeof(gszFullNewProjectPathDir) + 32];
+  int iRsl = 0;
+  int ii;
+
+  memset(&stWatch, 0, sizeof(stWatch));
+  memset(&stPollFd, 0, sizeof(stPollFd));
+  memset(szManifestPath, 0, sizeof(szManifestPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(!bStrIsEmpty(gstCmdLine.szTemplateArchive))
   {
-    if(INFO_DETAILS) vTraceInfo(_("Invalid file type!"));
-    
-    free(pstDate);
-    pstDate = NULL;
+    vPrintErrorMessage(_("--watch needs a template directory, not an archive"));
 
-    return false;
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
   }
-  
-  if(INFO_DETAILS) vTraceInfo(_("Create Header Comment"));
-  
-  if(!bOpenFile(&fpFile, szFileName, "rw"))
+
+  if(iProjectsCount <= 0)
   {
-    vPrintErrorMessage(_("Impossible open the file %s"), szFileName);
-    
-    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the file %s"), szFileName);
+    vPrintErrorMessage(_("No project directory to update, usage: %s --watch <dir>..."), gkpszProgramName);
 
-    free(pstDate);
-    pstDate = NULL;
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
 
-    exit(EXIT_FAILURE);
+    return -1;
   }
-  
-  vGetCurrentDate(&pstDate);
-
-  if(u64FileType != MAKEFILE_FILE)
-  {
-    fprintf(fpFile,
-        "/** \n"
-        " * %s.%c\n" /* Filename and extension */
-        " * \n"
-        " * Description: %s\n"
-        " * \n"
-        " * Copyright (C) %d %s\n" /* Year and developer name */
-        "%s"                       /* License text of the software */
-        " * \n"
-        " * Date: %02d/%02d/%04d\n" /* dd/mm/yyyy */
-        " */", gstCmdLine.szProjName, u64FileType == HEADER_FILE ? 'h' : 'c',
-               gstCmdLine.szProjDescription, pstDate->iYear, gstCmdLine.szDevName,
-               bStrIsEmpty(gstCmdLine.szLicense) ? " * \n" : gstCmdLine.szLicense,
-               pstDate->iDay, pstDate->iMonth, pstDate->iYear
-    );
+
+  /* Check the projects now, not on the first change of the template */
+  for(ii = 0; ii < iProjectsCount; ii++)
+  {
+    if(!bLoadProjectInfo(ppszProjectsPathDir[ii]))
+    {
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
   }
-  else
+
+  if((stWatch.iInotifyFd = inotify_init1(IN_CLOEXEC)) < 0)
   {
-    fprintf(fpFile,
-        "# \n"
-        "# %s.%c\n" /* Filename and extension */
-        "# \n"
-        "# Description: %s\n"
-        "# \n"
-        "# Copyright (C) %d %s\n" /* Year and developer name */
-        "# %s"                       /* License text of the software */
-        "# \n"
-        "# Date: %02d/%02d/%04d\n" /* dd/mm/yyyy */
-        "# ", gstCmdLine.szProjName, u64FileType == HEADER_FILE ? 'h' : 'c',
-              gstCmdLine.szProjDescription, pstDate->iYear, gstCmdLine.szDevName,
-              bStrIsEmpty(gstCmdLine.szLicense) ? " * \n" : gstCmdLine.szLicense,
-              pstDate->iDay, pstDate->iMonth, pstDate->iYear
-    );
+    vPrintErrorMessage(_("inotify_init1: %s"), strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
   }
-  
-  if(!bCloseFile(&fpFile))
+
+  if(iAddTemplateWatches(&stWatch, "") != 0)
   {
-    vPrintErrorMessage(_("Impossible close the file %s"), szFileName);
-    
-    if(DEBUG_DETAILS) vTraceFatal(_("Impossible close the file %s"), szFileName);
+    close(stWatch.iInotifyFd);
+    free(stWatch.pastDirs);
 
-    free(pstDate);
-    pstDate = NULL;
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
 
-    exit(EXIT_FAILURE);
+    return -1;
   }
 
-  if(INFO_DETAILS) vTraceInfo(_("%s - end"), __func__);
+  printf(_("Watching %s, press Ctrl+C to stop\n"), gszTemplatePathDir);
 
-  free(pstDate);
-  pstDate = NULL;
+  stPollFd.fd = stWatch.iInotifyFd;
+  stPollFd.events = POLLIN;
 
-  return true;
-}
+  while(poll(&stPollFd, 1, -1) > 0)
+  {
+    /**
+     * An editor or a checkout writes many files (or the same file
+     * many times), so wait WATCH_DEBOUNCE_MS without new events
+     * before update the projects
+     */
+    ui64Flags = ui64ReadTemplateEvents(&stWatch);
 
-/**
- * TODO: Implement it.
- */
-void vSkipTemplateHeaderComment(void)
-{
-  return;
+    while(poll(&stPollFd, 1, WATCH_DEBOUNCE_MS) > 0)
+    {
+      ui64Flags |= ui64ReadTemplateEvents(&stWatch);
+    }
+
+    if(ui64Flags == 0 && stWatch.iTreePathsCount == 0)
+    {
+      continue;
+    }
+
+    if(iIndexTemplate() != 0)
+    {
+      vFreeWatchTreePaths(&stWatch);
+
+      continue;
+    }
+
+    for(ii = 0; ii < iProjectsCount; ii++)
+    {
+      if(!bLockProject(ppszProjectsPathDir[ii]) || !bLoadProjectInfo(ppszProjectsPathDir[ii]))
+      {
+        iRsl = -1;
+
+        vUnlockProject();
+
+        continue;
+      }
+
+      /* The manifest of each project is updated when it exists, like --add-module */
+      snprintf(szManifestPath, sizeof(szManifestPath), "%s/%s", gszFullNewProjectPathDir, MANIFEST_FILE);
+      gbManifest = bManifestOption || access(szManifestPath, F_OK) == 0;
+
+      /* The other files of the template are created by the tree walk */
+      if(iUpdateProjectFiles(ui64Flags) != 0 ||
+         iUpdateTemplateTree(stWatch.ppszTreePaths, stWatch.iTreePathsCount) != 0 ||
+         (gbManifest && iWriteManifest() != 0))
+      {
+        iRsl = -1;
+      }
+
+      vUnlockProject();
+    }
+
+    gbManifest = bManifestOption;
+
+    vFreeWatchTreePaths(&stWatch);
+
+    fflush(stdout);
+  }
+
+  close(stWatch.iInotifyFd);
+  free(stWatch.pastDirs);
+  vFreeWatchTreePaths(&stWatch);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
 }
 
-/**
- * TODO: Implement it.
- */
 int iMakeProject(void)
 {
+  /**
+   * Reading the template directory (or archive)
+   */
+  if(iIndexTemplate() != 0)
+  {
+    return -35;
+  }
+
+  if(!bRequiredTemplateFilesExist())
+  {
+    return -36;
+  }
+
   /**
    * Creating the directories
    */
@@ -1100,26 +2919,130 @@ int iMakeProject(void)
     return -31;
   }
 
+  if(iCreateFile(MKPGO_FILE) != 0)
+  {
+    return -32;
+  }
+
+  if(iCreateFile(MKPROF_FILE) != 0)
+  {
+    return -42;
+  }
+
+  /* The other files of the template, in any directory */
+  if(iCreateTemplateTree() != 0)
+  {
+    return -43;
+  }
+
+  /* Before the unity files and the pch.h, they have the modules too */
+  if(!bStrIsEmpty(gstCmdLine.szWith) && iCreateWithModules() != 0)
+  {
+    return -45;
+  }
+
+  if(gbUnityBuild && iCreateUnityFiles() != 0)
+  {
+    return -33;
+  }
+
+  if(gbPrecompiledHeader && iCreatePrecompiledHeader() != 0)
+  {
+    return -34;
+  }
+
+  if(gbBench && iCreateBench() != 0)
+  {
+    return -41;
+  }
+
+  if(iCreateProjectInfoFile() != 0)
+  {
+    return -37;
+  }
+
+  if(gbManifest && iWriteManifest() != 0)
+  {
+    return -40;
+  }
+
+  if(gbMonorepo && iCreateMonorepoMakefile() != 0)
+  {
+    return -39;
+  }
+
   return 0;
 }
 
+int iGenerateProject(PSTRUCT_OUTPUT_SINK pstSink)
+{
+  int iRsl = 0;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* Two mkcproj creating the same project */
+  if(pstSink == NULL && !bLockProject(gszFullNewProjectPathDir))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (project locked)"), __func__);
+
+    return -44;
+  }
+
+  gpstOutputSink = pstSink;
+
+  iRsl = iMakeProject();
+
+  if(pstSink == NULL)
+  {
+    vUnlockProject();
+  }
+  else if(iRsl == 0 && pstSink->pbFinish != NULL && !pstSink->pbFinish(pstSink->pvData))
+  {
+    vPrintErrorMessage(_("Impossible finish the output of the project %s"), gstCmdLine.szProjName);
+
+    iRsl = -38;
+  }
+
+  gpstOutputSink = NULL;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
 /******************************************************************************
  *                                                                            *
  *                                   main                                     *
  *                                                                            *
  ******************************************************************************/
+#ifndef MKCPROJ_LIBRARY
 #ifdef __linux__
 int main(int argc, char **argv, char **envp)
 #else
 int main(int argc, char **argv)
 #endif /* __linux__ */
 {
+  char **ppszVerifyDirs = NULL;
+  const char *kpszProjectPathDir = NULL;
+  STRUCT_OUTPUT_SINK stTarSink;
   int iRsl = 0;
   
   memset(&gstCmdLine, 0, sizeof(gstCmdLine));
+  memset(&stTarSink, 0, sizeof(stTarSink));
 
   /* Setting the name of program */
   gkpszProgramName = szGetProgramName(argv[0]);
+
+  /* The shell completion runs on each TAB, before the .conf and the log */
+  if(argc > 1 && strcmp(argv[1], COMPLETE_OPTION) == 0)
+  {
+    return iCompleteCommandLine(argc - 2, argv + 2) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(argc > 1 && strcmp(argv[1], COMPLETION_SCRIPT_OPTION) == 0)
+  {
+    return iWriteCompletionScript(stdout) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
   
   UNUSED(kszLogLevelColorInit);
   UNUSED(kszLogLevelColorEnd);
@@ -1168,18 +3091,28 @@ int main(int argc, char **argv)
     exit(EXIT_FAILURE);
   }
 
-  if(!bStrIsEmpty(gstCmdLine.szLogFileName))
+  /* Parallel runs don't write in the same log */
+  if(bStrIsEmpty(gstCmdLine.szLogFileName))
   {
-    vSetLogFileName(gstCmdLine.szLogFileName);
+    snprintf(gstCmdLine.szLogFileName, sizeof(gstCmdLine.szLogFileName), "%s", LOG_FILE_NAME);
   }
-  else
+
+  if(gbMergeLogs)
+  {
+    exit(iMergeLogShards(gstCmdLine.szLogFileName) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  vSetSharedLogFileName(gstCmdLine.szLogFileName);
+
+  /* Chrome trace-event JSON of the spans of the functions */
+  if(!bStrIsEmpty(gstCmdLine.szTraceEvents) && iInitTraceEvents(gstCmdLine.szTraceEvents) != 0)
   {
-    vSetLogFileName(LOG_FILE_NAME);
+    exit(EXIT_FAILURE);
   }
 
   if(INFO_DETAILS)
   {
-    vTraceInfo(_("%s - begin"), __func__);
+    vTraceEvent(_("%s - begin"), __func__);
   }
 
   if(TRACE_DETAILS)
@@ -1192,23 +3125,107 @@ int main(int argc, char **argv)
   
   iInitMkcproj();
 
-  if(argc == 1)
+  if(gbWatch)
   {
-    if((iRsl = iGetProjInfo()) != 0)
+    iRsl = iWatchTemplateDir(argc - optind, &argv[optind]);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(!bStrIsEmpty(gstCmdLine.szVerify))
+  {
+    /* mkcproj --verify DIR [DIR...] */
+    if((ppszVerifyDirs = (char **) calloc(argc - optind + 1, sizeof(char *))) == NULL)
     {
-      vPrintErrorMessage(_("Impossible get the information about the project!"));
-      
+      vPrintErrorMessage(_("Impossible allocate memory to verify the projects"));
+
+      exit(EXIT_FAILURE);
+    }
+
+    ppszVerifyDirs[0] = gstCmdLine.szVerify;
+    memcpy(&ppszVerifyDirs[1], &argv[optind], (argc - optind) * sizeof(char *));
+
+    iRsl = iVerifyManifests(argc - optind + 1, ppszVerifyDirs);
+
+    free(ppszVerifyDirs);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(!bStrIsEmpty(gstCmdLine.szRename))
+  {
+    /* mkcproj --rename OLD NEW DIR */
+    if(argc - optind != 2)
+    {
+      vPrintErrorMessage(_("Usage: %s --rename OLD NEW DIR"), gkpszProgramName);
+
+      exit(EXIT_FAILURE);
+    }
+
+    if(!bLockProject(argv[optind + 1]))
+    {
+      exit(EXIT_FAILURE);
+    }
+
+    iRsl = iRenameProject(gstCmdLine.szRename, argv[optind], argv[optind + 1]);
+
+    vUnlockProject();
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(!bStrIsEmpty(gstCmdLine.szAddModule))
+  {
+    /* mkcproj --add-module NAME [DIR] */
+    kpszProjectPathDir = optind < argc ? argv[optind] : ".";
+
+    if(!bLockProject(kpszProjectPathDir))
+    {
+      exit(EXIT_FAILURE);
+    }
+
+    iRsl = iAddModule(gstCmdLine.szAddModule, kpszProjectPathDir);
+
+    vUnlockProject();
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(!bStrIsEmpty(gstCmdLine.szExtractTemplate))
+  {
+    iRsl = iExtractTemplate(gstCmdLine.szExtractTemplate);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(argc == 1 || !bRequiredProjInfoExist(false))
+  {
+    /* Scripts never wait for an answer in the terminal */
+    if(gbNonInteractive)
+    {
+      bRequiredProjInfoExist(true);
+
       if(FATAL_DETAILS)
       {
-        vTraceFatal("%s - end iRsl == %d", __func__, iRsl);
+        vTraceFatal("%s - end (missing required fields)", __func__);
       }
 
       exit(EXIT_FAILURE);
     }
 
-    if((iRsl = iMakeProject()) != 0)
+    if((iRsl = iGetProjInfo()) != 0)
     {
-      vPrintErrorMessage(_("Impossible create the project!"));
+      vPrintErrorMessage(_("Impossible get the information about the project!"));
       
       if(FATAL_DETAILS)
       {
@@ -1219,9 +3236,47 @@ int main(int argc, char **argv)
     }
   }
   
+  if(bStrIsEmpty(gstCmdLine.szLicense))
+  {
+    strcpy(gstCmdLine.szLicense, "GPLv2");
+  }
+
   snprintf(gszFullNewProjectPathDir, sizeof(gszFullNewProjectPathDir), "%s/%s", gszProjectsPathDir, gstCmdLine.szProjName);
 
-  if((iRsl = iMakeProject()) != 0)
+  if(!bStrIsEmpty(gstCmdLine.szOutputTar))
+  {
+    if(strcmp(gstCmdLine.szOutputTar, "-") == 0)
+    {
+      gfpOutputTar = stdout;
+    }
+    else if((gfpOutputTar = fopen(gstCmdLine.szOutputTar, "wb")) == NULL)
+    {
+      vPrintErrorMessage(_("Impossible open the file %s: %s"), gstCmdLine.szOutputTar, strerror(errno));
+
+      if(FATAL_DETAILS)
+      {
+        vTraceFatal(_("Impossible open the file %s: %s"), gstCmdLine.szOutputTar, strerror(errno));
+      }
+
+      exit(EXIT_FAILURE);
+    }
+
+    vInitTarSink(&stTarSink, gfpOutputTar);
+  }
+
+  iRsl = iGenerateProject(gfpOutputTar != NULL ? &stTarSink : NULL);
+
+  if(gfpOutputTar != NULL)
+  {
+    if(gfpOutputTar != stdout && fclose(gfpOutputTar) != 0 && iRsl == 0)
+    {
+      iRsl = -38;
+    }
+
+    gfpOutputTar = NULL;
+  }
+
+  if(iRsl != 0)
   {
     vPrintErrorMessage(_("Impossible create the project!"));
     
@@ -1236,9 +3291,9 @@ int main(int argc, char **argv)
   if(INFO_DETAILS)
   {
     vInfoShowProjectInformations();
-    vTraceInfo(_("%s - end iRsl == %d"), __func__, iRsl);
+    vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
   }
 
   return iRsl;
 }
-
+#endif /* MKCPROJ_LIBRARY */
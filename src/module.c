@@ -0,0 +1,441 @@
+/**
+ * module.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Add a module (src/NAME.c and include/NAME.h)
+ *              to a project created before (--add-module)
+ *
+ * Date: 19/10/2026
+ */
+
+/* memmem() */
+#define _GNU_SOURCE
+
+#include "cmdline.h"
+#include "banner.h"
+#include "manifest.h"
+#include "module.h"
+
+bool bIsValidModuleName(const char *kpszModuleName)
+{
+  int ii;
+
+  if(bStrIsEmpty(kpszModuleName) || isdigit((unsigned char) kpszModuleName[0]))
+  {
+    return false;
+  }
+
+  for(ii = 0; kpszModuleName[ii] != '\0'; ii++)
+  {
+    if(!isalnum((unsigned char) kpszModuleName[ii]) && kpszModuleName[ii] != '_')
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int iCreateModuleHeader(const char *kpszModuleName)
+{
+  STRUCT_NEW_FILE stHeader;
+  char szFileName[_MAX_PATH];
+  char szUpperName[_MAX_PATH];
+  char szHeaderPath[sizeof(gszFullNewProjectPathDir) + _MAX_PATH + 16];
+  int ii;
+
+  memset(&stHeader, 0, sizeof(stHeader));
+  memset(szFileName, 0, sizeof(szFileName));
+  memset(szUpperName, 0, sizeof(szUpperName));
+  memset(szHeaderPath, 0, sizeof(szHeaderPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  for(ii = 0; kpszModuleName[ii] != '\0' && ii < (int) sizeof(szUpperName) - 1; ii++)
+  {
+    szUpperName[ii] = toupper((unsigned char) kpszModuleName[ii]);
+  }
+
+  snprintf(szFileName, sizeof(szFileName), "%s.h", kpszModuleName);
+  snprintf(szHeaderPath, sizeof(szHeaderPath), "%s/include/%s", gszFullNewProjectPathDir, szFileName);
+
+  if(!bOpenNewFile(&stHeader, szHeaderPath, 0))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  bWriteBanner(stHeader.fpFile, COMMENT_STYLE_C, szFileName);
+
+  fprintf(stHeader.fpFile,
+      "\n"
+      "#ifndef _%s_H_\n"
+      "#define _%s_H_\n"
+      "\n"
+      "/******************************************************************************\n"
+      " *                                                                            *\n"
+      " *                                 Includes                                   *\n"
+      " *                                                                            *\n"
+      " ******************************************************************************/\n"
+      "#include \"%s.h\"\n"
+      "\n"
+      "/******************************************************************************\n"
+      " *                                                                            *\n"
+      " *                            Prototype functions                             *\n"
+      " *                                                                            *\n"
+      " ******************************************************************************/\n"
+      "\n"
+      "#endif /* _%s_H_ */\n", szUpperName, szUpperName, gstCmdLine.szProjName, szUpperName
+  );
+
+  if(!bCloseNewFile(&stHeader, 0644))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iCreateModuleSource(const char *kpszModuleName)
+{
+  STRUCT_NEW_FILE stSource;
+  char szFileName[_MAX_PATH];
+  char szSourcePath[sizeof(gszFullNewProjectPathDir) + _MAX_PATH + 16];
+
+  memset(&stSource, 0, sizeof(stSource));
+  memset(szFileName, 0, sizeof(szFileName));
+  memset(szSourcePath, 0, sizeof(szSourcePath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szFileName, sizeof(szFileName), "%s.c", kpszModuleName);
+  snprintf(szSourcePath, sizeof(szSourcePath), "%s/src/%s", gszFullNewProjectPathDir, szFileName);
+
+  if(!bOpenNewFile(&stSource, szSourcePath, 0))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  bWriteBanner(stSource.fpFile, COMMENT_STYLE_C, szFileName);
+
+  fprintf(stSource.fpFile, "\n#include \"%s.h\"\n", kpszModuleName);
+
+  if(!bCloseNewFile(&stSource, 0644))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+/**
+ * Length of the name of the variable when kpszLine is
+ * "NAME =", "NAME :=" or "NAME +=", 0 in the other lines
+ */
+static size_t lGetAssignedVariable(const char *kpszLine)
+{
+  size_t lNameLen = 0;
+  size_t lOffset = 0;
+
+  for(lNameLen = 0; isalnum((unsigned char) kpszLine[lNameLen]) || kpszLine[lNameLen] == '_'; lNameLen++);
+
+  for(lOffset = lNameLen; kpszLine[lOffset] == ' ' || kpszLine[lOffset] == '\t'; lOffset++);
+
+  if(kpszLine[lOffset] == ':' || kpszLine[lOffset] == '+')
+  {
+    lOffset++;
+  }
+
+  return lNameLen > 0 && kpszLine[lOffset] == '=' ? lNameLen : 0;
+}
+
+int iAddModuleToMakefile(const char *kpszModuleName)
+{
+  FILE *fpMakefile = NULL;
+  struct stat stFileStat;
+  char *pszContent = NULL;
+  char *pszLine = NULL;
+  char *pszLineEnd = NULL;
+  char *pszInsert = NULL;
+  char *pszLastLine = NULL;
+  char *pszListLastLine = NULL;
+  char *pszToken = NULL;
+  char *pszTokenName = NULL;
+  char *pszTokenEnd = NULL;
+  size_t lNameLen = 0;
+  size_t lIndentLen = 0;
+  bool bObjList = false;
+  bool bMultiLine = false;
+  bool bListMultiLine = false;
+  int iRsl = 0;
+  char szMakefilePath[sizeof(gszFullNewProjectPathDir) + 32];
+  char szTmpPath[sizeof(szMakefilePath) + 32];
+  char szNewToken[_MAX_PATH * 2];
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szMakefilePath, 0, sizeof(szMakefilePath));
+  memset(szTmpPath, 0, sizeof(szTmpPath));
+  memset(szNewToken, 0, sizeof(szNewToken));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szMakefilePath, sizeof(szMakefilePath), "%s/%s", gszFullNewProjectPathDir, MODULE_MAKEFILE);
+  snprintf(szTmpPath, sizeof(szTmpPath), "%s%s", szMakefilePath, TMP_FILE_SUFFIX);
+
+  if(stat(szMakefilePath, &stFileStat) != 0 ||
+     (pszContent = (char *) calloc(stFileStat.st_size + 1, 1)) == NULL ||
+     !bOpenFile(&fpMakefile, szMakefilePath, "r"))
+  {
+    vPrintErrorMessage(_("Impossible open the file %s"), szMakefilePath);
+
+    free(pszContent);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(fread(pszContent, 1, stFileStat.st_size, fpMakefile) != (size_t) stFileStat.st_size)
+  {
+    vPrintErrorMessage(_("Impossible read the file %s"), szMakefilePath);
+
+    bCloseFile(&fpMakefile);
+    free(pszContent);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  bCloseFile(&fpMakefile);
+
+  /* The last line of the first OBJ... list (or of the first SRC... list) */
+  for(pszLine = pszContent; *pszLine != '\0'; pszLine = *pszLineEnd != '\0' ? pszLineEnd + 1 : pszLineEnd)
+  {
+    pszLineEnd = pszLine + strcspn(pszLine, "\n");
+
+    if((lNameLen = lGetAssignedVariable(pszLine)) == 0 ||
+       (strncmp(pszLine, "OBJ", 3) != 0 && strncmp(pszLine, "SRC", 3) != 0))
+    {
+      continue;
+    }
+
+    /* make finds the .c files by itself */
+    if(memmem(pszLine, pszLineEnd - pszLine, "$(wildcard", 10) != NULL)
+    {
+      vPrintVerbose(_("The %s builds every .c file, it was not changed\n"), szMakefilePath);
+
+      free(pszContent);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end (wildcard)"), __func__);
+
+      return 0;
+    }
+
+    if(pszInsert != NULL && (bObjList || strncmp(pszLine, "SRC", 3) == 0))
+    {
+      continue;
+    }
+
+    pszLastLine = pszLine;
+    bMultiLine = false;
+
+    while(pszLineEnd > pszLastLine && pszLineEnd[-1] == '\\' && *pszLineEnd != '\0')
+    {
+      pszLastLine = pszLineEnd + 1;
+      pszLineEnd = pszLastLine + strcspn(pszLastLine, "\n");
+      bMultiLine = true;
+    }
+
+    /* Last file of the list */
+    for(pszTokenEnd = pszLineEnd; pszTokenEnd > pszLine && isspace((unsigned char) pszTokenEnd[-1]); pszTokenEnd--);
+
+    if(pszTokenEnd - pszLine < 2 || pszTokenEnd[-2] != '.' || (pszTokenEnd[-1] != 'o' && pszTokenEnd[-1] != 'c'))
+    {
+      continue;
+    }
+
+    for(pszTokenName = pszTokenEnd; pszTokenName > pszLine && !isspace((unsigned char) pszTokenName[-1]) &&
+                                    pszTokenName[-1] != '=' && pszTokenName[-1] != '/'; pszTokenName--);
+    for(pszToken = pszTokenName; pszToken > pszLine && !isspace((unsigned char) pszToken[-1]) &&
+                                 pszToken[-1] != '='; pszToken--);
+
+    /* The same directory and extension of the last file, with the name of the module */
+    snprintf(szNewToken, sizeof(szNewToken), "%.*s%s%.2s", (int) (pszTokenName - pszToken), pszToken,
+             kpszModuleName, pszTokenEnd - 2);
+
+    for(lIndentLen = 0; pszLastLine[lIndentLen] == ' ' || pszLastLine[lIndentLen] == '\t'; lIndentLen++);
+
+    pszInsert = pszTokenEnd;
+    pszListLastLine = pszLastLine;
+    bListMultiLine = bMultiLine;
+    bObjList = pszTokenEnd[-1] == 'o';
+  }
+
+  if(pszInsert == NULL)
+  {
+    printf(_("The %s doesn't list the files, add src/%s.c to it\n"), szMakefilePath, kpszModuleName);
+
+    free(pszContent);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (without list)"), __func__);
+
+    return 0;
+  }
+
+  /* Only the list changes, the objects of the other files stay valid */
+  if(!bOpenFile(&fpMakefile, szTmpPath, "w"))
+  {
+    vPrintErrorMessage(_("Impossible open the file %s"), szTmpPath);
+
+    free(pszContent);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  fwrite(pszContent, 1, pszInsert - pszContent, fpMakefile);
+
+  if(bListMultiLine)
+  {
+    fprintf(fpMakefile, " \\\n%.*s%s", (int) lIndentLen, pszListLastLine, szNewToken);
+  }
+  else
+  {
+    fprintf(fpMakefile, " %s", szNewToken);
+  }
+
+  fputs(pszInsert, fpMakefile);
+  fchmod(fileno(fpMakefile), stFileStat.st_mode & 0777);
+
+  if(!bCloseFile(&fpMakefile) || rename(szTmpPath, szMakefilePath) != 0)
+  {
+    vPrintErrorMessage(_("Impossible write the file %s: %s"), szMakefilePath, strerror(errno));
+
+    unlink(szTmpPath);
+
+    iRsl = -1;
+  }
+  else
+  {
+    vPrintVerbose(_("Added %s to %s\n"), szNewToken, szMakefilePath);
+  }
+
+  free(pszContent);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iAddModule(const char *kpszModuleName, const char *kpszProjectPathDir)
+{
+  struct stat stFileStat;
+  char szPath[sizeof(gszFullNewProjectPathDir) + _MAX_PATH];
+  char szProjectDir[sizeof(gszFullNewProjectPathDir)];
+  int ii;
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szPath, 0, sizeof(szPath));
+  memset(szProjectDir, 0, sizeof(szProjectDir));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(!bIsValidModuleName(kpszModuleName))
+  {
+    vPrintErrorMessage(_("Invalid name of module: %s (letters, digits and _)"), kpszModuleName);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(stat(kpszProjectPathDir, &stFileStat) != 0 || !S_ISDIR(stFileStat.st_mode))
+  {
+    vPrintErrorMessage(_("%s is not a directory"), kpszProjectPathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  snprintf(szProjectDir, sizeof(szProjectDir), "%s", kpszProjectPathDir);
+
+  for(ii = strlen(szProjectDir); ii > 1 && szProjectDir[ii - 1] == '/'; ii--)
+  {
+    szProjectDir[ii - 1] = '\0';
+  }
+
+  /**
+   * The banner has the author, the description and the license of
+   * the project. It also sets gszFullNewProjectPathDir, the base of
+   * the paths of the new files.
+   */
+  if(!bLoadProjectInfo(szProjectDir))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(strcmp(kpszModuleName, gstCmdLine.szProjName) == 0)
+  {
+    vPrintErrorMessage(_("%s is the name of the project"), kpszModuleName);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  snprintf(szPath, sizeof(szPath), "%s/src/%s.c", gszFullNewProjectPathDir, kpszModuleName);
+
+  if(access(szPath, F_OK) != 0)
+  {
+    snprintf(szPath, sizeof(szPath), "%s/include/%s.h", gszFullNewProjectPathDir, kpszModuleName);
+  }
+
+  if(access(szPath, F_OK) == 0)
+  {
+    vPrintErrorMessage(_("The file %s already exists"), szPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* The manifest of the project gets the files of the module */
+  snprintf(szPath, sizeof(szPath), "%s/%s", gszFullNewProjectPathDir, MANIFEST_FILE);
+  gbManifest = gbManifest || access(szPath, F_OK) == 0;
+
+  if(iCreateModuleHeader(kpszModuleName) != 0 || iCreateModuleSource(kpszModuleName) != 0 ||
+     iAddModuleToMakefile(kpszModuleName) != 0 || (gbManifest && iWriteManifest() != 0))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  printf(_("Added the module %s to the project %s\n"), kpszModuleName, gstCmdLine.szProjName);
+
+  if(gbUnityBuild)
+  {
+    printf(_("The next \"make UNITY=1\" adds src/%s.c to the unity build\n"), kpszModuleName);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
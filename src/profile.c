@@ -0,0 +1,318 @@
+/**
+ * profile.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Profile of the developer, saved once and used
+ *              by the next projects without ask it again
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "profile.h"
+
+STRUCT_PROFILE gstProfile;
+
+void vGetConfigPath(char *pszPath, size_t lPathSize, const char *kpszRelativePath)
+{
+  const char *kpszConfigHome = getenv("XDG_CONFIG_HOME");
+
+  if(kpszConfigHome != NULL && *kpszConfigHome == '/')
+  {
+    snprintf(pszPath, lPathSize, "%s/%s", kpszConfigHome, kpszRelativePath);
+  }
+  else
+  {
+    snprintf(pszPath, lPathSize, "%s/.config/%s", HOME, kpszRelativePath);
+  }
+}
+
+bool bReadProfile(const char *kpszProfilePath)
+{
+  FILE *fpProfile = NULL;
+  char *pszValue = NULL;
+  char *pszEnd = NULL;
+  char szLine[4096];
+
+  memset(szLine, 0, sizeof(szLine));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* The profile is optional */
+  if((fpProfile = fopen(kpszProfilePath, "r")) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (%s not found)"), __func__, kpszProfilePath);
+
+    return false;
+  }
+
+  /* KEY = value */
+  while(fgets(szLine, sizeof(szLine), fpProfile) != NULL)
+  {
+    szLine[strcspn(szLine, "\r\n")] = '\0';
+
+    if(szLine[0] == '#' || (pszValue = strchr(szLine, '=')) == NULL)
+    {
+      continue;
+    }
+
+    /* Trim the key and the value */
+    for(pszEnd = pszValue; pszEnd > szLine && (pszEnd[-1] == ' ' || pszEnd[-1] == '\t'); pszEnd--);
+    *pszEnd = '\0';
+    for(pszValue++; *pszValue == ' ' || *pszValue == '\t'; pszValue++);
+
+    if(strcmp(szLine, "DEV_NAME") == 0)
+    {
+      snprintf(gstProfile.szDevName, sizeof(gstProfile.szDevName), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "DEV_MAIL") == 0)
+    {
+      snprintf(gstProfile.szDevMail, sizeof(gstProfile.szDevMail), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "LICENSE") == 0)
+    {
+      snprintf(gstProfile.szLicense, sizeof(gstProfile.szLicense), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "TEMPLATE_DIR") == 0)
+    {
+      snprintf(gstProfile.szTemplateDir, sizeof(gstProfile.szTemplateDir), "%s", pszValue);
+    }
+    else if(strcmp(szLine, "PROJECTS_DIR") == 0)
+    {
+      snprintf(gstProfile.szProjectsDir, sizeof(gstProfile.szProjectsDir), "%s", pszValue);
+    }
+  }
+
+  fclose(fpProfile);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+bool bReadGitConfigUser(const char *kpszGitConfigPath)
+{
+  FILE *fpGitConfig = NULL;
+  bool bUserSection = false;
+  bool bInQuotes = false;
+  char *pszKey = NULL;
+  char *pszValue = NULL;
+  char *pszEnd = NULL;
+  char *pszRead = NULL;
+  char *pszWrite = NULL;
+  char szLine[4096];
+
+  memset(szLine, 0, sizeof(szLine));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if((fpGitConfig = fopen(kpszGitConfigPath, "r")) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (%s not found)"), __func__, kpszGitConfigPath);
+
+    return false;
+  }
+
+  while(fgets(szLine, sizeof(szLine), fpGitConfig) != NULL)
+  {
+    szLine[strcspn(szLine, "\r\n")] = '\0';
+
+    for(pszKey = szLine; *pszKey == ' ' || *pszKey == '\t'; pszKey++);
+
+    /* [user], [core], [remote "origin"], ... */
+    if(*pszKey == '[')
+    {
+      bUserSection = strncasecmp(pszKey, "[user]", 6) == 0;
+      continue;
+    }
+
+    if(!bUserSection || (pszValue = strchr(pszKey, '=')) == NULL)
+    {
+      continue;
+    }
+
+    for(pszEnd = pszValue; pszEnd > pszKey && (pszEnd[-1] == ' ' || pszEnd[-1] == '\t'); pszEnd--);
+    *pszEnd = '\0';
+    for(pszValue++; *pszValue == ' ' || *pszValue == '\t'; pszValue++);
+
+    /* Remove the quotes and the comments (# or ;) out of the quotes */
+    bInQuotes = false;
+
+    for(pszRead = pszWrite = pszValue; *pszRead != '\0'; pszRead++)
+    {
+      if(*pszRead == '"')
+      {
+        bInQuotes = !bInQuotes;
+        continue;
+      }
+
+      if(!bInQuotes && (*pszRead == '#' || *pszRead == ';'))
+      {
+        break;
+      }
+
+      *pszWrite++ = *pszRead;
+    }
+
+    for(; pszWrite > pszValue && (pszWrite[-1] == ' ' || pszWrite[-1] == '\t'); pszWrite--);
+    *pszWrite = '\0';
+
+    /* The first file read has precedence */
+    if(strcasecmp(pszKey, "name") == 0 && bStrIsEmpty(gstProfile.szDevName))
+    {
+      snprintf(gstProfile.szDevName, sizeof(gstProfile.szDevName), "%s", pszValue);
+    }
+    else if(strcasecmp(pszKey, "email") == 0 && bStrIsEmpty(gstProfile.szDevMail))
+    {
+      snprintf(gstProfile.szDevMail, sizeof(gstProfile.szDevMail), "%s", pszValue);
+    }
+  }
+
+  fclose(fpGitConfig);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+int iLoadProfile(void)
+{
+  static bool bLoaded = false;
+  char szPath[_MAX_PATH + 64];
+
+  memset(szPath, 0, sizeof(szPath));
+
+  if(bLoaded)
+  {
+    return 0;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  bLoaded = true;
+
+  vGetConfigPath(szPath, sizeof(szPath), PROFILE_DIR "/" PROFILE_FILE);
+  bReadProfile(szPath);
+
+  /* Same order of precedence of git: ~/.gitconfig, then $XDG_CONFIG_HOME/git/config */
+  if(bStrIsEmpty(gstProfile.szDevName) || bStrIsEmpty(gstProfile.szDevMail))
+  {
+    snprintf(szPath, sizeof(szPath), "%s/.gitconfig", HOME);
+    bReadGitConfigUser(szPath);
+
+    vGetConfigPath(szPath, sizeof(szPath), "git/config");
+    bReadGitConfigUser(szPath);
+  }
+
+  /* The command line has precedence over the profile */
+  if(bStrIsEmpty(gstCmdLine.szDevName))
+  {
+    snprintf(gstCmdLine.szDevName, sizeof(gstCmdLine.szDevName), "%s", gstProfile.szDevName);
+  }
+
+  if(bStrIsEmpty(gstCmdLine.szDevMail))
+  {
+    snprintf(gstCmdLine.szDevMail, sizeof(gstCmdLine.szDevMail), "%s", gstProfile.szDevMail);
+  }
+
+  if(bStrIsEmpty(gstCmdLine.szLicense))
+  {
+    snprintf(gstCmdLine.szLicense, sizeof(gstCmdLine.szLicense), "%s", gstProfile.szLicense);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iSaveProfile(const char *kpszTemplateDir)
+{
+  FILE *fpProfile = NULL;
+  char szPath[_MAX_PATH + 64];
+
+  memset(szPath, 0, sizeof(szPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  vGetConfigPath(szPath, sizeof(szPath), "");
+  mkdir(szPath, 0755);
+
+  vGetConfigPath(szPath, sizeof(szPath), PROFILE_DIR);
+  mkdir(szPath, 0755);
+
+  vGetConfigPath(szPath, sizeof(szPath), PROFILE_DIR "/" PROFILE_FILE);
+
+  /* "x": never overwrite a profile edited by the developer */
+  if((fpProfile = fopen(szPath, "wx")) == NULL)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (%s not saved: %s)"), __func__, szPath, strerror(errno));
+
+    return errno == EEXIST ? 0 : -1;
+  }
+
+  fprintf(fpProfile,
+      "# Profile of the developer used by %s, the command\n"
+      "# line options have precedence over these values\n"
+      "DEV_NAME = %s\n"
+      "DEV_MAIL = %s\n"
+      "LICENSE = %s\n"
+      "PROJECTS_DIR = %s\n", gkpszProgramName, gstCmdLine.szDevName,
+                             gstCmdLine.szDevMail, gstCmdLine.szLicense,
+                             gszProjectsPathDir
+  );
+
+  /* A -T or -A of this run isn't the template of the next projects */
+  if(!bStrIsEmpty(kpszTemplateDir))
+  {
+    fprintf(fpProfile, "TEMPLATE_DIR = %s\n", kpszTemplateDir);
+  }
+
+  if(fclose(fpProfile) != 0)
+  {
+    vPrintErrorMessage(_("Impossible write the file %s: %s"), szPath, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  vPrintVerbose(_("Saved the profile %s\n"), szPath);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+bool bRequiredProjInfoExist(bool bPrintMissing)
+{
+  bool bExist = true;
+  int ii;
+  struct
+  {
+    const char *kpszValue;
+    const char *kpszOption;
+  } astRequired[] = {
+    { gstCmdLine.szProjName       , "--project-name"        },
+    { gstCmdLine.szDevName        , "--dev-name"            },
+    { gstCmdLine.szDevMail        , "--dev-email"           },
+    { gstCmdLine.szProjDescription, "--project-description" }
+  };
+
+  for(ii = 0; ii < (int) (sizeof(astRequired) / sizeof(astRequired[0])); ii++)
+  {
+    if(!bStrIsEmpty(astRequired[ii].kpszValue))
+    {
+      continue;
+    }
+
+    bExist = false;
+
+    if(bPrintMissing)
+    {
+      vPrintErrorMessage(_("Missing %s"), astRequired[ii].kpszOption);
+    }
+  }
+
+  return bExist;
+}
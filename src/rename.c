@@ -0,0 +1,901 @@
+/**
+ * rename.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Rename a project created by mkcproj (--rename),
+ *              its files and the name in the content of them
+ *
+ * Date: 19/10/2026
+ */
+
+/* memmem() */
+#define _GNU_SOURCE
+
+#include "cmdline.h"
+#include "manifest.h"
+#include "rename.h"
+
+bool bIsRenameIgnored(const char *kpszRelativePath, const char *kpszName, bool bDir)
+{
+  size_t lNameLen = strlen(kpszName);
+  bool bTopLevel = strchr(kpszRelativePath, '/') == NULL;
+
+  /* The information of the project has the name too */
+  if(bTopLevel && !bDir && strcmp(kpszName, PROJECT_INFO_FILE) == 0)
+  {
+    return false;
+  }
+
+  /* ".", "..", .git, the manifest (updated at the end), ... */
+  if(kpszName[0] == '.')
+  {
+    return true;
+  }
+
+  /* What "make distclean" removes */
+  if(bTopLevel && bDir && (strcmp(kpszName, "obj") == 0 || strcmp(kpszName, "bin") == 0))
+  {
+    return true;
+  }
+
+  if(bTopLevel && !bDir && lNameLen > 4 && strcmp(kpszName + lNameLen - 4, ".log") == 0)
+  {
+    return true;
+  }
+
+  /* Files of other mkcproj that is writing in the project */
+  if(!bDir && lNameLen > strlen(TMP_FILE_SUFFIX) &&
+     strcmp(kpszName + lNameLen - strlen(TMP_FILE_SUFFIX), TMP_FILE_SUFFIX) == 0)
+  {
+    return true;
+  }
+
+  return false;
+}
+
+const char *kpszFindName(const char *kpszBegin, const char *kpszStart, const char *kpszEnd,
+                         const char *kpszName, size_t lNameLen)
+{
+  const char *kpszFound = kpszStart;
+
+  while(kpszFound < kpszEnd &&
+        (kpszFound = memmem(kpszFound, kpszEnd - kpszFound, kpszName, lNameLen)) != NULL)
+  {
+    if((kpszFound == kpszBegin || !isalnum((unsigned char) kpszFound[-1])) &&
+       (kpszFound + lNameLen == kpszEnd || !isalnum((unsigned char) kpszFound[lNameLen])))
+    {
+      return kpszFound;
+    }
+
+    kpszFound++;
+  }
+
+  return NULL;
+}
+
+int iWriteNewName(FILE *fpFile, const char *kpszContent, size_t lSize, PSTRUCT_RENAME_QUEUE pstQueue)
+{
+  const char *kpszBegin = kpszContent;
+  const char *kpszEnd = kpszContent + lSize;
+  const char *kpszLower = NULL;
+  const char *kpszUpper = NULL;
+  size_t lNameLen = strlen(pstQueue->szOldName);
+  bool bSearchUpper = strcmp(pstQueue->szOldName, pstQueue->szUpperOldName) != 0;
+
+  kpszLower = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szOldName, lNameLen);
+
+  if(bSearchUpper)
+  {
+    kpszUpper = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szUpperOldName, lNameLen);
+  }
+
+  /* Each search runs again only when its match was consumed */
+  while(kpszLower != NULL || kpszUpper != NULL)
+  {
+    if(kpszLower != NULL && (kpszUpper == NULL || kpszLower < kpszUpper))
+    {
+      fwrite(kpszContent, 1, kpszLower - kpszContent, fpFile);
+      fputs(pstQueue->szNewName, fpFile);
+      kpszContent = kpszLower + lNameLen;
+    }
+    else
+    {
+      fwrite(kpszContent, 1, kpszUpper - kpszContent, fpFile);
+      fputs(pstQueue->szUpperNewName, fpFile);
+      kpszContent = kpszUpper + lNameLen;
+    }
+
+    if(kpszLower != NULL && kpszLower < kpszContent)
+    {
+      kpszLower = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szOldName, lNameLen);
+    }
+
+    if(kpszUpper != NULL && kpszUpper < kpszContent)
+    {
+      kpszUpper = kpszFindName(kpszBegin, kpszContent, kpszEnd, pstQueue->szUpperOldName, lNameLen);
+    }
+  }
+
+  fwrite(kpszContent, 1, kpszEnd - kpszContent, fpFile);
+
+  return ferror(fpFile) ? -1 : 0;
+}
+
+void vGetNewPath(const char *kpszRelativePath, char *pszNewPath, size_t lNewPathSize,
+                 PSTRUCT_RENAME_QUEUE pstQueue)
+{
+  FILE *fpPath = NULL;
+
+  memset(pszNewPath, 0, lNewPathSize);
+
+  if((fpPath = fmemopen(pszNewPath, lNewPathSize, "w")) == NULL)
+  {
+    snprintf(pszNewPath, lNewPathSize, "%s", kpszRelativePath);
+
+    return;
+  }
+
+  /* The buffer of fmemopen is the path, without the last byte for the '\0' */
+  setvbuf(fpPath, NULL, _IONBF, 0);
+
+  iWriteNewName(fpPath, kpszRelativePath, strlen(kpszRelativePath), pstQueue);
+
+  fclose(fpPath);
+
+  pszNewPath[lNewPathSize - 1] = '\0';
+}
+
+bool bPushRenameJob(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath, bool bDir)
+{
+  PSTRUCT_RENAME_JOB pastTmp = NULL;
+  PSTRUCT_RENAME_JOB pstJob = NULL;
+
+  if(pstQueue->iJobsCount == pstQueue->iJobsAlloc)
+  {
+    pstQueue->iJobsAlloc = pstQueue->iJobsAlloc == 0 ? 256 : pstQueue->iJobsAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_RENAME_JOB) realloc(pstQueue->pastJobs,
+                                               pstQueue->iJobsAlloc * sizeof(STRUCT_RENAME_JOB))) == NULL)
+    {
+      pstQueue->iJobsAlloc = pstQueue->iJobsCount;
+
+      return false;
+    }
+
+    pstQueue->pastJobs = pastTmp;
+  }
+
+  pstJob = &pstQueue->pastJobs[pstQueue->iJobsCount++];
+
+  snprintf(pstJob->szRelativePath, sizeof(pstJob->szRelativePath), "%s", kpszRelativePath);
+  pstJob->bDir = bDir;
+
+  pstQueue->iPending++;
+
+  return true;
+}
+
+bool bPushRenamedFile(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath, const char *kpszNewRelativePath,
+                      uint64_t ui64OldHash, uint64_t ui64NewHash, bool bDir)
+{
+  PSTRUCT_RENAMED_FILE pastTmp = NULL;
+  PSTRUCT_RENAMED_FILE pstRenamed = NULL;
+
+  if(pstQueue->iRenamedCount == pstQueue->iRenamedAlloc)
+  {
+    pstQueue->iRenamedAlloc = pstQueue->iRenamedAlloc == 0 ? 64 : pstQueue->iRenamedAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_RENAMED_FILE) realloc(pstQueue->pastRenamed,
+                                                 pstQueue->iRenamedAlloc * sizeof(STRUCT_RENAMED_FILE))) == NULL)
+    {
+      pstQueue->iRenamedAlloc = pstQueue->iRenamedCount;
+
+      return false;
+    }
+
+    pstQueue->pastRenamed = pastTmp;
+  }
+
+  pstRenamed = &pstQueue->pastRenamed[pstQueue->iRenamedCount++];
+
+  snprintf(pstRenamed->szRelativePath, sizeof(pstRenamed->szRelativePath), "%s", kpszRelativePath);
+  snprintf(pstRenamed->szNewRelativePath, sizeof(pstRenamed->szNewRelativePath), "%s", kpszNewRelativePath);
+  pstRenamed->ui64OldHash = ui64OldHash;
+  pstRenamed->ui64NewHash = ui64NewHash;
+  pstRenamed->bDir = bDir;
+
+  return true;
+}
+
+int iRenameDir(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath)
+{
+  DIR *pDir = NULL;
+  struct dirent *pstEntry = NULL;
+  struct stat stFileStat;
+  bool bDir = false;
+  bool bPushed = false;
+  int iRsl = 0;
+  ssize_t lLinkLen = 0;
+  char szDirPath[sizeof(pstQueue->szProjectDir) + _MAX_PATH + 2];
+  char szRelativePath[_MAX_PATH];
+  char szNewRelativePath[_MAX_PATH];
+  char szNewName[_MAX_PATH];
+  char szTmpName[_MAX_PATH + 32];
+  char szLink[_MAX_PATH];
+  char szNewLink[_MAX_PATH];
+
+  memset(szDirPath, 0, sizeof(szDirPath));
+  memset(szRelativePath, 0, sizeof(szRelativePath));
+  memset(szNewRelativePath, 0, sizeof(szNewRelativePath));
+  memset(szNewName, 0, sizeof(szNewName));
+  memset(szTmpName, 0, sizeof(szTmpName));
+  memset(szLink, 0, sizeof(szLink));
+  memset(szNewLink, 0, sizeof(szNewLink));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szDirPath, sizeof(szDirPath), "%s%s%s", pstQueue->szProjectDir,
+           bStrIsEmpty(kpszRelativePath) ? "" : "/", kpszRelativePath);
+
+  if((pDir = opendir(szDirPath)) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the directory %s: %s"), szDirPath, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  while((pstEntry = readdir(pDir)) != NULL)
+  {
+    if(snprintf(szRelativePath, sizeof(szRelativePath), "%s%s%s", kpszRelativePath,
+                bStrIsEmpty(kpszRelativePath) ? "" : "/", pstEntry->d_name) >= (int) sizeof(szRelativePath))
+    {
+      vPrintErrorMessage(_("Path too long: %s/%s"), szDirPath, pstEntry->d_name);
+
+      iRsl = -1;
+      continue;
+    }
+
+    /* d_type saves the stat of most of the entries */
+    if(pstEntry->d_type == DT_UNKNOWN)
+    {
+      if(fstatat(dirfd(pDir), pstEntry->d_name, &stFileStat, AT_SYMLINK_NOFOLLOW) != 0)
+      {
+        continue;
+      }
+
+      bDir = S_ISDIR(stFileStat.st_mode);
+    }
+    else
+    {
+      bDir = pstEntry->d_type == DT_DIR;
+    }
+
+    if(bIsRenameIgnored(szRelativePath, pstEntry->d_name, bDir))
+    {
+      continue;
+    }
+
+    vGetNewPath(pstEntry->d_name, szNewName, sizeof(szNewName), pstQueue);
+    vGetNewPath(szRelativePath, szNewRelativePath, sizeof(szNewRelativePath), pstQueue);
+
+    /* The links are created again, with the name of the project replaced in the target */
+    if(pstEntry->d_type == DT_LNK)
+    {
+      if((lLinkLen = readlinkat(dirfd(pDir), pstEntry->d_name, szLink, sizeof(szLink) - 1)) < 0)
+      {
+        continue;
+      }
+
+      szLink[lLinkLen] = '\0';
+      vGetNewPath(szLink, szNewLink, sizeof(szNewLink), pstQueue);
+
+      if(strcmp(szLink, szNewLink) == 0 && strcmp(pstEntry->d_name, szNewName) == 0)
+      {
+        continue;
+      }
+
+      snprintf(szTmpName, sizeof(szTmpName), "%s%s", szNewName, TMP_FILE_SUFFIX);
+
+      if(symlinkat(szNewLink, dirfd(pDir), szTmpName) != 0 ||
+         renameat(dirfd(pDir), szTmpName, dirfd(pDir), szNewName) != 0 ||
+         (strcmp(pstEntry->d_name, szNewName) != 0 && unlinkat(dirfd(pDir), pstEntry->d_name, 0) != 0))
+      {
+        vPrintErrorMessage(_("Impossible rename the link %s/%s: %s"), szDirPath, pstEntry->d_name, strerror(errno));
+
+        unlinkat(dirfd(pDir), szTmpName, 0);
+
+        iRsl = -1;
+      }
+
+      continue;
+    }
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    bPushed = bPushRenameJob(pstQueue, szRelativePath, bDir);
+
+    /* The directories are renamed after the walk, their files are read with the old path */
+    if(bPushed && bDir && strcmp(pstEntry->d_name, szNewName) != 0)
+    {
+      bPushed = bPushRenamedFile(pstQueue, szRelativePath, szNewRelativePath, 0, 0, true);
+    }
+
+    if(!bPushed)
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szRelativePath);
+
+      iRsl = -1;
+    }
+
+    pthread_cond_signal(&pstQueue->stCond);
+    pthread_mutex_unlock(&pstQueue->stMutex);
+  }
+
+  closedir(pDir);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iRenameFile(PSTRUCT_RENAME_QUEUE pstQueue, const char *kpszRelativePath)
+{
+  FILE *fpNewContent = NULL;
+  struct stat stFileStat;
+  const char *kpszSlash = strrchr(kpszRelativePath, '/');
+  const char *kpszBaseName = kpszSlash != NULL ? kpszSlash + 1 : kpszRelativePath;
+  char *pszContent = NULL;
+  char *pszNewContent = NULL;
+  size_t lNewSize = 0;
+  ssize_t lWritten = 0;
+  size_t lOffset = 0;
+  uint64_t ui64OldHash = 0;
+  uint64_t ui64NewHash = 0;
+  int iFd = -1;
+  int iRsl = 0;
+  bool bHasName = false;
+  bool bRenamed = false;
+  char szPath[sizeof(pstQueue->szProjectDir) + _MAX_PATH + 2];
+  char szNewName[_MAX_PATH];
+  char szNewPath[sizeof(szPath) + _MAX_PATH];
+  char szNewRelativePath[_MAX_PATH];
+  char szTmpPath[sizeof(szNewPath) + 32];
+
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szPath, 0, sizeof(szPath));
+  memset(szNewName, 0, sizeof(szNewName));
+  memset(szNewPath, 0, sizeof(szNewPath));
+  memset(szNewRelativePath, 0, sizeof(szNewRelativePath));
+  memset(szTmpPath, 0, sizeof(szTmpPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szPath, sizeof(szPath), "%s/%s", pstQueue->szProjectDir, kpszRelativePath);
+
+  /* Only the name of the file here, its directory is renamed at the end */
+  vGetNewPath(kpszBaseName, szNewName, sizeof(szNewName), pstQueue);
+  snprintf(szNewPath, sizeof(szNewPath), "%.*s%s", (int) (kpszBaseName - kpszRelativePath + strlen(pstQueue->szProjectDir) + 1),
+           szPath, szNewName);
+  snprintf(szTmpPath, sizeof(szTmpPath), "%s%s", szNewPath, TMP_FILE_SUFFIX);
+  vGetNewPath(kpszRelativePath, szNewRelativePath, sizeof(szNewRelativePath), pstQueue);
+
+  bRenamed = strcmp(kpszBaseName, szNewName) != 0;
+
+  if((iFd = open(szPath, O_RDONLY | O_CLOEXEC)) < 0 || fstat(iFd, &stFileStat) != 0)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), szPath, strerror(errno));
+
+    if(iFd >= 0)
+    {
+      close(iFd);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* FIFOs, sockets, devices, ... */
+  if(!S_ISREG(stFileStat.st_mode))
+  {
+    close(iFd);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return 0;
+  }
+
+  if(stFileStat.st_size > 0)
+  {
+    if((pszContent = mmap(NULL, stFileStat.st_size, PROT_READ, MAP_PRIVATE, iFd, 0)) == MAP_FAILED)
+    {
+      vPrintErrorMessage(_("Impossible map the file %s: %s"), szPath, strerror(errno));
+
+      close(iFd);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+
+    madvise(pszContent, stFileStat.st_size, MADV_SEQUENTIAL);
+
+    /* The binary files are only renamed */
+    bHasName = memchr(pszContent, '\0', stFileStat.st_size < RENAME_BINARY_CHECK_SIZE ?
+                                        stFileStat.st_size : RENAME_BINARY_CHECK_SIZE) == NULL &&
+               (kpszFindName(pszContent, pszContent, pszContent + stFileStat.st_size,
+                             pstQueue->szOldName, strlen(pstQueue->szOldName)) != NULL ||
+                kpszFindName(pszContent, pszContent, pszContent + stFileStat.st_size,
+                             pstQueue->szUpperOldName, strlen(pstQueue->szUpperOldName)) != NULL);
+  }
+
+  close(iFd);
+
+  if(!bHasName && !bRenamed)
+  {
+    if(pszContent != NULL)
+    {
+      munmap(pszContent, stFileStat.st_size);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (without the name)"), __func__);
+
+    return 0;
+  }
+
+  ui64OldHash = ui64HashXxh64(pszContent != NULL ? pszContent : "", stFileStat.st_size, 0);
+  ui64NewHash = ui64OldHash;
+
+  if(bRenamed && access(szNewPath, F_OK) == 0)
+  {
+    vPrintErrorMessage(_("The file %s already exists"), szNewPath);
+
+    iRsl = -1;
+  }
+  else if(!bHasName)
+  {
+    if(rename(szPath, szNewPath) != 0)
+    {
+      vPrintErrorMessage(_("Impossible rename the file %s: %s"), szPath, strerror(errno));
+
+      iRsl = -1;
+    }
+  }
+  else if((fpNewContent = open_memstream(&pszNewContent, &lNewSize)) == NULL ||
+          iWriteNewName(fpNewContent, pszContent, stFileStat.st_size, pstQueue) != 0 ||
+          fclose(fpNewContent) != 0)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the file %s"), szPath);
+
+    iRsl = -1;
+  }
+  else if((iFd = open(szTmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, stFileStat.st_mode & 0777)) < 0)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), szTmpPath, strerror(errno));
+
+    iRsl = -1;
+  }
+  else
+  {
+    ui64NewHash = ui64HashXxh64(pszNewContent, lNewSize, 0);
+
+    while(lOffset < lNewSize && (lWritten = write(iFd, pszNewContent + lOffset, lNewSize - lOffset)) > 0)
+    {
+      lOffset += lWritten;
+    }
+
+    /* open() applies the umask, the file keeps the mode of the old one */
+    fchmod(iFd, stFileStat.st_mode & 07777);
+
+    if(close(iFd) != 0 || lOffset != lNewSize || rename(szTmpPath, szNewPath) != 0 ||
+       (bRenamed && unlink(szPath) != 0))
+    {
+      vPrintErrorMessage(_("Impossible write the file %s: %s"), szNewPath, strerror(errno));
+
+      unlink(szTmpPath);
+
+      iRsl = -1;
+    }
+  }
+
+  free(pszNewContent);
+
+  if(pszContent != NULL)
+  {
+    munmap(pszContent, stFileStat.st_size);
+  }
+
+  if(iRsl == 0)
+  {
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(!bPushRenamedFile(pstQueue, kpszRelativePath, szNewRelativePath, ui64OldHash, ui64NewHash, false))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), kpszRelativePath);
+
+      iRsl = -1;
+    }
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+
+    vPrintVerbose(_("Renamed file %s\n"), szNewPath);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+void *pvRenameWorker(void *pvQueue)
+{
+  PSTRUCT_RENAME_QUEUE pstQueue = (PSTRUCT_RENAME_QUEUE) pvQueue;
+  STRUCT_RENAME_JOB stJob;
+  int iRsl = 0;
+
+  memset(&stJob, 0, sizeof(stJob));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  pthread_mutex_lock(&pstQueue->stMutex);
+
+  while(true)
+  {
+    /* Other thread can still add the entries of a directory */
+    while(pstQueue->iJobsCount == 0 && pstQueue->iPending > 0)
+    {
+      pthread_cond_wait(&pstQueue->stCond, &pstQueue->stMutex);
+    }
+
+    if(pstQueue->iPending == 0)
+    {
+      break;
+    }
+
+    stJob = pstQueue->pastJobs[--pstQueue->iJobsCount];
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+
+    iRsl = stJob.bDir ? iRenameDir(pstQueue, stJob.szRelativePath) :
+                        iRenameFile(pstQueue, stJob.szRelativePath);
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(iRsl != 0)
+    {
+      pstQueue->iErrors++;
+    }
+    else if(!stJob.bDir)
+    {
+      pstQueue->lFilesCount++;
+    }
+
+    /* The last job wakes up every thread to finish */
+    if(--pstQueue->iPending == 0)
+    {
+      pthread_cond_broadcast(&pstQueue->stCond);
+    }
+  }
+
+  pthread_mutex_unlock(&pstQueue->stMutex);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return NULL;
+}
+
+/**
+ * qsort() and bsearch() callback of the changed files, by the old path
+ */
+static int iCompareRenamedFiles(const void *kpvFirst, const void *kpvSecond)
+{
+  return strcmp(((const STRUCT_RENAMED_FILE *) kpvFirst)->szRelativePath,
+                ((const STRUCT_RENAMED_FILE *) kpvSecond)->szRelativePath);
+}
+
+/**
+ * The deepest directories are renamed first, while
+ * the path of their parent is still the old one
+ */
+static int iCompareRenamedDepth(const void *kpvFirst, const void *kpvSecond)
+{
+  return (int) strlen(((const STRUCT_RENAMED_FILE *) kpvSecond)->szRelativePath) -
+         (int) strlen(((const STRUCT_RENAMED_FILE *) kpvFirst)->szRelativePath);
+}
+
+int iUpdateRenamedManifest(PSTRUCT_RENAME_QUEUE pstQueue)
+{
+  STRUCT_MANIFEST stManifest;
+  STRUCT_RENAMED_FILE stKey;
+  PSTRUCT_RENAMED_FILE pstRenamed = NULL;
+  PSTRUCT_MANIFEST_ENTRY pstEntry = NULL;
+  FILE *fpManifest = NULL;
+  char szManifestPath[sizeof(pstQueue->szProjectDir) + 32];
+  char szTmpPath[sizeof(szManifestPath) + 32];
+  char szNewRelativePath[_MAX_PATH];
+  int iRsl = 0;
+  int ii;
+
+  memset(&stManifest, 0, sizeof(stManifest));
+  memset(&stKey, 0, sizeof(stKey));
+  memset(szManifestPath, 0, sizeof(szManifestPath));
+  memset(szTmpPath, 0, sizeof(szTmpPath));
+  memset(szNewRelativePath, 0, sizeof(szNewRelativePath));
+
+  snprintf(szManifestPath, sizeof(szManifestPath), "%s/%s", pstQueue->szProjectDir, MANIFEST_FILE);
+  snprintf(szTmpPath, sizeof(szTmpPath), "%s%s", szManifestPath, TMP_FILE_SUFFIX);
+
+  /* The project doesn't have a manifest */
+  if(access(szManifestPath, F_OK) != 0)
+  {
+    return 0;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(iReadManifest(pstQueue->szProjectDir, &stManifest) != 0)
+  {
+    free(stManifest.pastEntries);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  qsort(pstQueue->pastRenamed, pstQueue->iRenamedCount, sizeof(STRUCT_RENAMED_FILE), iCompareRenamedFiles);
+
+  for(ii = 0; ii < stManifest.iEntriesCount; ii++)
+  {
+    pstEntry = &stManifest.pastEntries[ii];
+
+    snprintf(stKey.szRelativePath, sizeof(stKey.szRelativePath), "%s", pstEntry->szRelativePath);
+
+    pstRenamed = (PSTRUCT_RENAMED_FILE) bsearch(&stKey, pstQueue->pastRenamed, pstQueue->iRenamedCount,
+                                                sizeof(STRUCT_RENAMED_FILE), iCompareRenamedFiles);
+
+    /* A file that was changed by the developer keeps failing in --verify */
+    if(pstRenamed != NULL && !pstRenamed->bDir && pstRenamed->ui64OldHash == pstEntry->ui64Hash)
+    {
+      pstEntry->ui64Hash = pstRenamed->ui64NewHash;
+    }
+
+    /* Files in a renamed directory are not in the list, only their path changes */
+    vGetNewPath(pstEntry->szRelativePath, szNewRelativePath, sizeof(szNewRelativePath), pstQueue);
+    snprintf(pstEntry->szRelativePath, sizeof(pstEntry->szRelativePath), "%s", szNewRelativePath);
+  }
+
+  qsort(stManifest.pastEntries, stManifest.iEntriesCount, sizeof(STRUCT_MANIFEST_ENTRY), iCompareManifestEntries);
+
+  if((fpManifest = fopen(szTmpPath, "w")) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), szTmpPath, strerror(errno));
+
+    free(stManifest.pastEntries);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  for(ii = 0; ii < stManifest.iEntriesCount; ii++)
+  {
+    fprintf(fpManifest, "%016llx  %s\n", (unsigned long long) stManifest.pastEntries[ii].ui64Hash,
+                                         stManifest.pastEntries[ii].szRelativePath);
+  }
+
+  if(fclose(fpManifest) != 0 || rename(szTmpPath, szManifestPath) != 0)
+  {
+    vPrintErrorMessage(_("Impossible write the file %s: %s"), szManifestPath, strerror(errno));
+
+    unlink(szTmpPath);
+
+    iRsl = -1;
+  }
+
+  free(stManifest.pastEntries);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iRenameProject(const char *kpszOldName, const char *kpszNewName, const char *kpszProjectPathDir)
+{
+  STRUCT_RENAME_QUEUE stQueue;
+  struct stat stFileStat;
+  pthread_t atThreads[RENAME_MAX_THREADS];
+  PSTRUCT_RENAMED_FILE pstRenamed = NULL;
+  const char *kpszBaseName = NULL;
+  char szPath[sizeof(stQueue.szProjectDir) + _MAX_PATH * 2];
+  char szNewPath[sizeof(stQueue.szProjectDir) + _MAX_PATH * 2];
+  char szNewName[_MAX_PATH];
+  long lThreadsCount = sysconf(_SC_NPROCESSORS_ONLN);
+  int iThreadsStarted = 0;
+  int iChanged = 0;
+  int iRsl = 0;
+  int ii;
+
+  memset(&stQueue, 0, sizeof(stQueue));
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szPath, 0, sizeof(szPath));
+  memset(szNewPath, 0, sizeof(szNewPath));
+  memset(szNewName, 0, sizeof(szNewName));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(bStrIsEmpty(kpszNewName) || strchr(kpszNewName, '/') != NULL || strcmp(kpszOldName, kpszNewName) == 0)
+  {
+    vPrintErrorMessage(_("Invalid new name of the project: %s"), kpszNewName);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(stat(kpszProjectPathDir, &stFileStat) != 0 || !S_ISDIR(stFileStat.st_mode))
+  {
+    vPrintErrorMessage(_("%s is not a directory"), kpszProjectPathDir);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  snprintf(stQueue.szProjectDir, sizeof(stQueue.szProjectDir), "%s", kpszProjectPathDir);
+  snprintf(stQueue.szOldName, sizeof(stQueue.szOldName), "%s", kpszOldName);
+  snprintf(stQueue.szNewName, sizeof(stQueue.szNewName), "%s", kpszNewName);
+
+  for(ii = strlen(stQueue.szProjectDir); ii > 1 && stQueue.szProjectDir[ii - 1] == '/'; ii--)
+  {
+    stQueue.szProjectDir[ii - 1] = '\0';
+  }
+
+  for(ii = 0; stQueue.szOldName[ii] != '\0'; ii++)
+  {
+    stQueue.szUpperOldName[ii] = toupper((unsigned char) stQueue.szOldName[ii]);
+  }
+
+  for(ii = 0; stQueue.szNewName[ii] != '\0'; ii++)
+  {
+    stQueue.szUpperNewName[ii] = toupper((unsigned char) stQueue.szNewName[ii]);
+  }
+
+  /* Every project has src/<name>.c, and the new one can't overwrite a file */
+  snprintf(szPath, sizeof(szPath), "%s/src/%s.c", stQueue.szProjectDir, stQueue.szOldName);
+  snprintf(szNewPath, sizeof(szNewPath), "%s/src/%s.c", stQueue.szProjectDir, stQueue.szNewName);
+
+  if(access(szPath, F_OK) != 0)
+  {
+    vPrintErrorMessage(_("%s is not the directory of the project %s (without %s)"),
+                       kpszProjectPathDir, kpszOldName, szPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  if(access(szNewPath, F_OK) == 0)
+  {
+    vPrintErrorMessage(_("The file %s already exists"), szNewPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  pthread_mutex_init(&stQueue.stMutex, NULL);
+  pthread_cond_init(&stQueue.stCond, NULL);
+
+  bPushRenameJob(&stQueue, "", true);
+
+  if(lThreadsCount < 1)
+  {
+    lThreadsCount = 1;
+  }
+  else if(lThreadsCount > RENAME_MAX_THREADS)
+  {
+    lThreadsCount = RENAME_MAX_THREADS;
+  }
+
+  for(ii = 0; ii < lThreadsCount; ii++)
+  {
+    if(pthread_create(&atThreads[ii], NULL, pvRenameWorker, &stQueue) != 0)
+    {
+      break;
+    }
+
+    iThreadsStarted++;
+  }
+
+  /* Without threads, the walk runs in this one */
+  if(iThreadsStarted == 0)
+  {
+    pvRenameWorker(&stQueue);
+  }
+
+  for(ii = 0; ii < iThreadsStarted; ii++)
+  {
+    pthread_join(atThreads[ii], NULL);
+  }
+
+  pthread_cond_destroy(&stQueue.stCond);
+  pthread_mutex_destroy(&stQueue.stMutex);
+
+  if(stQueue.iErrors > 0)
+  {
+    vPrintErrorMessage(_("Impossible rename %d files of %s"), stQueue.iErrors, kpszProjectPathDir);
+
+    iRsl = -1;
+  }
+
+  /* Before the directories, the manifest is read with the old paths */
+  if(iUpdateRenamedManifest(&stQueue) != 0)
+  {
+    iRsl = -1;
+  }
+
+  qsort(stQueue.pastRenamed, stQueue.iRenamedCount, sizeof(STRUCT_RENAMED_FILE), iCompareRenamedDepth);
+
+  for(ii = 0; ii < stQueue.iRenamedCount; ii++)
+  {
+    pstRenamed = &stQueue.pastRenamed[ii];
+
+    if(!pstRenamed->bDir)
+    {
+      iChanged++;
+      continue;
+    }
+
+    kpszBaseName = strrchr(pstRenamed->szRelativePath, '/');
+    kpszBaseName = kpszBaseName != NULL ? kpszBaseName + 1 : pstRenamed->szRelativePath;
+
+    vGetNewPath(kpszBaseName, szNewName, sizeof(szNewName), &stQueue);
+    snprintf(szPath, sizeof(szPath), "%s/%s", stQueue.szProjectDir, pstRenamed->szRelativePath);
+    snprintf(szNewPath, sizeof(szNewPath), "%s/%.*s%s", stQueue.szProjectDir,
+             (int) (kpszBaseName - pstRenamed->szRelativePath), pstRenamed->szRelativePath, szNewName);
+
+    if(rename(szPath, szNewPath) != 0)
+    {
+      vPrintErrorMessage(_("Impossible rename the directory %s: %s"), szPath, strerror(errno));
+
+      iRsl = -1;
+    }
+  }
+
+  free(stQueue.pastJobs);
+  free(stQueue.pastRenamed);
+
+  printf(_("Renamed the project %s to %s in %s (%d of %ld files changed)\n"), stQueue.szOldName,
+         stQueue.szNewName, stQueue.szProjectDir, iChanged, stQueue.lFilesCount);
+
+  /* The directory of the project has the name of the project */
+  kpszBaseName = strrchr(stQueue.szProjectDir, '/');
+  kpszBaseName = kpszBaseName != NULL ? kpszBaseName + 1 : stQueue.szProjectDir;
+
+  if(iRsl == 0 && strcmp(kpszBaseName, stQueue.szOldName) == 0)
+  {
+    snprintf(szNewPath, sizeof(szNewPath), "%.*s%s", (int) (kpszBaseName - stQueue.szProjectDir),
+             stQueue.szProjectDir, stQueue.szNewName);
+
+    if(access(szNewPath, F_OK) == 0)
+    {
+      vPrintErrorMessage(_("The directory %s already exists, the project stays in %s"), szNewPath, stQueue.szProjectDir);
+    }
+    else if(rename(stQueue.szProjectDir, szNewPath) != 0)
+    {
+      vPrintErrorMessage(_("Impossible rename the directory %s: %s"), stQueue.szProjectDir, strerror(errno));
+
+      iRsl = -1;
+    }
+    else
+    {
+      printf(_("Moved the project to %s\n"), szNewPath);
+    }
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
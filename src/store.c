@@ -0,0 +1,306 @@
+/**
+ * store.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Store of the files shared by the projects, each
+ *              distinct content is saved once and cloned or
+ *              linked in the projects (--dedup)
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "store.h"
+
+bool gbDedupStore = false;
+
+/**
+ * The file system of the store can clone the files, unknown
+ * until the first clone. Without clones only the files of
+ * DEDUP_LINK_FILES go to the store.
+ */
+static ENUM_STORE_CLONE geStoreClone = STORE_CLONE_UNKNOWN;
+static pthread_mutex_t gstStoreCloneMutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool bIsStoreTreeFile(const char *kpszPath)
+{
+  const char *kapszTreeDirs[] = STORE_TREE_DIRS;
+  const char *kpszRelativePath = kpszPath;
+  size_t lProjectPathLen = strlen(gszFullNewProjectPathDir);
+  int ii;
+
+  if(strncmp(kpszPath, gszFullNewProjectPathDir, lProjectPathLen) == 0 && kpszPath[lProjectPathLen] == '/')
+  {
+    kpszRelativePath = kpszPath + lProjectPathLen + 1;
+  }
+
+  for(ii = 0; kapszTreeDirs[ii] != NULL; ii++)
+  {
+    if(strncmp(kpszRelativePath, kapszTreeDirs[ii], strlen(kapszTreeDirs[ii])) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Get or set geStoreClone
+ */
+static ENUM_STORE_CLONE eGetStoreClone(void)
+{
+  ENUM_STORE_CLONE eClone;
+
+  pthread_mutex_lock(&gstStoreCloneMutex);
+  eClone = geStoreClone;
+  pthread_mutex_unlock(&gstStoreCloneMutex);
+
+  return eClone;
+}
+
+static void vSetStoreClone(ENUM_STORE_CLONE eClone)
+{
+  pthread_mutex_lock(&gstStoreCloneMutex);
+  geStoreClone = eClone;
+  pthread_mutex_unlock(&gstStoreCloneMutex);
+}
+
+uint64_t ui64HashContent(const char *kpszContent, size_t lSize)
+{
+  uint64_t ui64Hash = 0xcbf29ce484222325ULL;
+  size_t ii;
+
+  for(ii = 0; ii < lSize; ii++)
+  {
+    ui64Hash ^= (unsigned char) kpszContent[ii];
+    ui64Hash *= 0x100000001b3ULL;
+  }
+
+  return ui64Hash;
+}
+
+bool bFileHasContent(const char *kpszPath, const char *kpszContent, size_t lSize)
+{
+  FILE *fpFile = NULL;
+  bool bSame = true;
+  size_t lRead = 0;
+  size_t lOffset = 0;
+  char szBuffer[65536];
+
+  if((fpFile = fopen(kpszPath, "rb")) == NULL)
+  {
+    return false;
+  }
+
+  while(bSame && (lRead = fread(szBuffer, 1, sizeof(szBuffer), fpFile)) > 0)
+  {
+    bSame = lOffset + lRead <= lSize && memcmp(szBuffer, kpszContent + lOffset, lRead) == 0;
+    lOffset += lRead;
+  }
+
+  fclose(fpFile);
+
+  return bSame && lOffset == lSize;
+}
+
+bool bGetStoreFile(const char *kpszContent, size_t lSize, mode_t iMode,
+                   char *pszStorePath, size_t lStorePathSize, bool *pbCreated)
+{
+  FILE *fpStore = NULL;
+  uint64_t ui64Hash = ui64HashContent(kpszContent, lSize);
+  char szDir[sizeof(gszProjectsPathDir) + 64];
+  char szTmpPath[sizeof(gszProjectsPathDir) + 128];
+
+  memset(szDir, 0, sizeof(szDir));
+  memset(szTmpPath, 0, sizeof(szTmpPath));
+
+  *pbCreated = false;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* The store keeps the files read only, the mode is part of the key */
+  iMode = (iMode & 0777) & ~0222;
+
+  snprintf(szDir, sizeof(szDir), "%s/%s", gszProjectsPathDir, STORE_DIR);
+  mkdir(szDir, 0755);
+
+  snprintf(szDir, sizeof(szDir), "%s/%s/%02x", gszProjectsPathDir, STORE_DIR,
+                                               (unsigned int) (ui64Hash >> 56));
+  mkdir(szDir, 0755);
+
+  snprintf(pszStorePath, lStorePathSize, "%s/%016llx-%zu-%03o", szDir,
+                                         (unsigned long long) ui64Hash, lSize, (unsigned int) iMode);
+
+  /* The content is compared, so a collision of the hash is harmless */
+  if(access(pszStorePath, F_OK) == 0)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (%s already in the store)"), __func__, pszStorePath);
+
+    return bFileHasContent(pszStorePath, kpszContent, lSize);
+  }
+
+  /* Other mkcproj can save the same content at the same time */
+  snprintf(szTmpPath, sizeof(szTmpPath), "%s/%016llx.%d%s", szDir, (unsigned long long) ui64Hash,
+                                                            (int) getpid(), TMP_FILE_SUFFIX);
+
+  if((fpStore = fopen(szTmpPath, "wb")) == NULL)
+  {
+    if(DEBUG_DETAILS) vTraceWarning(_("Impossible create the file %s: %s"), szTmpPath, strerror(errno));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(fwrite(kpszContent, 1, lSize, fpStore) != lSize || fchmod(fileno(fpStore), iMode) != 0)
+  {
+    fclose(fpStore);
+    unlink(szTmpPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(fclose(fpStore) != 0 || rename(szTmpPath, pszStorePath) != 0)
+  {
+    unlink(szTmpPath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  *pbCreated = true;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
+
+bool bCloneFile(const char *kpszSrcPath, const char *kpszDestPath, mode_t iMode)
+{
+#ifdef FICLONE
+  int iSrcFd = -1;
+  int iDestFd = -1;
+  bool bCloned = false;
+
+  if((iSrcFd = open(kpszSrcPath, O_RDONLY)) < 0)
+  {
+    return false;
+  }
+
+  if((iDestFd = open(kpszDestPath, O_WRONLY | O_CREAT | O_TRUNC, iMode & 0777)) < 0)
+  {
+    close(iSrcFd);
+
+    return false;
+  }
+
+  /* Btrfs, XFS, ... other file systems return EOPNOTSUPP or EXDEV */
+  bCloned = ioctl(iDestFd, FICLONE, iSrcFd) == 0 && fchmod(iDestFd, iMode & 0777) == 0;
+
+  close(iSrcFd);
+
+  if(close(iDestFd) != 0)
+  {
+    bCloned = false;
+  }
+
+  if(!bCloned)
+  {
+    unlink(kpszDestPath);
+  }
+
+  return bCloned;
+#else
+  UNUSED(kpszSrcPath);
+  UNUSED(kpszDestPath);
+  UNUSED(iMode);
+
+  return false;
+#endif /* FICLONE */
+}
+
+bool bLinkStoreFile(const char *kpszPath, const char *kpszTmpPath, uint64_t ui64Flag,
+                    const char *kpszContent, size_t lSize, mode_t iMode)
+{
+  ENUM_STORE_CLONE eClone = eGetStoreClone();
+  bool bLink = (ui64Flag & DEDUP_LINK_FILES) || bIsStoreTreeFile(kpszPath);
+  bool bCreated = false;
+  bool bCloned = false;
+  char szStorePath[sizeof(gszProjectsPathDir) + 128];
+
+  memset(szStorePath, 0, sizeof(szStorePath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* Neither clone nor link, a copy in the store would be used by nobody */
+  if(!bLink && eClone == STORE_CLONE_UNSUPPORTED)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (the store can't clone)"), __func__);
+
+    return false;
+  }
+
+  if(!bGetStoreFile(kpszContent, lSize, iMode, szStorePath, sizeof(szStorePath), &bCreated))
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (store not available)"), __func__);
+
+    return false;
+  }
+
+  /**
+   * A clone is a new inode sharing the blocks of the store, so
+   * the developer can edit it. A hard link is the same inode of
+   * the store, then it is used only for the files nobody edits.
+   */
+  if(eClone != STORE_CLONE_UNSUPPORTED)
+  {
+    bCloned = bCloneFile(szStorePath, kpszTmpPath, iMode);
+
+    /* ext4, tmpfs, ... the next files don't try the clone again */
+    vSetStoreClone(bCloned ? STORE_CLONE_SUPPORTED : STORE_CLONE_UNSUPPORTED);
+  }
+
+  if(bCloned)
+  {
+    if(DEBUG_DETAILS) vTraceDebug(_("%s cloned from %s"), kpszPath, szStorePath);
+  }
+  else if(bLink && link(szStorePath, kpszTmpPath) == 0)
+  {
+    if(DEBUG_DETAILS) vTraceDebug(_("%s linked to %s"), kpszPath, szStorePath);
+  }
+  else
+  {
+    /* The file is written as usual, nothing uses the new entry */
+    if(bCreated)
+    {
+      unlink(szStorePath);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end (neither clone nor link)"), __func__);
+
+    return false;
+  }
+
+  if(rename(kpszTmpPath, kpszPath) != 0)
+  {
+    unlink(kpszTmpPath);
+
+    if(bCreated)
+    {
+      unlink(szStorePath);
+    }
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return false;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return true;
+}
@@ -0,0 +1,350 @@
+/**
+ * tar.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Read the template files from tar archives and
+ *              write the new projects as tar archives
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "tar.h"
+
+long lGetTarNumber(const char *kpszField, size_t lFieldLen)
+{
+  long lNumber = 0;
+  size_t ii;
+
+  for(ii = 0; ii < lFieldLen && (kpszField[ii] == ' ' || kpszField[ii] == '\0'); ii++);
+
+  for(; ii < lFieldLen && kpszField[ii] >= '0' && kpszField[ii] <= '7'; ii++)
+  {
+    lNumber = lNumber * 8 + (kpszField[ii] - '0');
+  }
+
+  return lNumber;
+}
+
+int iAddArchiveTemplateFile(const char *kpszRelativePath, mode_t iMode, char *pszContent, off_t lSize)
+{
+  PSTRUCT_TEMPLATE_FILE pastTmp = NULL;
+  PSTRUCT_TEMPLATE_FILE pstFile = NULL;
+
+  if(gstTemplateIndex.iFilesCount == gstTemplateIndex.iFilesAlloc)
+  {
+    gstTemplateIndex.iFilesAlloc = gstTemplateIndex.iFilesAlloc == 0 ? 64 : gstTemplateIndex.iFilesAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_TEMPLATE_FILE) realloc(gstTemplateIndex.pastFiles,
+                                                   gstTemplateIndex.iFilesAlloc * sizeof(STRUCT_TEMPLATE_FILE))) == NULL)
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the template index"));
+
+      return -1;
+    }
+
+    gstTemplateIndex.pastFiles = pastTmp;
+  }
+
+  pstFile = &gstTemplateIndex.pastFiles[gstTemplateIndex.iFilesCount++];
+
+  memset(pstFile, 0, sizeof(STRUCT_TEMPLATE_FILE));
+  snprintf(pstFile->szRelativePath, sizeof(pstFile->szRelativePath), "%s", kpszRelativePath);
+  pstFile->lSize = lSize;
+  pstFile->iMode = S_IFREG | (iMode & 0777);
+  pstFile->pszContent = pszContent;
+
+  if(DEBUG_DETAILS) vTraceAll("%s %o %ld", pstFile->szRelativePath, pstFile->iMode & 0777, (long) pstFile->lSize);
+
+  return 0;
+}
+
+void vStripArchiveTopDir(void)
+{
+  const char *kpszSlash = NULL;
+  size_t lPrefixLen = 0;
+  int ii;
+
+  if(gstTemplateIndex.iFilesCount == 0 ||
+     (kpszSlash = strchr(gstTemplateIndex.pastFiles[0].szRelativePath, '/')) == NULL)
+  {
+    return;
+  }
+
+  lPrefixLen = kpszSlash - gstTemplateIndex.pastFiles[0].szRelativePath + 1;
+
+  for(ii = 1; ii < gstTemplateIndex.iFilesCount; ii++)
+  {
+    if(strncmp(gstTemplateIndex.pastFiles[ii].szRelativePath,
+               gstTemplateIndex.pastFiles[0].szRelativePath, lPrefixLen) != 0)
+    {
+      return;
+    }
+  }
+
+  for(ii = 0; ii < gstTemplateIndex.iFilesCount; ii++)
+  {
+    memmove(gstTemplateIndex.pastFiles[ii].szRelativePath,
+            gstTemplateIndex.pastFiles[ii].szRelativePath + lPrefixLen,
+            strlen(gstTemplateIndex.pastFiles[ii].szRelativePath + lPrefixLen) + 1);
+  }
+}
+
+int iIndexTemplateArchive(const char *kpszArchivePath)
+{
+  gzFile gzArchive = NULL;
+  unsigned char aucHeader[TAR_BLOCK_SIZE];
+  char szLongName[_MAX_PATH];
+  char szRelativePath[TAR_BLOCK_SIZE];
+  char *pszContent = NULL;
+  char *pszName = NULL;
+  char *pszPaxPath = NULL;
+  long lSize = 0;
+  long lPadding = 0;
+  mode_t iMode = 0;
+  int iRsl = 0;
+  char chType;
+
+  memset(szLongName, 0, sizeof(szLongName));
+  memset(szRelativePath, 0, sizeof(szRelativePath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  /* gzopen() reads the .tar files without compression too */
+  if((gzArchive = gzopen(kpszArchivePath, "rb")) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), kpszArchivePath, strerror(errno));
+
+    if(DEBUG_DETAILS) vTraceFatal(_("Impossible open the file %s"), kpszArchivePath);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  gzbuffer(gzArchive, 128 * 1024);
+
+  while(gzread(gzArchive, aucHeader, TAR_BLOCK_SIZE) == TAR_BLOCK_SIZE)
+  {
+    /* The end of the archive is marked by empty blocks */
+    if(aucHeader[0] == '\0')
+    {
+      break;
+    }
+
+    if(memcmp(aucHeader + 257, "ustar", 5) != 0)
+    {
+      vPrintErrorMessage(_("%s isn't a tar archive"), kpszArchivePath);
+
+      iRsl = -1;
+      break;
+    }
+
+    chType = (char) aucHeader[156];
+    lSize = lGetTarNumber((const char *) aucHeader + 124, 12);
+    iMode = (mode_t) lGetTarNumber((const char *) aucHeader + 100, 8);
+    lPadding = (TAR_BLOCK_SIZE - lSize % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE;
+
+    /* Name: prefix (ustar) + name, or the name of the previous GNU 'L' or pax 'x' entry */
+    if(!bStrIsEmpty(szLongName))
+    {
+      snprintf(szRelativePath, sizeof(szRelativePath), "%s", szLongName);
+      memset(szLongName, 0, sizeof(szLongName));
+    }
+    else if(aucHeader[345] != '\0')
+    {
+      snprintf(szRelativePath, sizeof(szRelativePath), "%.155s/%.100s", aucHeader + 345, aucHeader);
+    }
+    else
+    {
+      snprintf(szRelativePath, sizeof(szRelativePath), "%.100s", aucHeader);
+    }
+
+    /* Only the data of the regular files and of the long names are kept */
+    if(chType == '0' || chType == '\0' || chType == 'L' || chType == 'x')
+    {
+      if((pszContent = (char *) malloc(lSize + 1)) == NULL ||
+         gzread(gzArchive, pszContent, lSize) != lSize)
+      {
+        vPrintErrorMessage(_("Impossible read %s from %s"), szRelativePath, kpszArchivePath);
+
+        free(pszContent);
+        iRsl = -1;
+        break;
+      }
+
+      pszContent[lSize] = '\0';
+    }
+    else if(lSize > 0 && gzseek(gzArchive, lSize, SEEK_CUR) < 0)
+    {
+      iRsl = -1;
+      break;
+    }
+
+    if(lPadding > 0 && gzseek(gzArchive, lPadding, SEEK_CUR) < 0)
+    {
+      free(pszContent);
+      iRsl = -1;
+      break;
+    }
+
+    if(chType == 'L')
+    {
+      snprintf(szLongName, sizeof(szLongName), "%s", pszContent);
+    }
+    else if(chType == 'x')
+    {
+      /* pax extended header: "<len> path=<name>\n" */
+      if((pszPaxPath = strstr(pszContent, " path=")) != NULL)
+      {
+        pszPaxPath += strlen(" path=");
+        pszPaxPath[strcspn(pszPaxPath, "\n")] = '\0';
+        snprintf(szLongName, sizeof(szLongName), "%s", pszPaxPath);
+      }
+    }
+    else if(chType == '0' || chType == '\0')
+    {
+      for(pszName = szRelativePath; strncmp(pszName, "./", 2) == 0; pszName += 2);
+
+      if(iAddArchiveTemplateFile(pszName, iMode, pszContent, lSize) != 0)
+      {
+        free(pszContent);
+        iRsl = -1;
+        break;
+      }
+
+      /* Now the content belongs to the index */
+      pszContent = NULL;
+    }
+
+    free(pszContent);
+    pszContent = NULL;
+  }
+
+  gzclose(gzArchive);
+
+  /* Archives of a directory: template/Makefile, template/src/template.c, ... */
+  vStripArchiveTopDir();
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+bool bWriteTarHeader(FILE *fpTar, const char *kpszPath, mode_t iMode, off_t lSize, char chType)
+{
+  unsigned char aucHeader[TAR_BLOCK_SIZE];
+  const char *kpszName = kpszPath;
+  unsigned int uiCheckSum = 0;
+  size_t lPathLen = strlen(kpszPath);
+  size_t lPrefixLen = 0;
+  int ii;
+
+  memset(aucHeader, 0, sizeof(aucHeader));
+
+  /* ustar: prefix (155) + '/' + name (100) */
+  if(lPathLen > 100)
+  {
+    for(kpszName = kpszPath + lPathLen - 101; kpszName < kpszPath + lPathLen && *kpszName != '/'; kpszName++);
+
+    lPrefixLen = kpszName - kpszPath;
+
+    if(*kpszName != '/' || lPrefixLen > 155)
+    {
+      vPrintErrorMessage(_("The path %s is too long to the tar archive"), kpszPath);
+
+      return false;
+    }
+
+    memcpy(aucHeader + 345, kpszPath, lPrefixLen);
+    kpszName++;
+  }
+
+  memcpy(aucHeader, kpszName, strlen(kpszName));
+  snprintf((char *) aucHeader + 100, 8, "%07o", (unsigned int) (iMode & 07777));
+  snprintf((char *) aucHeader + 108, 8, "%07o", 0);
+  snprintf((char *) aucHeader + 116, 8, "%07o", 0);
+  snprintf((char *) aucHeader + 124, 12, "%011lo", (unsigned long) lSize);
+  snprintf((char *) aucHeader + 136, 12, "%011lo", (unsigned long) time(NULL));
+  aucHeader[156] = (unsigned char) chType;
+  memcpy(aucHeader + 257, "ustar", 6);
+  memcpy(aucHeader + 263, "00", 2);
+
+  /* The check sum is calculated with its own field filled with spaces */
+  memset(aucHeader + 148, ' ', 8);
+
+  for(ii = 0; ii < TAR_BLOCK_SIZE; ii++)
+  {
+    uiCheckSum += aucHeader[ii];
+  }
+
+  snprintf((char *) aucHeader + 148, 8, "%06o", uiCheckSum);
+
+  return fwrite(aucHeader, TAR_BLOCK_SIZE, 1, fpTar) == 1;
+}
+
+bool bWriteTarFile(FILE *fpTar, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize)
+{
+  static const char kacPadding[TAR_BLOCK_SIZE];
+  size_t lPadding = (TAR_BLOCK_SIZE - lSize % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE;
+
+  if(!bWriteTarHeader(fpTar, kpszPath, iMode, lSize, TAR_TYPE_FILE))
+  {
+    return false;
+  }
+
+  if(lSize > 0 && fwrite(kpszContent, lSize, 1, fpTar) != 1)
+  {
+    return false;
+  }
+
+  return lPadding == 0 || fwrite(kacPadding, lPadding, 1, fpTar) == 1;
+}
+
+bool bWriteTarDir(FILE *fpTar, const char *kpszPath, mode_t iMode)
+{
+  char szPath[TAR_BLOCK_SIZE];
+
+  /* The name of the directories ends with '/' */
+  snprintf(szPath, sizeof(szPath), "%s/", kpszPath);
+
+  return bWriteTarHeader(fpTar, szPath, iMode, 0, TAR_TYPE_DIR);
+}
+
+bool bWriteTarEnd(FILE *fpTar)
+{
+  static const char kacEnd[2 * TAR_BLOCK_SIZE];
+
+  if(fwrite(kacEnd, sizeof(kacEnd), 1, fpTar) != 1)
+  {
+    return false;
+  }
+
+  return fflush(fpTar) == 0;
+}
+
+bool bWriteTarSinkDir(void *pvTar, const char *kpszPath, mode_t iMode)
+{
+  return bWriteTarDir((FILE *) pvTar, kpszPath, iMode);
+}
+
+bool bWriteTarSinkFile(void *pvTar, const char *kpszPath, mode_t iMode, const char *kpszContent, size_t lSize)
+{
+  return bWriteTarFile((FILE *) pvTar, kpszPath, iMode, kpszContent, lSize);
+}
+
+bool bFinishTarSink(void *pvTar)
+{
+  return bWriteTarEnd((FILE *) pvTar);
+}
+
+void vInitTarSink(PSTRUCT_OUTPUT_SINK pstSink, FILE *fpTar)
+{
+  memset(pstSink, 0, sizeof(STRUCT_OUTPUT_SINK));
+
+  pstSink->pbWriteDir = bWriteTarSinkDir;
+  pstSink->pbWriteFile = bWriteTarSinkFile;
+  pstSink->pbFinish = bFinishTarSink;
+  pstSink->pvData = fpTar;
+}
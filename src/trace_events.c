@@ -0,0 +1,193 @@
+/**
+ * trace_events.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *  
+ * Description: Record the "%s - begin" and "%s - end" messages
+ *              of the functions as spans of a Chrome trace-event
+ *              JSON file (--trace-events), opened in Perfetto or
+ *              chrome://tracing
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "trace_events.h"
+
+bool gbTraceEvents = false;
+
+STRUCT_TRACE_EVENTS gstTraceEvents = {
+  .stMutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+uint64_t ui64GetTimeNs(void)
+{
+  struct timespec stTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &stTime);
+
+  return (uint64_t) stTime.tv_sec * 1000000000ULL + (uint64_t) stTime.tv_nsec;
+}
+
+int iInitTraceEvents(const char *kpszFileName)
+{
+  FILE *fpEvents = NULL;
+
+  /* Fail now, not at the exit of the program */
+  if((fpEvents = fopen(kpszFileName, "w")) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), kpszFileName, strerror(errno));
+
+    return -1;
+  }
+
+  fclose(fpEvents);
+
+  snprintf(gstTraceEvents.szFileName, sizeof(gstTraceEvents.szFileName), "%s", kpszFileName);
+  gstTraceEvents.ui64StartNs = ui64GetTimeNs();
+
+  /* The functions call exit() on fatal errors */
+  atexit(vWriteTraceEvents);
+
+  gbTraceEvents = true;
+
+  return 0;
+}
+
+bool bIsTraceEventFormat(const char *kpszFmt, const char *kpszEvent)
+{
+  size_t lEventLen = strlen(kpszEvent);
+
+  /* "%s - end iRsl == %d" is an end, "%s - endpoint" isn't */
+  return strncmp(kpszFmt, kpszEvent, lEventLen) == 0 &&
+         (kpszFmt[lEventLen] == '\0' || kpszFmt[lEventLen] == ' ');
+}
+
+void vTraceEventsInfo(const char *kpszFmt, ...)
+{
+  va_list args;
+  char szMsg[4096];
+
+  if(gbTraceEvents)
+  {
+    if(bIsTraceEventFormat(kpszFmt, _(TRACE_EVENT_BEGIN)))
+    {
+      va_start(args, kpszFmt);
+      vAddTraceEvent(va_arg(args, const char *), 'B');
+      va_end(args);
+    }
+    else if(bIsTraceEventFormat(kpszFmt, _(TRACE_EVENT_END)))
+    {
+      va_start(args, kpszFmt);
+      vAddTraceEvent(va_arg(args, const char *), 'E');
+      va_end(args);
+    }
+  }
+
+  if(!bTraceInfoDetails())
+  {
+    return;
+  }
+
+  memset(szMsg, 0, sizeof(szMsg));
+
+  va_start(args, kpszFmt);
+  vsnprintf(szMsg, sizeof(szMsg), kpszFmt, args);
+  va_end(args);
+
+  vTraceInfo("%s", szMsg);
+}
+
+void vAddTraceEvent(const char *kpszName, char chPhase)
+{
+  PSTRUCT_TRACE_EVENT pastTmp = NULL;
+  PSTRUCT_TRACE_EVENT pstEvent = NULL;
+  uint64_t ui64TimeNs = ui64GetTimeNs();
+  int iThreadId = (int) syscall(SYS_gettid);
+
+  pthread_mutex_lock(&gstTraceEvents.stMutex);
+
+  if(gstTraceEvents.iEventsCount == gstTraceEvents.iEventsAlloc)
+  {
+    gstTraceEvents.iEventsAlloc = gstTraceEvents.iEventsAlloc == 0 ? 1024 : gstTraceEvents.iEventsAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_TRACE_EVENT) realloc(gstTraceEvents.pastEvents,
+                                                gstTraceEvents.iEventsAlloc * sizeof(STRUCT_TRACE_EVENT))) == NULL)
+    {
+      /* Lose the span, but not the program */
+      gstTraceEvents.iEventsAlloc = gstTraceEvents.iEventsCount;
+
+      pthread_mutex_unlock(&gstTraceEvents.stMutex);
+
+      return;
+    }
+
+    gstTraceEvents.pastEvents = pastTmp;
+  }
+
+  pstEvent = &gstTraceEvents.pastEvents[gstTraceEvents.iEventsCount++];
+
+  pstEvent->kpszName = kpszName;
+  pstEvent->chPhase = chPhase;
+  pstEvent->iThreadId = iThreadId;
+  pstEvent->ui64TimeNs = ui64TimeNs;
+
+  pthread_mutex_unlock(&gstTraceEvents.stMutex);
+}
+
+void vWriteTraceEvents(void)
+{
+  FILE *fpEvents = NULL;
+  PSTRUCT_TRACE_EVENT pstEvent = NULL;
+  int iProcessId = (int) getpid();
+  int ii;
+
+  if(!gbTraceEvents)
+  {
+    return;
+  }
+
+  gbTraceEvents = false;
+
+  pthread_mutex_lock(&gstTraceEvents.stMutex);
+
+  if((fpEvents = fopen(gstTraceEvents.szFileName, "w")) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible open the file %s: %s"), gstTraceEvents.szFileName, strerror(errno));
+
+    pthread_mutex_unlock(&gstTraceEvents.stMutex);
+
+    return;
+  }
+
+  fprintf(fpEvents,
+      "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+      iProcessId, iProcessId, gkpszProgramName
+  );
+
+  /* ts is in microseconds since the start of the program */
+  for(ii = 0; ii < gstTraceEvents.iEventsCount; ii++)
+  {
+    pstEvent = &gstTraceEvents.pastEvents[ii];
+
+    fprintf(fpEvents, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+                      pstEvent->kpszName, pstEvent->chPhase,
+                      (double) (pstEvent->ui64TimeNs - gstTraceEvents.ui64StartNs) / 1000.0,
+                      iProcessId, pstEvent->iThreadId);
+  }
+
+  fprintf(fpEvents, "\n]}\n");
+
+  if(fclose(fpEvents) != 0)
+  {
+    vPrintErrorMessage(_("Impossible write the file %s: %s"), gstTraceEvents.szFileName, strerror(errno));
+  }
+
+  free(gstTraceEvents.pastEvents);
+  gstTraceEvents.pastEvents = NULL;
+  gstTraceEvents.iEventsCount = 0;
+  gstTraceEvents.iEventsAlloc = 0;
+
+  pthread_mutex_unlock(&gstTraceEvents.stMutex);
+}
@@ -0,0 +1,595 @@
+/**
+ * tree.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Create the files of the template that aren't one
+ *              of the files of mkcproj (the flags), with the names
+ *              replaced by the substitution rules
+ *
+ * Date: 19/10/2026
+ */
+
+/* memmem() */
+#define _GNU_SOURCE
+
+#include "cmdline.h"
+#include "tree.h"
+#include "with.h"
+
+bool bAddTreeRule(PSTRUCT_TREE_QUEUE pstQueue, const char *kpszFrom, const char *kpszTo)
+{
+  PSTRUCT_TREE_RULE pstRule = NULL;
+
+  if(pstQueue->iRulesCount == TREE_MAX_RULES || bStrIsEmpty(kpszFrom) ||
+     strlen(kpszFrom) >= sizeof(pstRule->szFrom) || strlen(kpszTo) >= sizeof(pstRule->szTo))
+  {
+    return false;
+  }
+
+  pstRule = &pstQueue->astRules[pstQueue->iRulesCount++];
+
+  snprintf(pstRule->szFrom, sizeof(pstRule->szFrom), "%s", kpszFrom);
+  snprintf(pstRule->szTo, sizeof(pstRule->szTo), "%s", kpszTo);
+  pstRule->lFromLen = strlen(kpszFrom);
+
+  return true;
+}
+
+bool bInitTreeRules(PSTRUCT_TREE_QUEUE pstQueue)
+{
+  char szUpperProjName[_MAX_PATH];
+  int ii;
+
+  memset(szUpperProjName, 0, sizeof(szUpperProjName));
+
+  for(ii = 0; gstCmdLine.szProjName[ii] != '\0' && ii < (int) sizeof(szUpperProjName) - 1; ii++)
+  {
+    szUpperProjName[ii] = toupper((unsigned char) gstCmdLine.szProjName[ii]);
+  }
+
+  pstQueue->iRulesCount = 0;
+
+  /* The same names of vReplaceTemplateName */
+  return bAddTreeRule(pstQueue, "template", gstCmdLine.szProjName) &&
+         bAddTreeRule(pstQueue, "TEMPLATE", szUpperProjName);
+}
+
+int iWriteTreeRules(FILE *fpFile, const char *kpszContent, size_t lSize, PSTRUCT_TREE_QUEUE pstQueue)
+{
+  const char *kpszEnd = kpszContent + lSize;
+  const char *apkszMatches[TREE_MAX_RULES];
+  int iFirst = -1;
+  int ii;
+
+  for(ii = 0; ii < pstQueue->iRulesCount; ii++)
+  {
+    apkszMatches[ii] = memmem(kpszContent, lSize, pstQueue->astRules[ii].szFrom, pstQueue->astRules[ii].lFromLen);
+  }
+
+  while(true)
+  {
+    iFirst = -1;
+
+    for(ii = 0; ii < pstQueue->iRulesCount; ii++)
+    {
+      /* Each memmem runs again only when its match was consumed */
+      if(apkszMatches[ii] != NULL && apkszMatches[ii] < kpszContent)
+      {
+        apkszMatches[ii] = memmem(kpszContent, kpszEnd - kpszContent, pstQueue->astRules[ii].szFrom,
+                                  pstQueue->astRules[ii].lFromLen);
+      }
+
+      if(apkszMatches[ii] != NULL && (iFirst < 0 || apkszMatches[ii] < apkszMatches[iFirst]))
+      {
+        iFirst = ii;
+      }
+    }
+
+    if(iFirst < 0)
+    {
+      break;
+    }
+
+    fwrite(kpszContent, 1, apkszMatches[iFirst] - kpszContent, fpFile);
+    fputs(pstQueue->astRules[iFirst].szTo, fpFile);
+    kpszContent = apkszMatches[iFirst] + pstQueue->astRules[iFirst].lFromLen;
+  }
+
+  fwrite(kpszContent, 1, kpszEnd - kpszContent, fpFile);
+
+  return ferror(fpFile) ? -1 : 0;
+}
+
+void vGetTreePath(const char *kpszRelativePath, char *pszNewPath, size_t lNewPathSize,
+                  PSTRUCT_TREE_QUEUE pstQueue)
+{
+  FILE *fpPath = NULL;
+
+  memset(pszNewPath, 0, lNewPathSize);
+
+  if((fpPath = fmemopen(pszNewPath, lNewPathSize, "w")) == NULL)
+  {
+    snprintf(pszNewPath, lNewPathSize, "%s", kpszRelativePath);
+
+    return;
+  }
+
+  /* The buffer of fmemopen is the path, without the last byte for the '\0' */
+  setvbuf(fpPath, NULL, _IONBF, 0);
+
+  iWriteTreeRules(fpPath, kpszRelativePath, strlen(kpszRelativePath), pstQueue);
+
+  fclose(fpPath);
+
+  pszNewPath[lNewPathSize - 1] = '\0';
+}
+
+bool bPushTreeJob(PSTRUCT_TREE_QUEUE pstQueue, PSTRUCT_TEMPLATE_FILE pstTemplateFile)
+{
+  PSTRUCT_TREE_JOB pastTmp = NULL;
+  PSTRUCT_TREE_JOB pstJob = NULL;
+
+  if(pstQueue->iJobsCount == pstQueue->iJobsAlloc)
+  {
+    pstQueue->iJobsAlloc = pstQueue->iJobsAlloc == 0 ? 256 : pstQueue->iJobsAlloc * 2;
+
+    if((pastTmp = (PSTRUCT_TREE_JOB) realloc(pstQueue->pastJobs,
+                                             pstQueue->iJobsAlloc * sizeof(STRUCT_TREE_JOB))) == NULL)
+    {
+      pstQueue->iJobsAlloc = pstQueue->iJobsCount;
+
+      return false;
+    }
+
+    pstQueue->pastJobs = pastTmp;
+  }
+
+  pstJob = &pstQueue->pastJobs[pstQueue->iJobsCount++];
+
+  pstJob->pstTemplateFile = pstTemplateFile;
+  vGetTreePath(pstTemplateFile->szRelativePath, pstJob->szNewRelativePath, sizeof(pstJob->szNewRelativePath), pstQueue);
+
+  return true;
+}
+
+int iCreateTreeDirs(PSTRUCT_TREE_QUEUE pstQueue)
+{
+  const char *kpszLastDir = "";
+  const char *kpszSlash = NULL;
+  size_t lDirLen = 0;
+  int ii;
+  char szDirPath[sizeof(gszFullNewProjectPathDir) + _MAX_PATH + 2];
+
+  memset(szDirPath, 0, sizeof(szDirPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  for(ii = 0; ii < pstQueue->iJobsCount; ii++)
+  {
+    for(kpszSlash = strchr(pstQueue->pastJobs[ii].szNewRelativePath, '/'); kpszSlash != NULL;
+        kpszSlash = strchr(kpszSlash + 1, '/'))
+    {
+      lDirLen = kpszSlash - pstQueue->pastJobs[ii].szNewRelativePath;
+
+      /* The jobs are sorted, the directories of the last file were created */
+      if(strncmp(kpszLastDir, pstQueue->pastJobs[ii].szNewRelativePath, lDirLen + 1) == 0)
+      {
+        continue;
+      }
+
+      snprintf(szDirPath, sizeof(szDirPath), "%s/%.*s", gszFullNewProjectPathDir, (int) lDirLen,
+               pstQueue->pastJobs[ii].szNewRelativePath);
+
+      if(gpstOutputSink != NULL)
+      {
+        if(!gpstOutputSink->pbWriteDir(gpstOutputSink->pvData, pszGetTarPath(szDirPath), 0755))
+        {
+          vPrintErrorMessage(_("Impossible write the directory %s"), szDirPath);
+
+          if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+          return -1;
+        }
+      }
+      else if(mkdir(szDirPath, 0755) != 0 && errno != EEXIST)
+      {
+        vPrintErrorMessage(_("Impossible create the directory %s: %s"), szDirPath, strerror(errno));
+
+        if(DEBUG_DETAILS) vTraceFatal(_("Impossible create the directory %s: %s"), szDirPath, strerror(errno));
+
+        if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+        return -1;
+      }
+    }
+
+    kpszLastDir = pstQueue->pastJobs[ii].szNewRelativePath;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return 0;
+}
+
+int iCreateTreeFile(PSTRUCT_TREE_QUEUE pstQueue, PSTRUCT_TREE_JOB pstJob)
+{
+  STRUCT_NEW_FILE stNewFile;
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile = pstJob->pstTemplateFile;
+  struct stat stFileStat;
+  char *pszContent = pstTemplateFile->pszContent;
+  size_t lSize = pstTemplateFile->lSize;
+  bool bMapped = false;
+  int iFd = -1;
+  int iRsl = 0;
+  char szTemplatePath[sizeof(gszTemplatePathDir) + _MAX_PATH + 2];
+  char szNewPath[sizeof(gszFullNewProjectPathDir) + _MAX_PATH + 2];
+
+  memset(&stNewFile, 0, sizeof(stNewFile));
+  memset(&stFileStat, 0, sizeof(stFileStat));
+  memset(szTemplatePath, 0, sizeof(szTemplatePath));
+  memset(szNewPath, 0, sizeof(szNewPath));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szTemplatePath, sizeof(szTemplatePath), "%s/%s", gszTemplatePathDir, pstTemplateFile->szRelativePath);
+  snprintf(szNewPath, sizeof(szNewPath), "%s/%s", gszFullNewProjectPathDir, pstJob->szNewRelativePath);
+
+  if(DEBUG_DETAILS) vTraceAll("%s -> %s", szTemplatePath, szNewPath);
+
+  /* Templates read from an archive are already in the memory */
+  if(pszContent == NULL)
+  {
+    if((iFd = open(szTemplatePath, O_RDONLY | O_CLOEXEC)) < 0 || fstat(iFd, &stFileStat) != 0)
+    {
+      vPrintErrorMessage(_("Impossible open the file %s: %s"), szTemplatePath, strerror(errno));
+
+      if(iFd >= 0)
+      {
+        close(iFd);
+      }
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+
+    lSize = stFileStat.st_size;
+
+    if(lSize > 0)
+    {
+      if((pszContent = mmap(NULL, lSize, PROT_READ, MAP_PRIVATE, iFd, 0)) == MAP_FAILED)
+      {
+        vPrintErrorMessage(_("Impossible map the file %s: %s"), szTemplatePath, strerror(errno));
+
+        close(iFd);
+
+        if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+        return -1;
+      }
+
+      madvise(pszContent, lSize, MADV_SEQUENTIAL);
+      bMapped = true;
+    }
+
+    close(iFd);
+  }
+
+  if(!bOpenNewFile(&stNewFile, szNewPath, 0))
+  {
+    iRsl = -1;
+  }
+  else
+  {
+    if(lSize == 0)
+    {
+      iRsl = 0;
+    }
+    else if(memchr(pszContent, '\0', lSize < TREE_BINARY_CHECK_SIZE ? lSize : TREE_BINARY_CHECK_SIZE) != NULL)
+    {
+      iRsl = fwrite(pszContent, 1, lSize, stNewFile.fpFile) == lSize ? 0 : -1;
+    }
+    else
+    {
+      iRsl = iWriteTreeRules(stNewFile.fpFile, pszContent, lSize, pstQueue);
+    }
+
+    /* The scripts of the template must keep your permissions */
+    if(iRsl == 0)
+    {
+      iRsl = bCloseNewFile(&stNewFile, pstTemplateFile->iMode) ? 0 : -1;
+    }
+    else
+    {
+      vPrintErrorMessage(_("Impossible write the file %s: %s"), szNewPath, strerror(errno));
+
+      fclose(stNewFile.fpFile);
+      free(stNewFile.pszBuffer);
+
+      if(!stNewFile.bInMemory)
+      {
+        unlink(stNewFile.szTmpPath);
+      }
+    }
+  }
+
+  if(bMapped)
+  {
+    munmap(pszContent, lSize);
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+void *pvTreeWorker(void *pvQueue)
+{
+  PSTRUCT_TREE_QUEUE pstQueue = (PSTRUCT_TREE_QUEUE) pvQueue;
+  PSTRUCT_TREE_JOB pstJob = NULL;
+  int iRsl = 0;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  pthread_mutex_lock(&pstQueue->stMutex);
+
+  while(pstQueue->iNextJob < pstQueue->iJobsCount)
+  {
+    pstJob = &pstQueue->pastJobs[pstQueue->iNextJob++];
+
+    pthread_mutex_unlock(&pstQueue->stMutex);
+
+    iRsl = iCreateTreeFile(pstQueue, pstJob);
+
+    pthread_mutex_lock(&pstQueue->stMutex);
+
+    if(iRsl != 0)
+    {
+      pstQueue->iErrors++;
+    }
+  }
+
+  pthread_mutex_unlock(&pstQueue->stMutex);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+  return NULL;
+}
+
+bool bIsTreeSkipped(const char *kpszRelativePath)
+{
+  size_t lNameLen = strlen(kpszRelativePath);
+
+  /* Left behind by an editor or by a run that was killed */
+  if(lNameLen > strlen(TMP_FILE_SUFFIX) &&
+     strcmp(kpszRelativePath + lNameLen - strlen(TMP_FILE_SUFFIX), TMP_FILE_SUFFIX) == 0)
+  {
+    return true;
+  }
+
+  /* The modules are created only by --with */
+  return strncmp(kpszRelativePath, WITH_TEMPLATE_DIR, strlen(WITH_TEMPLATE_DIR)) == 0;
+}
+
+bool bIsTreeFlagFile(PSTRUCT_TEMPLATE_FILE pstTemplateFile)
+{
+  uint64_t ui64Flag;
+
+  for(ui64Flag = HEADER_FILE; ui64Flag != 0 && ui64Flag <= TREE_FLAG_FILES; ui64Flag <<= 1)
+  {
+    if((ui64Flag & TREE_FLAG_FILES) && pstGetTemplateFile(ui64Flag) == pstTemplateFile)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int iRunTreeJobs(PSTRUCT_TREE_QUEUE pstQueue)
+{
+  pthread_t atThreads[TREE_MAX_THREADS];
+  long lThreadsCount = sysconf(_SC_NPROCESSORS_ONLN);
+  int iThreadsStarted = 0;
+  int iRsl = 0;
+  int ii;
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(pstQueue->iJobsCount == 0 || iCreateTreeDirs(pstQueue) != 0)
+  {
+    iRsl = pstQueue->iJobsCount == 0 ? 0 : -1;
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl;
+  }
+
+  pthread_mutex_init(&pstQueue->stMutex, NULL);
+
+  /* The threads only pay off in a big template */
+  if(lThreadsCount > (pstQueue->iJobsCount + TREE_FILES_PER_THREAD - 1) / TREE_FILES_PER_THREAD)
+  {
+    lThreadsCount = (pstQueue->iJobsCount + TREE_FILES_PER_THREAD - 1) / TREE_FILES_PER_THREAD;
+  }
+
+  if(lThreadsCount > TREE_MAX_THREADS)
+  {
+    lThreadsCount = TREE_MAX_THREADS;
+  }
+
+  for(ii = 0; lThreadsCount > 1 && ii < lThreadsCount; ii++)
+  {
+    if(pthread_create(&atThreads[ii], NULL, pvTreeWorker, pstQueue) != 0)
+    {
+      break;
+    }
+
+    iThreadsStarted++;
+  }
+
+  /* Without threads, the files are created in this one */
+  if(iThreadsStarted == 0)
+  {
+    pvTreeWorker(pstQueue);
+  }
+
+  for(ii = 0; ii < iThreadsStarted; ii++)
+  {
+    pthread_join(atThreads[ii], NULL);
+  }
+
+  pthread_mutex_destroy(&pstQueue->stMutex);
+
+  iRsl = pstQueue->iErrors == 0 ? 0 : -1;
+
+  vPrintVerbose(_("Created %d files of the template tree with %d threads\n"), pstQueue->iJobsCount,
+                iThreadsStarted > 0 ? iThreadsStarted : 1);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iCreateTemplateTree(void)
+{
+  STRUCT_TREE_QUEUE stQueue;
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile = NULL;
+  bool *pbFlagFiles = NULL;
+  uint64_t ui64Flag;
+  int iRsl = 0;
+  int ii;
+
+  memset(&stQueue, 0, sizeof(stQueue));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(gstTemplateIndex.iFilesCount == 0)
+  {
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return 0;
+  }
+
+  if((pbFlagFiles = (bool *) calloc(gstTemplateIndex.iFilesCount, sizeof(bool))) == NULL)
+  {
+    vPrintErrorMessage(_("Impossible allocate memory to the template tree"));
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  /* The index is sorted, a bsearch for each flag */
+  for(ui64Flag = HEADER_FILE; ui64Flag != 0 && ui64Flag <= TREE_FLAG_FILES; ui64Flag <<= 1)
+  {
+    if((ui64Flag & TREE_FLAG_FILES) && (pstTemplateFile = pstGetTemplateFile(ui64Flag)) != NULL)
+    {
+      pbFlagFiles[pstTemplateFile - gstTemplateIndex.pastFiles] = true;
+    }
+  }
+
+  if(!bInitTreeRules(&stQueue))
+  {
+    vPrintErrorMessage(_("Invalid name of project: %s"), gstCmdLine.szProjName);
+
+    free(pbFlagFiles);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  for(ii = 0; iRsl == 0 && ii < gstTemplateIndex.iFilesCount; ii++)
+  {
+    pstTemplateFile = &gstTemplateIndex.pastFiles[ii];
+
+    if(pbFlagFiles[ii] || bIsTreeSkipped(pstTemplateFile->szRelativePath))
+    {
+      continue;
+    }
+
+    if(!bPushTreeJob(&stQueue, pstTemplateFile))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), pstTemplateFile->szRelativePath);
+
+      iRsl = -1;
+    }
+  }
+
+  free(pbFlagFiles);
+
+  if(iRsl == 0)
+  {
+    iRsl = iRunTreeJobs(&stQueue);
+  }
+
+  free(stQueue.pastJobs);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
+
+int iUpdateTemplateTree(char **ppszRelativePaths, int iPathsCount)
+{
+  STRUCT_TREE_QUEUE stQueue;
+  STRUCT_TEMPLATE_FILE stKey;
+  PSTRUCT_TEMPLATE_FILE pstTemplateFile = NULL;
+  int iRsl = 0;
+  int ii;
+
+  memset(&stQueue, 0, sizeof(stQueue));
+  memset(&stKey, 0, sizeof(stKey));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(!bInitTreeRules(&stQueue))
+  {
+    vPrintErrorMessage(_("Invalid name of project: %s"), gstCmdLine.szProjName);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  for(ii = 0; iRsl == 0 && ii < iPathsCount; ii++)
+  {
+    snprintf(stKey.szRelativePath, sizeof(stKey.szRelativePath), "%s", ppszRelativePaths[ii]);
+
+    /* Deleted templates are not in the index, nothing is written */
+    if(gstTemplateIndex.iFilesCount == 0 || bIsTreeSkipped(stKey.szRelativePath) ||
+       (pstTemplateFile = (PSTRUCT_TEMPLATE_FILE) bsearch(&stKey, gstTemplateIndex.pastFiles,
+                                                          gstTemplateIndex.iFilesCount,
+                                                          sizeof(STRUCT_TEMPLATE_FILE),
+                                                          iCompareTemplateFiles)) == NULL ||
+       bIsTreeFlagFile(pstTemplateFile))
+    {
+      continue;
+    }
+
+    if(!bPushTreeJob(&stQueue, pstTemplateFile))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"), pstTemplateFile->szRelativePath);
+
+      iRsl = -1;
+    }
+  }
+
+  if(iRsl == 0)
+  {
+    iRsl = iRunTreeJobs(&stQueue);
+  }
+
+  for(ii = 0; iRsl == 0 && ii < stQueue.iJobsCount; ii++)
+  {
+    printf(_("Updated %s/%s\n"), gszFullNewProjectPathDir, stQueue.pastJobs[ii].szNewRelativePath);
+  }
+
+  free(stQueue.pastJobs);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
@@ -0,0 +1,173 @@
+/**
+ * with.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Add the modules of the template (arena, pool, ...)
+ *              to the project, with their tests and benchmarks
+ *              (--with)
+ *
+ * Date: 19/10/2026
+ */
+
+#include "cmdline.h"
+#include "with.h"
+
+bool bIsValidWithModule(const char *kpszModule)
+{
+  const char *kpszChar = NULL;
+
+  if(bStrIsEmpty(kpszModule))
+  {
+    return false;
+  }
+
+  for(kpszChar = kpszModule; *kpszChar != '\0'; kpszChar++)
+  {
+    if(!islower((unsigned char) *kpszChar) && !isdigit((unsigned char) *kpszChar) &&
+       *kpszChar != '-' && *kpszChar != '_')
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int iPushWithModule(PSTRUCT_TREE_QUEUE pstQueue, const char *kpszModule)
+{
+  PSTRUCT_TREE_JOB pstJob = NULL;
+  char szPrefix[_MAX_PATH];
+  size_t lPrefixLen = 0;
+  int iFilesCount = 0;
+  int ii;
+
+  memset(szPrefix, 0, sizeof(szPrefix));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  snprintf(szPrefix, sizeof(szPrefix), "%s%s/", WITH_TEMPLATE_DIR, kpszModule);
+  lPrefixLen = strlen(szPrefix);
+
+  for(ii = 0; ii < gstTemplateIndex.iFilesCount; ii++)
+  {
+    if(strncmp(gstTemplateIndex.pastFiles[ii].szRelativePath, szPrefix, lPrefixLen) != 0)
+    {
+      continue;
+    }
+
+    if(!bPushTreeJob(pstQueue, &gstTemplateIndex.pastFiles[ii]))
+    {
+      vPrintErrorMessage(_("Impossible allocate memory to the file %s"),
+                         gstTemplateIndex.pastFiles[ii].szRelativePath);
+
+      if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+      return -1;
+    }
+
+    /* with/arena/src/arena.c -> src/arena.c */
+    pstJob = &pstQueue->pastJobs[pstQueue->iJobsCount - 1];
+    vGetTreePath(gstTemplateIndex.pastFiles[ii].szRelativePath + lPrefixLen, pstJob->szNewRelativePath,
+                 sizeof(pstJob->szNewRelativePath), pstQueue);
+
+    iFilesCount++;
+  }
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iFilesCount == %d"), __func__, iFilesCount);
+
+  return iFilesCount;
+}
+
+/**
+ * qsort() callback, iCreateTreeDirs() wants the jobs sorted by path
+ */
+static int iCompareTreeJobs(const void *kpvFirst, const void *kpvSecond)
+{
+  return strcmp(((const STRUCT_TREE_JOB *) kpvFirst)->szNewRelativePath,
+                ((const STRUCT_TREE_JOB *) kpvSecond)->szNewRelativePath);
+}
+
+int iCreateWithModules(void)
+{
+  STRUCT_TREE_QUEUE stQueue;
+  char *pszModule = NULL;
+  char *pszSavePtr = NULL;
+  int iFilesCount = 0;
+  int iRsl = 0;
+  int ii;
+  int jj;
+  char szModules[sizeof(gstCmdLine.szWith)];
+
+  memset(&stQueue, 0, sizeof(stQueue));
+  memset(szModules, 0, sizeof(szModules));
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - begin"), __func__);
+
+  if(!bInitTreeRules(&stQueue))
+  {
+    vPrintErrorMessage(_("Invalid name of project: %s"), gstCmdLine.szProjName);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end"), __func__);
+
+    return -1;
+  }
+
+  snprintf(szModules, sizeof(szModules), "%s", gstCmdLine.szWith);
+
+  for(pszModule = strtok_r(szModules, WITH_SEPARATOR, &pszSavePtr); iRsl == 0 && pszModule != NULL;
+      pszModule = strtok_r(NULL, WITH_SEPARATOR, &pszSavePtr))
+  {
+    if(!bIsValidWithModule(pszModule))
+    {
+      vPrintErrorMessage(_("Invalid name of module: %s"), pszModule);
+
+      iRsl = -1;
+    }
+    else if((iFilesCount = iPushWithModule(&stQueue, pszModule)) == 0)
+    {
+      vPrintErrorMessage(_("The template directory %s doesn't have the module %s (%s%s)"), gszTemplatePathDir,
+                         pszModule, WITH_TEMPLATE_DIR, pszModule);
+
+      iRsl = -1;
+    }
+    else if(iFilesCount < 0)
+    {
+      iRsl = -1;
+    }
+    else
+    {
+      vPrintVerbose(_("Added the module %s (%d files)\n"), pszModule, iFilesCount);
+    }
+  }
+
+  if(iRsl != 0 || stQueue.iJobsCount == 0)
+  {
+    free(stQueue.pastJobs);
+
+    if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+    return iRsl;
+  }
+
+  qsort(stQueue.pastJobs, stQueue.iJobsCount, sizeof(STRUCT_TREE_JOB), iCompareTreeJobs);
+
+  /* A module given twice (--with=pool,pool) is created once */
+  for(ii = 1, jj = 1; ii < stQueue.iJobsCount; ii++)
+  {
+    if(strcmp(stQueue.pastJobs[ii].szNewRelativePath, stQueue.pastJobs[jj - 1].szNewRelativePath) != 0)
+    {
+      stQueue.pastJobs[jj++] = stQueue.pastJobs[ii];
+    }
+  }
+
+  stQueue.iJobsCount = jj;
+
+  iRsl = iRunTreeJobs(&stQueue);
+
+  free(stQueue.pastJobs);
+
+  if(INFO_DETAILS) vTraceEvent(_("%s - end iRsl == %d"), __func__, iRsl);
+
+  return iRsl;
+}
@@ -0,0 +1,362 @@
+/**
+ * bench.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Runner of the microbenchmarks of the project
+ *
+ * Date: 19/10/2026
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <getopt.h>
+#include <unistd.h>
+#include "bench.h"
+
+/**
+ * Name of the project in the JSON
+ */
+#define BENCH_PROJECT "template"
+
+/**
+ * Benchmarks added by BENCH_REGISTER, in the order of the registration
+ */
+static PSTRUCT_BENCH_NODE gpstBenchHead = NULL;
+static PSTRUCT_BENCH_NODE gpstBenchTail = NULL;
+
+void vRegisterBenchmark(PSTRUCT_BENCH_NODE pstNode)
+{
+  pstNode->pstNext = NULL;
+
+  if(gpstBenchTail == NULL)
+  {
+    gpstBenchHead = pstNode;
+  }
+  else
+  {
+    gpstBenchTail->pstNext = pstNode;
+  }
+
+  gpstBenchTail = pstNode;
+}
+
+uint64_t ui64BenchNowNs(void)
+{
+  struct timespec stNow;
+
+  clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+  return (uint64_t) stNow.tv_sec * 1000000000ULL + (uint64_t) stNow.tv_nsec;
+}
+
+/**
+ * qsort() callback of the times of the repetitions
+ */
+static int iCompareDoubles(const void *kpvFirst, const void *kpvSecond)
+{
+  double dFirst = *(const double *) kpvFirst;
+  double dSecond = *(const double *) kpvSecond;
+
+  return (dFirst > dSecond) - (dFirst < dSecond);
+}
+
+/**
+ * Percentile of the sorted times, with linear interpolation
+ */
+static double dGetPercentile(const double *kpadSorted, int iCount, double dPercentile)
+{
+  double dRank = dPercentile / 100.0 * (iCount - 1);
+  int iLower = (int) dRank;
+
+  if(iLower + 1 >= iCount)
+  {
+    return kpadSorted[iCount - 1];
+  }
+
+  return kpadSorted[iLower] + (kpadSorted[iLower + 1] - kpadSorted[iLower]) * (dRank - iLower);
+}
+
+int iRunBenchmark(PSTRUCT_BENCH pstBench, int iRepetitions, int iWarmupMs, int iMinTimeMs,
+                  PSTRUCT_BENCH_RESULT pstResult)
+{
+  double adTimes[BENCH_MAX_REPETITIONS];
+  uint64_t ui64Iterations = 1;
+  uint64_t ui64Start = 0;
+  uint64_t ui64Elapsed = 0;
+  uint64_t ui64WarmupEnd = 0;
+  double dSum = 0;
+  double dSquares = 0;
+  int ii;
+
+  memset(pstResult, 0, sizeof(STRUCT_BENCH_RESULT));
+
+  if(iRepetitions < 1 || iRepetitions > BENCH_MAX_REPETITIONS)
+  {
+    fprintf(stderr, "E: The repetitions must be between 1 and %d\n", BENCH_MAX_REPETITIONS);
+
+    return -1;
+  }
+
+  /* Warmup: caches, branch predictors and the frequency of the CPU */
+  ui64WarmupEnd = ui64BenchNowNs() + (uint64_t) iWarmupMs * 1000000ULL;
+
+  while(ui64BenchNowNs() < ui64WarmupEnd)
+  {
+    pstBench->pfnBench(ui64Iterations, pstBench->pvArg);
+  }
+
+  /* Each repetition runs at least iMinTimeMs, so the clock doesn't count */
+  while(true)
+  {
+    ui64Start = ui64BenchNowNs();
+    pstBench->pfnBench(ui64Iterations, pstBench->pvArg);
+    ui64Elapsed = ui64BenchNowNs() - ui64Start;
+
+    if(ui64Elapsed >= (uint64_t) iMinTimeMs * 1000000ULL || ui64Iterations >= (1ULL << 40))
+    {
+      break;
+    }
+
+    ui64Iterations *= ui64Elapsed < (uint64_t) iMinTimeMs * 100000ULL ? 10 : 2;
+  }
+
+  for(ii = 0; ii < iRepetitions; ii++)
+  {
+    ui64Start = ui64BenchNowNs();
+    pstBench->pfnBench(ui64Iterations, pstBench->pvArg);
+    ui64Elapsed = ui64BenchNowNs() - ui64Start;
+
+    adTimes[ii] = (double) ui64Elapsed / (double) ui64Iterations;
+    dSum += adTimes[ii];
+  }
+
+  pstResult->kpszName = pstBench->kpszName;
+  pstResult->ui64Iterations = ui64Iterations;
+  pstResult->iRepetitions = iRepetitions;
+  pstResult->dMean = dSum / iRepetitions;
+
+  for(ii = 0; ii < iRepetitions; ii++)
+  {
+    dSquares += (adTimes[ii] - pstResult->dMean) * (adTimes[ii] - pstResult->dMean);
+  }
+
+  pstResult->dStdDev = iRepetitions > 1 ? sqrt(dSquares / (iRepetitions - 1)) : 0;
+
+  qsort(adTimes, iRepetitions, sizeof(double), iCompareDoubles);
+
+  pstResult->dMin = adTimes[0];
+  pstResult->dP50 = dGetPercentile(adTimes, iRepetitions, 50);
+  pstResult->dP90 = dGetPercentile(adTimes, iRepetitions, 90);
+  pstResult->dP99 = dGetPercentile(adTimes, iRepetitions, 99);
+  pstResult->dMax = adTimes[iRepetitions - 1];
+
+  return 0;
+}
+
+void vWriteBenchJson(FILE *fpJson, PSTRUCT_BENCH_RESULT pastResults, int iResultsCount)
+{
+  char szDate[32];
+  char szHost[256];
+  time_t tNow = time(NULL);
+  int ii;
+
+  memset(szDate, 0, sizeof(szDate));
+  memset(szHost, 0, sizeof(szHost));
+
+  strftime(szDate, sizeof(szDate), "%Y-%m-%dT%H:%M:%S%z", localtime(&tNow));
+  gethostname(szHost, sizeof(szHost) - 1);
+
+  fprintf(fpJson,
+    "{\n"
+    "  \"project\": \"%s\",\n"
+    "  \"date\": \"%s\",\n"
+    "  \"host\": \"%s\",\n"
+    "  \"cpus\": %ld,\n"
+    "  \"unit\": \"ns/op\",\n"
+    "  \"benchmarks\": [", BENCH_PROJECT, szDate, szHost, sysconf(_SC_NPROCESSORS_ONLN));
+
+  for(ii = 0; ii < iResultsCount; ii++)
+  {
+    fprintf(fpJson,
+      "%s\n"
+      "    {\n"
+      "      \"name\": \"%s\",\n"
+      "      \"iterations\": %llu,\n"
+      "      \"repetitions\": %d,\n"
+      "      \"min\": %.3f,\n"
+      "      \"p50\": %.3f,\n"
+      "      \"p90\": %.3f,\n"
+      "      \"p99\": %.3f,\n"
+      "      \"max\": %.3f,\n"
+      "      \"mean\": %.3f,\n"
+      "      \"stddev\": %.3f\n"
+      "    }", ii > 0 ? "," : "", pastResults[ii].kpszName,
+              (unsigned long long) pastResults[ii].ui64Iterations, pastResults[ii].iRepetitions,
+              pastResults[ii].dMin, pastResults[ii].dP50, pastResults[ii].dP90, pastResults[ii].dP99,
+              pastResults[ii].dMax, pastResults[ii].dMean, pastResults[ii].dStdDev);
+  }
+
+  fprintf(fpJson, "\n  ]\n}\n");
+}
+
+/**
+ * Print the help message of the runner
+ */
+static void vPrintBenchUsage(const char *kpszProgramName)
+{
+  printf("Usage %s [options]\n\n"
+         "Options:\n"
+         "  --filter=<text>, -f <text>\n"
+         "    Run only the benchmarks with <text> in the name\n\n"
+         "  --repetitions=<number>, -r <number>\n"
+         "    <number> of repetitions of each benchmark (default %d)\n\n"
+         "  --warmup-ms=<number>, -w <number>\n"
+         "    Run each benchmark <number> ms before the measure (default %d)\n\n"
+         "  --min-time-ms=<number>, -m <number>\n"
+         "    Minimum time of a repetition (default %d)\n\n"
+         "  --json=<file>, -j <file>\n"
+         "    Write the results as JSON in <file> (- is the stdout)\n\n"
+         "  --help, -h\n"
+         "    Show this message and exit\n\n", kpszProgramName, BENCH_REPETITIONS,
+                                              BENCH_WARMUP_MS, BENCH_MIN_TIME_MS);
+}
+
+int main(int argc, char **argv)
+{
+  struct option astBenchOpt[] = {
+    { "filter"     , required_argument, 0, 'f' },
+    { "repetitions", required_argument, 0, 'r' },
+    { "warmup-ms"  , required_argument, 0, 'w' },
+    { "min-time-ms", required_argument, 0, 'm' },
+    { "json"       , required_argument, 0, 'j' },
+    { "help"       , no_argument      , 0, 'h' },
+    { NULL         , 0                , 0,  0  }
+  };
+  PSTRUCT_BENCH_RESULT pastResults = NULL;
+  PSTRUCT_BENCH *papstBenchmarks = NULL;
+  PSTRUCT_BENCH_NODE pstNode = NULL;
+  FILE *fpJson = NULL;
+  const char *kpszFilter = NULL;
+  const char *kpszJson = NULL;
+  int iRepetitions = BENCH_REPETITIONS;
+  int iWarmupMs = BENCH_WARMUP_MS;
+  int iMinTimeMs = BENCH_MIN_TIME_MS;
+  int iResultsCount = 0;
+  int iBenchCount = 0;
+  int iRsl = 0;
+  int iOpt = 0;
+  int ii;
+
+  while((iOpt = getopt_long(argc, argv, "f:r:w:m:j:h", astBenchOpt, NULL)) != -1)
+  {
+    switch(iOpt)
+    {
+      case 'f':
+        kpszFilter = optarg;
+        break;
+      case 'r':
+        iRepetitions = atoi(optarg);
+        break;
+      case 'w':
+        iWarmupMs = atoi(optarg);
+        break;
+      case 'm':
+        iMinTimeMs = atoi(optarg);
+        break;
+      case 'j':
+        kpszJson = optarg;
+        break;
+      case 'h':
+        vPrintBenchUsage(argv[0]);
+        return EXIT_SUCCESS;
+      default:
+        vPrintBenchUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  for(ii = 0; gastBenchmarks[ii].kpszName != NULL; ii++);
+
+  iBenchCount = ii;
+
+  for(pstNode = gpstBenchHead; pstNode != NULL; pstNode = pstNode->pstNext)
+  {
+    iBenchCount++;
+  }
+
+  /* gastBenchmarks first, then the registered ones */
+  if((pastResults = (PSTRUCT_BENCH_RESULT) calloc(iBenchCount + 1, sizeof(STRUCT_BENCH_RESULT))) == NULL ||
+     (papstBenchmarks = (PSTRUCT_BENCH *) calloc(iBenchCount + 1, sizeof(PSTRUCT_BENCH))) == NULL)
+  {
+    fprintf(stderr, "E: Impossible allocate memory to the results\n");
+
+    free(pastResults);
+
+    return EXIT_FAILURE;
+  }
+
+  for(ii = 0; gastBenchmarks[ii].kpszName != NULL; ii++)
+  {
+    papstBenchmarks[ii] = &gastBenchmarks[ii];
+  }
+
+  for(pstNode = gpstBenchHead; pstNode != NULL; pstNode = pstNode->pstNext)
+  {
+    papstBenchmarks[ii++] = &pstNode->stBench;
+  }
+
+  printf("%-32s %14s %12s %12s %12s %12s\n", "benchmark", "iterations", "p50 ns", "p90 ns", "p99 ns", "stddev");
+
+  for(ii = 0; ii < iBenchCount; ii++)
+  {
+    if(kpszFilter != NULL && strstr(papstBenchmarks[ii]->kpszName, kpszFilter) == NULL)
+    {
+      continue;
+    }
+
+    if(iRunBenchmark(papstBenchmarks[ii], iRepetitions, iWarmupMs, iMinTimeMs, &pastResults[iResultsCount]) != 0)
+    {
+      iRsl = -1;
+      break;
+    }
+
+    printf("%-32s %14llu %12.3f %12.3f %12.3f %12.3f\n", pastResults[iResultsCount].kpszName,
+           (unsigned long long) pastResults[iResultsCount].ui64Iterations, pastResults[iResultsCount].dP50,
+           pastResults[iResultsCount].dP90, pastResults[iResultsCount].dP99, pastResults[iResultsCount].dStdDev);
+    fflush(stdout);
+
+    iResultsCount++;
+  }
+
+  if(iRsl == 0 && kpszJson != NULL)
+  {
+    if(strcmp(kpszJson, "-") == 0)
+    {
+      vWriteBenchJson(stdout, pastResults, iResultsCount);
+    }
+    else if((fpJson = fopen(kpszJson, "w")) != NULL)
+    {
+      vWriteBenchJson(fpJson, pastResults, iResultsCount);
+
+      if(fclose(fpJson) != 0)
+      {
+        iRsl = -1;
+      }
+    }
+    else
+    {
+      fprintf(stderr, "E: Impossible open the file %s\n", kpszJson);
+
+      iRsl = -1;
+    }
+  }
+
+  free(papstBenchmarks);
+  free(pastResults);
+
+  return iRsl == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+/**
+ * bench.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Runner of the microbenchmarks of the project
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The compiler must calculate the value (a number or a
+ * pointer) and can't move it out of the loop of the benchmark
+ */
+#define BENCH_DO_NOT_OPTIMIZE(xValue) __asm__ __volatile__("" : : "r,m"(xValue) : "memory")
+
+/**
+ * Every write in the memory before it is done
+ */
+#define BENCH_CLOBBER_MEMORY() __asm__ __volatile__("" : : : "memory")
+
+/**
+ * Default values of the command line of the runner
+ */
+#define BENCH_REPETITIONS    30
+#define BENCH_WARMUP_MS      100
+#define BENCH_MIN_TIME_MS    10
+
+/**
+ * Maximum number of repetitions of a benchmark
+ */
+#define BENCH_MAX_REPETITIONS 1000
+
+#define BENCH_CONCAT_(xFirst, xSecond) xFirst##xSecond
+#define BENCH_CONCAT(xFirst, xSecond)  BENCH_CONCAT_(xFirst, xSecond)
+
+/**
+ * Add a benchmark before main(), out of gastBenchmarks. So each
+ * .c file of bench (e.g. of the modules of mkcproj --with) has
+ * its benchmarks without change bench_template.c.
+ *
+ * Example: BENCH_REGISTER("arena_alloc", vBenchArenaAlloc, NULL)
+ */
+#define BENCH_REGISTER(kpszName, pfnBench, pvArg) \
+  static STRUCT_BENCH_NODE BENCH_CONCAT(gstBenchNode, __LINE__) = { { kpszName, pfnBench, pvArg }, NULL }; \
+  static void __attribute__((constructor)) BENCH_CONCAT(vRegisterBench, __LINE__)(void) \
+  { \
+    vRegisterBenchmark(&BENCH_CONCAT(gstBenchNode, __LINE__)); \
+  }
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A benchmark runs its code ui64Iterations times
+ */
+typedef void (*PFN_BENCH)(uint64_t ui64Iterations, void *pvArg);
+
+/**
+ * A benchmark of the project
+ */
+typedef struct STRUCT_BENCH
+{
+  const char *kpszName;
+  PFN_BENCH pfnBench;
+  void *pvArg;
+} STRUCT_BENCH, *PSTRUCT_BENCH;
+
+/**
+ * A benchmark added by BENCH_REGISTER
+ */
+typedef struct STRUCT_BENCH_NODE
+{
+  STRUCT_BENCH stBench;
+  struct STRUCT_BENCH_NODE *pstNext;
+} STRUCT_BENCH_NODE, *PSTRUCT_BENCH_NODE;
+
+/**
+ * Nanoseconds by iteration of the repetitions of a benchmark
+ */
+typedef struct STRUCT_BENCH_RESULT
+{
+  const char *kpszName;
+  uint64_t ui64Iterations;
+  int iRepetitions;
+  double dMin;
+  double dP50;
+  double dP90;
+  double dP99;
+  double dMax;
+  double dMean;
+  double dStdDev;
+} STRUCT_BENCH_RESULT, *PSTRUCT_BENCH_RESULT;
+
+/******************************************************************************
+ *                                                                            *
+ *                     Global variables and constants                         *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Benchmarks of the project, the last one has kpszName == NULL
+ */
+extern STRUCT_BENCH gastBenchmarks[];
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Add the benchmark after the ones added before, used by BENCH_REGISTER
+ */
+void vRegisterBenchmark(PSTRUCT_BENCH_NODE pstNode);
+
+/**
+ * Monotonic clock in nanoseconds
+ */
+uint64_t ui64BenchNowNs(void);
+
+/**
+ * Run a benchmark: warmup, number of iterations of a repetition
+ * (at least iMinTimeMs each one) and the repetitions
+ */
+int iRunBenchmark(PSTRUCT_BENCH pstBench, int iRepetitions, int iWarmupMs, int iMinTimeMs,
+                  PSTRUCT_BENCH_RESULT pstResult);
+
+/**
+ * Write the results as JSON
+ */
+void vWriteBenchJson(FILE *fpJson, PSTRUCT_BENCH_RESULT pastResults, int iResultsCount);
+
+#endif /* _BENCH_H_ */
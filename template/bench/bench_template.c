@@ -0,0 +1,58 @@
+/**
+ * bench_template.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of the project, run by "make bench"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <string.h>
+#include "bench.h"
+
+/**
+ * Example: replace it by the functions of the project
+ * (#include "template.h"). The result goes to
+ * BENCH_DO_NOT_OPTIMIZE, otherwise the compiler removes the loop.
+ */
+static void vBenchSumOfSquares(uint64_t ui64Iterations, void *pvArg)
+{
+  uint64_t ui64Sum = 0;
+  uint64_t ii;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    ui64Sum += ii * ii;
+    BENCH_DO_NOT_OPTIMIZE(ui64Sum);
+  }
+}
+
+/**
+ * Example with an argument: copy of a buffer of 4 KiB
+ */
+static void vBenchMemcpy4K(uint64_t ui64Iterations, void *pvArg)
+{
+  static char szDest[4096];
+  char *pszDest = szDest;
+  uint64_t ii;
+
+  /* Without it the copy to a buffer that nobody reads is removed */
+  BENCH_DO_NOT_OPTIMIZE(pszDest);
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    memcpy(pszDest, pvArg, sizeof(szDest));
+    BENCH_CLOBBER_MEMORY();
+  }
+}
+
+static char gszSource[4096];
+
+STRUCT_BENCH gastBenchmarks[] = {
+  { "sum_of_squares", vBenchSumOfSquares, NULL      },
+  { "memcpy_4k"     , vBenchMemcpy4K    , gszSource },
+  { NULL            , NULL              , NULL      }
+};
@@ -0,0 +1,582 @@
+/**
+ * runner.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Run the test binaries of the project in parallel,
+ *              with a timeout, and write the results as TAP and
+ *              JUnit
+ *
+ * Date: 19/10/2026
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/**
+ * Name of the project in the JUnit
+ */
+#define RUNNER_PROJECT "template"
+
+/**
+ * Default timeout of each test binary, in seconds
+ */
+#define RUNNER_TIMEOUT 60
+
+/**
+ * Only the last bytes of the output of a test are kept
+ */
+#define RUNNER_MAX_OUTPUT (64 * 1024)
+
+/**
+ * Status of a test binary
+ */
+typedef enum ENUM_TEST_STATUS
+{
+  TEST_STATUS_WAITING = 0,
+  TEST_STATUS_RUNNING,
+  TEST_STATUS_PASSED,
+  TEST_STATUS_FAILED,
+  TEST_STATUS_TIMEOUT,
+  TEST_STATUS_SIGNALED
+} ENUM_TEST_STATUS;
+
+/**
+ * A test binary and its result
+ */
+typedef struct STRUCT_TEST_JOB
+{
+  const char *kpszPath;
+  const char *kpszName;
+  ENUM_TEST_STATUS eStatus;
+  pid_t pid;
+  int iExitCode;
+  int iSignal;
+  FILE *fpOutput;
+  char *pszOutput;
+  double dStartMs;
+  double dElapsedMs;
+} STRUCT_TEST_JOB, *PSTRUCT_TEST_JOB;
+
+/**
+ * Monotonic clock in milliseconds
+ */
+static double dNowMs(void)
+{
+  struct timespec stNow;
+
+  clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+  return stNow.tv_sec * 1e3 + stNow.tv_nsec / 1e6;
+}
+
+/**
+ * Without a handler the SIGCHLD can be discarded, even blocked
+ */
+static void vHandleChild(int iSignal)
+{
+  (void) iSignal;
+}
+
+/**
+ * Start the test binary, with the stdout and the stderr in a
+ * temporary file. The test is the leader of a process group,
+ * so the timeout kills the processes created by it too.
+ */
+static bool bStartTest(PSTRUCT_TEST_JOB pstJob)
+{
+  sigset_t stEmptySet;
+  char *apszArgs[2];
+
+  if((pstJob->fpOutput = tmpfile()) == NULL)
+  {
+    fprintf(stderr, "E: Impossible create the output file of %s: %s\n", pstJob->kpszName, strerror(errno));
+
+    return false;
+  }
+
+  fflush(stdout);
+  fflush(stderr);
+
+  pstJob->dStartMs = dNowMs();
+
+  if((pstJob->pid = fork()) < 0)
+  {
+    fprintf(stderr, "E: Impossible run %s: %s\n", pstJob->kpszName, strerror(errno));
+
+    fclose(pstJob->fpOutput);
+    pstJob->fpOutput = NULL;
+
+    return false;
+  }
+
+  if(pstJob->pid == 0)
+  {
+    setpgid(0, 0);
+
+    sigemptyset(&stEmptySet);
+    sigprocmask(SIG_SETMASK, &stEmptySet, NULL);
+    signal(SIGCHLD, SIG_DFL);
+
+    dup2(fileno(pstJob->fpOutput), STDOUT_FILENO);
+    dup2(fileno(pstJob->fpOutput), STDERR_FILENO);
+
+    apszArgs[0] = (char *) pstJob->kpszPath;
+    apszArgs[1] = NULL;
+
+    execv(pstJob->kpszPath, apszArgs);
+
+    fprintf(stderr, "E: Impossible execute %s: %s\n", pstJob->kpszPath, strerror(errno));
+
+    _exit(127);
+  }
+
+  /* In the parent too, the child can be killed before its setpgid() */
+  setpgid(pstJob->pid, pstJob->pid);
+
+  pstJob->eStatus = TEST_STATUS_RUNNING;
+
+  return true;
+}
+
+/**
+ * Read the output of the finished test, without the
+ * beginning when it is bigger than RUNNER_MAX_OUTPUT
+ */
+static void vReadTestOutput(PSTRUCT_TEST_JOB pstJob)
+{
+  long lSize = 0;
+  size_t lRead = 0;
+
+  if(pstJob->fpOutput == NULL)
+  {
+    return;
+  }
+
+  fseek(pstJob->fpOutput, 0, SEEK_END);
+
+  if((lSize = ftell(pstJob->fpOutput)) > RUNNER_MAX_OUTPUT)
+  {
+    fseek(pstJob->fpOutput, -RUNNER_MAX_OUTPUT, SEEK_END);
+    lSize = RUNNER_MAX_OUTPUT;
+  }
+  else
+  {
+    rewind(pstJob->fpOutput);
+  }
+
+  if(lSize > 0 && (pstJob->pszOutput = (char *) malloc(lSize + 1)) != NULL)
+  {
+    lRead = fread(pstJob->pszOutput, 1, lSize, pstJob->fpOutput);
+    pstJob->pszOutput[lRead] = '\0';
+  }
+
+  fclose(pstJob->fpOutput);
+  pstJob->fpOutput = NULL;
+}
+
+/**
+ * Result of the test, with the status of waitpid()
+ */
+static void vFinishTest(PSTRUCT_TEST_JOB pstJob, int iWaitStatus)
+{
+  pstJob->dElapsedMs = dNowMs() - pstJob->dStartMs;
+  pstJob->pid = 0;
+
+  /* The timeout already set the status */
+  if(pstJob->eStatus == TEST_STATUS_RUNNING)
+  {
+    if(WIFEXITED(iWaitStatus))
+    {
+      pstJob->iExitCode = WEXITSTATUS(iWaitStatus);
+      pstJob->eStatus = pstJob->iExitCode == 0 ? TEST_STATUS_PASSED : TEST_STATUS_FAILED;
+    }
+    else
+    {
+      pstJob->iSignal = WTERMSIG(iWaitStatus);
+      pstJob->eStatus = TEST_STATUS_SIGNALED;
+    }
+  }
+
+  vReadTestOutput(pstJob);
+}
+
+/**
+ * Print the lines of the output with a prefix
+ */
+static void vPrintPrefixedOutput(FILE *fpTap, const char *kpszOutput, const char *kpszPrefix)
+{
+  const char *kpszLine = kpszOutput;
+  const char *kpszEnd = NULL;
+
+  while(kpszLine != NULL && *kpszLine != '\0')
+  {
+    kpszEnd = strchr(kpszLine, '\n');
+
+    fprintf(fpTap, "%s%.*s\n", kpszPrefix, kpszEnd != NULL ? (int) (kpszEnd - kpszLine) : (int) strlen(kpszLine),
+            kpszLine);
+
+    kpszLine = kpszEnd != NULL ? kpszEnd + 1 : NULL;
+  }
+}
+
+/**
+ * TAP of the test, in the order that the tests end. The TAP of
+ * the binary is a subtest, with the cases of its TEST()s.
+ */
+static void vWriteTestTap(FILE *fpTap, PSTRUCT_TEST_JOB pstJob, int iNumber, bool bVerbose)
+{
+  bool bPassed = pstJob->eStatus == TEST_STATUS_PASSED;
+
+  if(!bPassed || bVerbose)
+  {
+    fprintf(fpTap, "# Subtest: %s\n", pstJob->kpszName);
+    vPrintPrefixedOutput(fpTap, pstJob->pszOutput, "    ");
+  }
+
+  fprintf(fpTap, "%s %d - %s\n", bPassed ? "ok" : "not ok", iNumber, pstJob->kpszName);
+  fprintf(fpTap, "  ---\n");
+  fprintf(fpTap, "  duration_ms: %.3f\n", pstJob->dElapsedMs);
+
+  switch(pstJob->eStatus)
+  {
+    case TEST_STATUS_FAILED:
+      fprintf(fpTap, "  exit_code: %d\n", pstJob->iExitCode);
+      break;
+    case TEST_STATUS_TIMEOUT:
+      fprintf(fpTap, "  message: timeout\n");
+      break;
+    case TEST_STATUS_SIGNALED:
+      fprintf(fpTap, "  signal: %s\n", strsignal(pstJob->iSignal));
+      break;
+    default:
+      break;
+  }
+
+  fprintf(fpTap, "  ...\n");
+  fflush(fpTap);
+}
+
+/**
+ * Write the text as XML, without the characters invalid in XML 1.0
+ */
+static void vWriteXmlText(FILE *fpJUnit, const char *kpszText)
+{
+  const unsigned char *kpucChar = NULL;
+
+  for(kpucChar = (const unsigned char *) kpszText; kpszText != NULL && *kpucChar != '\0'; kpucChar++)
+  {
+    switch(*kpucChar)
+    {
+      case '&':
+        fputs("&amp;", fpJUnit);
+        break;
+      case '<':
+        fputs("&lt;", fpJUnit);
+        break;
+      case '>':
+        fputs("&gt;", fpJUnit);
+        break;
+      case '"':
+        fputs("&quot;", fpJUnit);
+        break;
+      default:
+        fputc(*kpucChar < 0x20 && *kpucChar != '\n' && *kpucChar != '\t' ? '?' : *kpucChar, fpJUnit);
+        break;
+    }
+  }
+}
+
+/**
+ * JUnit of the tests, in the order of the command line
+ */
+static void vWriteJUnit(FILE *fpJUnit, PSTRUCT_TEST_JOB pastJobs, int iJobsCount, double dElapsedMs)
+{
+  int iFailures = 0;
+  int iErrors = 0;
+  int ii;
+
+  for(ii = 0; ii < iJobsCount; ii++)
+  {
+    if(pastJobs[ii].eStatus == TEST_STATUS_FAILED)
+    {
+      iFailures++;
+    }
+    else if(pastJobs[ii].eStatus != TEST_STATUS_PASSED)
+    {
+      iErrors++;
+    }
+  }
+
+  fprintf(fpJUnit, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+  fprintf(fpJUnit, "<testsuites tests=\"%d\" failures=\"%d\" errors=\"%d\" time=\"%.3f\">\n", iJobsCount,
+          iFailures, iErrors, dElapsedMs / 1e3);
+  fprintf(fpJUnit, "  <testsuite name=\"%s\" tests=\"%d\" failures=\"%d\" errors=\"%d\" time=\"%.3f\">\n",
+          RUNNER_PROJECT, iJobsCount, iFailures, iErrors, dElapsedMs / 1e3);
+
+  for(ii = 0; ii < iJobsCount; ii++)
+  {
+    fprintf(fpJUnit, "    <testcase classname=\"%s\" name=\"", RUNNER_PROJECT);
+    vWriteXmlText(fpJUnit, pastJobs[ii].kpszName);
+    fprintf(fpJUnit, "\" time=\"%.3f\">\n", pastJobs[ii].dElapsedMs / 1e3);
+
+    switch(pastJobs[ii].eStatus)
+    {
+      case TEST_STATUS_FAILED:
+        fprintf(fpJUnit, "      <failure message=\"exit code %d\"/>\n", pastJobs[ii].iExitCode);
+        break;
+      case TEST_STATUS_TIMEOUT:
+        fprintf(fpJUnit, "      <error message=\"timeout\"/>\n");
+        break;
+      case TEST_STATUS_SIGNALED:
+        fprintf(fpJUnit, "      <error message=\"");
+        vWriteXmlText(fpJUnit, strsignal(pastJobs[ii].iSignal));
+        fprintf(fpJUnit, "\"/>\n");
+        break;
+      default:
+        break;
+    }
+
+    if(pastJobs[ii].pszOutput != NULL)
+    {
+      fprintf(fpJUnit, "      <system-out>");
+      vWriteXmlText(fpJUnit, pastJobs[ii].pszOutput);
+      fprintf(fpJUnit, "</system-out>\n");
+    }
+
+    fprintf(fpJUnit, "    </testcase>\n");
+  }
+
+  fprintf(fpJUnit, "  </testsuite>\n");
+  fprintf(fpJUnit, "</testsuites>\n");
+}
+
+/**
+ * Print the help message of the runner
+ */
+static void vPrintRunnerUsage(const char *kpszProgramName)
+{
+  printf("Usage %s [options] <test>...\n\n"
+         "Options:\n"
+         "  --jobs=<number>, -j <number>\n"
+         "    Run <number> tests at the same time (default: number of CPUs)\n\n"
+         "  --timeout=<seconds>, -t <seconds>\n"
+         "    Kill the tests that run more than <seconds> (default %d, 0 is no timeout)\n\n"
+         "  --tap=<file>\n"
+         "    Write the TAP in <file> instead of the stdout\n\n"
+         "  --junit=<file>\n"
+         "    Write the results as JUnit XML in <file>\n\n"
+         "  --verbose, -v\n"
+         "    Show the output of the tests that passed too\n\n"
+         "  --help, -h\n"
+         "    Show this message and exit\n\n", kpszProgramName, RUNNER_TIMEOUT);
+}
+
+int main(int argc, char **argv)
+{
+  struct option astRunnerOpt[] = {
+    { "jobs"   , required_argument, 0, 'j' },
+    { "timeout", required_argument, 0, 't' },
+    { "tap"    , required_argument, 0, 'T' },
+    { "junit"  , required_argument, 0, 'J' },
+    { "verbose", no_argument      , 0, 'v' },
+    { "help"   , no_argument      , 0, 'h' },
+    { NULL     , 0                , 0,  0  }
+  };
+  struct sigaction stAction;
+  struct timespec stWait;
+  sigset_t stChildSet;
+  PSTRUCT_TEST_JOB pastJobs = NULL;
+  FILE *fpTap = stdout;
+  FILE *fpJUnit = NULL;
+  const char *kpszTap = NULL;
+  const char *kpszJUnit = NULL;
+  bool bVerbose = false;
+  double dStartMs = 0;
+  double dTimeoutMs = RUNNER_TIMEOUT * 1e3;
+  pid_t pid = 0;
+  int iWaitStatus = 0;
+  int iJobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+  int iJobsCount = 0;
+  int iNextJob = 0;
+  int iRunning = 0;
+  int iFinished = 0;
+  int iFailures = 0;
+  int iOpt = 0;
+  int ii;
+
+  while((iOpt = getopt_long(argc, argv, "j:t:vh", astRunnerOpt, NULL)) != -1)
+  {
+    switch(iOpt)
+    {
+      case 'j':
+        iJobs = atoi(optarg);
+        break;
+      case 't':
+        dTimeoutMs = atof(optarg) * 1e3;
+        break;
+      case 'T':
+        kpszTap = optarg;
+        break;
+      case 'J':
+        kpszJUnit = optarg;
+        break;
+      case 'v':
+        bVerbose = true;
+        break;
+      case 'h':
+        vPrintRunnerUsage(argv[0]);
+        return EXIT_SUCCESS;
+      default:
+        vPrintRunnerUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  if(iJobs < 1)
+  {
+    iJobs = 1;
+  }
+
+  iJobsCount = argc - optind;
+
+  if((pastJobs = (PSTRUCT_TEST_JOB) calloc(iJobsCount + 1, sizeof(STRUCT_TEST_JOB))) == NULL)
+  {
+    fprintf(stderr, "E: Impossible allocate memory to the tests\n");
+
+    return EXIT_FAILURE;
+  }
+
+  for(ii = 0; ii < iJobsCount; ii++)
+  {
+    pastJobs[ii].kpszPath = argv[optind + ii];
+    pastJobs[ii].kpszName = basename(argv[optind + ii]);
+  }
+
+  if(kpszTap != NULL && (fpTap = fopen(kpszTap, "w")) == NULL)
+  {
+    fprintf(stderr, "E: Impossible open the file %s: %s\n", kpszTap, strerror(errno));
+
+    free(pastJobs);
+
+    return EXIT_FAILURE;
+  }
+
+  /* The end of a test wakes up the runner, before the next poll of the timeouts */
+  memset(&stAction, 0, sizeof(stAction));
+  stAction.sa_handler = vHandleChild;
+  sigaction(SIGCHLD, &stAction, NULL);
+
+  sigemptyset(&stChildSet);
+  sigaddset(&stChildSet, SIGCHLD);
+  sigprocmask(SIG_BLOCK, &stChildSet, NULL);
+
+  fprintf(fpTap, "TAP version 14\n");
+  fprintf(fpTap, "1..%d\n", iJobsCount);
+  fflush(fpTap);
+
+  dStartMs = dNowMs();
+
+  while(iFinished < iJobsCount)
+  {
+    while(iRunning < iJobs && iNextJob < iJobsCount)
+    {
+      if(bStartTest(&pastJobs[iNextJob]))
+      {
+        iRunning++;
+      }
+      else
+      {
+        /* Can't run, as a binary that execv() doesn't find */
+        pastJobs[iNextJob].eStatus = TEST_STATUS_FAILED;
+        pastJobs[iNextJob].iExitCode = 127;
+        vWriteTestTap(fpTap, &pastJobs[iNextJob], ++iFinished, bVerbose);
+        iFailures++;
+      }
+
+      iNextJob++;
+    }
+
+    while(iRunning > 0 && (pid = waitpid(-1, &iWaitStatus, WNOHANG)) > 0)
+    {
+      for(ii = 0; ii < iJobsCount && pastJobs[ii].pid != pid; ii++);
+
+      if(ii == iJobsCount)
+      {
+        continue;
+      }
+
+      vFinishTest(&pastJobs[ii], iWaitStatus);
+      vWriteTestTap(fpTap, &pastJobs[ii], ++iFinished, bVerbose);
+
+      if(pastJobs[ii].eStatus != TEST_STATUS_PASSED)
+      {
+        iFailures++;
+      }
+
+      iRunning--;
+    }
+
+    if(iRunning == 0)
+    {
+      continue;
+    }
+
+    for(ii = 0; dTimeoutMs > 0 && ii < iJobsCount; ii++)
+    {
+      if(pastJobs[ii].eStatus == TEST_STATUS_RUNNING && dNowMs() - pastJobs[ii].dStartMs > dTimeoutMs)
+      {
+        pastJobs[ii].eStatus = TEST_STATUS_TIMEOUT;
+        kill(-pastJobs[ii].pid, SIGKILL);
+      }
+    }
+
+    /* Until a test ends, or the next check of the timeouts */
+    stWait.tv_sec = 0;
+    stWait.tv_nsec = 50 * 1000000L;
+    sigtimedwait(&stChildSet, NULL, &stWait);
+  }
+
+  fprintf(fpTap, "# %d tests, %d failed, %.3f s\n", iJobsCount, iFailures, (dNowMs() - dStartMs) / 1e3);
+
+  if(fpTap != stdout)
+  {
+    fclose(fpTap);
+  }
+
+  if(kpszJUnit != NULL)
+  {
+    if((fpJUnit = fopen(kpszJUnit, "w")) == NULL)
+    {
+      fprintf(stderr, "E: Impossible open the file %s: %s\n", kpszJUnit, strerror(errno));
+
+      iFailures++;
+    }
+    else
+    {
+      vWriteJUnit(fpJUnit, pastJobs, iJobsCount, dNowMs() - dStartMs);
+
+      fclose(fpJUnit);
+    }
+  }
+
+  for(ii = 0; ii < iJobsCount; ii++)
+  {
+    free(pastJobs[ii].pszOutput);
+  }
+
+  free(pastJobs);
+
+  return iFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
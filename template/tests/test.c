@@ -0,0 +1,137 @@
+/**
+ * test.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Framework of the unit tests of the project, each
+ *              tests/test_*.c file is a binary with its TEST()s
+ *
+ * Date: 19/10/2026
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include "test.h"
+
+/**
+ * Tests added by TEST(), in the order of the file
+ */
+static PSTRUCT_TEST gpstTestHead = NULL;
+static PSTRUCT_TEST gpstTestTail = NULL;
+
+/**
+ * The current test has a failed check
+ */
+static bool gbTestFailed = false;
+
+void vRegisterTest(PSTRUCT_TEST pstTest)
+{
+  pstTest->pstNext = NULL;
+
+  if(gpstTestTail == NULL)
+  {
+    gpstTestHead = pstTest;
+  }
+  else
+  {
+    gpstTestTail->pstNext = pstTest;
+  }
+
+  gpstTestTail = pstTest;
+}
+
+bool bTestCheck(bool bCond, const char *kpszFile, int iLine, const char *kpszFormat, ...)
+{
+  va_list vaArgs;
+
+  if(bCond)
+  {
+    return true;
+  }
+
+  gbTestFailed = true;
+
+  /* A TAP comment, before the "not ok" line of the test */
+  printf("# %s:%d: ", kpszFile, iLine);
+
+  va_start(vaArgs, kpszFormat);
+  vprintf(kpszFormat, vaArgs);
+  va_end(vaArgs);
+
+  printf("\n");
+  fflush(stdout);
+
+  return false;
+}
+
+/**
+ * Only the tests with one of the arguments in the name run
+ */
+static bool bTestSelected(PSTRUCT_TEST pstTest, int argc, char **argv)
+{
+  int ii;
+
+  if(argc < 2)
+  {
+    return true;
+  }
+
+  for(ii = 1; ii < argc; ii++)
+  {
+    if(strstr(pstTest->kpszName, argv[ii]) != NULL)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Run the tests of the binary, the output is TAP
+ */
+int main(int argc, char **argv)
+{
+  PSTRUCT_TEST pstTest = NULL;
+  struct timespec stStart;
+  struct timespec stEnd;
+  double dElapsedMs = 0;
+  int iTestsCount = 0;
+  int iFailures = 0;
+
+  for(pstTest = gpstTestHead; pstTest != NULL; pstTest = pstTest->pstNext)
+  {
+    if(!bTestSelected(pstTest, argc, argv))
+    {
+      continue;
+    }
+
+    gbTestFailed = false;
+    iTestsCount++;
+
+    clock_gettime(CLOCK_MONOTONIC, &stStart);
+    pstTest->pfnTest();
+    clock_gettime(CLOCK_MONOTONIC, &stEnd);
+
+    dElapsedMs = (stEnd.tv_sec - stStart.tv_sec) * 1e3 + (stEnd.tv_nsec - stStart.tv_nsec) / 1e6;
+
+    printf("%s %d - %s (%.3f ms)\n", gbTestFailed ? "not ok" : "ok", iTestsCount, pstTest->kpszName, dElapsedMs);
+    fflush(stdout);
+
+    if(gbTestFailed)
+    {
+      iFailures++;
+    }
+  }
+
+  printf("1..%d\n", iTestsCount);
+
+  if(iFailures > 0)
+  {
+    printf("# %d of %d tests failed\n", iFailures, iTestsCount);
+  }
+
+  return iFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
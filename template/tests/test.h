@@ -0,0 +1,127 @@
+/**
+ * test.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Framework of the unit tests of the project, each
+ *              tests/test_*.c file is a binary with its TEST()s
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A test, added before main() to the tests of the binary
+ *
+ * Example:
+ *   TEST(parse_empty_line)
+ *   {
+ *     TEST_ASSERT(pstParse("") != NULL);
+ *     TEST_EQUAL_INT(iCount, 0);
+ *   }
+ */
+#define TEST(xName) \
+  static void vTest_##xName(void); \
+  static STRUCT_TEST gstTest_##xName = { #xName, vTest_##xName, __FILE__, __LINE__, NULL }; \
+  static void __attribute__((constructor)) vRegisterTest_##xName(void) \
+  { \
+    vRegisterTest(&gstTest_##xName); \
+  } \
+  static void vTest_##xName(void)
+
+/**
+ * The test fails and goes on
+ */
+#define TEST_CHECK(xCond) \
+  bTestCheck((xCond), __FILE__, __LINE__, "TEST_CHECK(%s)", #xCond)
+
+/**
+ * The test fails and ends, the next checks need the condition
+ */
+#define TEST_ASSERT(xCond) \
+  do \
+  { \
+    if(!bTestCheck((xCond), __FILE__, __LINE__, "TEST_ASSERT(%s)", #xCond)) \
+    { \
+      return; \
+    } \
+  } while(0)
+
+/**
+ * Comparisons that print the two values when they fail
+ */
+#define TEST_EQUAL_INT(xFirst, xSecond) \
+  do \
+  { \
+    long long llFirst_ = (long long) (xFirst); \
+    long long llSecond_ = (long long) (xSecond); \
+    bTestCheck(llFirst_ == llSecond_, __FILE__, __LINE__, "TEST_EQUAL_INT(%s, %s): %lld != %lld", \
+               #xFirst, #xSecond, llFirst_, llSecond_); \
+  } while(0)
+
+#define TEST_EQUAL_STR(xFirst, xSecond) \
+  do \
+  { \
+    const char *kpszFirst_ = (xFirst); \
+    const char *kpszSecond_ = (xSecond); \
+    bTestCheck(kpszFirst_ != NULL && kpszSecond_ != NULL && strcmp(kpszFirst_, kpszSecond_) == 0, \
+               __FILE__, __LINE__, "TEST_EQUAL_STR(%s, %s): \"%s\" != \"%s\"", #xFirst, #xSecond, \
+               kpszFirst_ != NULL ? kpszFirst_ : "(null)", kpszSecond_ != NULL ? kpszSecond_ : "(null)"); \
+  } while(0)
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A test of the binary
+ */
+typedef struct STRUCT_TEST
+{
+  const char *kpszName;
+  void (*pfnTest)(void);
+  const char *kpszFile;
+  int iLine;
+  struct STRUCT_TEST *pstNext;
+} STRUCT_TEST, *PSTRUCT_TEST;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Add the test after the ones added before, used by TEST()
+ */
+void vRegisterTest(PSTRUCT_TEST pstTest);
+
+/**
+ * Print the message and fail the current test when
+ * bCond is false, used by the TEST_* macros
+ */
+bool bTestCheck(bool bCond, const char *kpszFile, int iLine, const char *kpszFormat, ...)
+  __attribute__((format(printf, 4, 5)));
+
+#endif /* _TEST_H_ */
@@ -0,0 +1,48 @@
+/**
+ * test_template.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the project, run by "make test"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdlib.h>
+#include "test.h"
+
+/**
+ * Example: replace it by the functions of the project
+ * (#include "template.h"). Each tests/test_*.c file is a
+ * binary, and the binaries run in parallel.
+ */
+TEST(string_compare)
+{
+  char szName[16];
+
+  snprintf(szName, sizeof(szName), "%s-%d", "test", 1);
+
+  TEST_EQUAL_STR(szName, "test-1");
+  TEST_CHECK(strncmp(szName, "test", 4) == 0);
+}
+
+/**
+ * Example with TEST_ASSERT: the next checks use the pointer
+ */
+TEST(allocation)
+{
+  int *piValues = NULL;
+  int ii;
+
+  piValues = (int *) calloc(8, sizeof(int));
+  TEST_ASSERT(piValues != NULL);
+
+  for(ii = 0; ii < 8; ii++)
+  {
+    piValues[ii] = ii * ii;
+  }
+
+  TEST_EQUAL_INT(piValues[7], 49);
+
+  free(piValues);
+}
@@ -0,0 +1,69 @@
+/**
+ * bench_arena.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of the arena allocator against malloc()
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdlib.h>
+#include "bench.h"
+#include "arena.h"
+
+/**
+ * Allocations of each reset of the arena
+ */
+#define BENCH_ARENA_BATCH 1024
+
+static void vBenchArenaAlloc64(uint64_t ui64Iterations, void *pvArg)
+{
+  STRUCT_ARENA stArena;
+  void *pvPtr = NULL;
+  uint64_t ii;
+
+  (void) pvArg;
+
+  vArenaInit(&stArena, 0);
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    if(ii % BENCH_ARENA_BATCH == 0)
+    {
+      vArenaReset(&stArena);
+    }
+
+    pvPtr = pvArenaAlloc(&stArena, 64);
+    BENCH_DO_NOT_OPTIMIZE(pvPtr);
+  }
+
+  vArenaDestroy(&stArena);
+}
+
+static void vBenchMalloc64(uint64_t ui64Iterations, void *pvArg)
+{
+  void *apvPtrs[BENCH_ARENA_BATCH];
+  uint64_t ii;
+  int jj;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    apvPtrs[ii % BENCH_ARENA_BATCH] = malloc(64);
+    BENCH_DO_NOT_OPTIMIZE(apvPtrs[ii % BENCH_ARENA_BATCH]);
+
+    /* The same lifetime of the allocations of the arena */
+    if(ii % BENCH_ARENA_BATCH == BENCH_ARENA_BATCH - 1 || ii == ui64Iterations - 1)
+    {
+      for(jj = 0; jj <= (int) (ii % BENCH_ARENA_BATCH); jj++)
+      {
+        free(apvPtrs[jj]);
+      }
+    }
+  }
+}
+
+BENCH_REGISTER("arena_alloc_64", vBenchArenaAlloc64, NULL)
+BENCH_REGISTER("arena_malloc_64", vBenchMalloc64, NULL)
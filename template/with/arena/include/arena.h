@@ -0,0 +1,127 @@
+/**
+ * arena.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Arena (bump) allocator, the memory of many
+ *              allocations is freed at once
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Size of each block of the arena, when
+ * vArenaInit() receives 0
+ */
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+/**
+ * Alignment of pvArenaAlloc(), the same of malloc()
+ */
+#define ARENA_ALIGN _Alignof(max_align_t)
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A block of memory of the arena, the allocations
+ * are taken from the begin to the end of aucData
+ */
+typedef struct STRUCT_ARENA_BLOCK
+{
+  struct STRUCT_ARENA_BLOCK *pstPrev;
+  size_t lSize;
+  size_t lUsed;
+  _Alignas(max_align_t) unsigned char aucData[];
+} STRUCT_ARENA_BLOCK, *PSTRUCT_ARENA_BLOCK;
+
+/**
+ * The arena, the last block is the one in use.
+ * It isn't thread safe, use one arena by thread.
+ */
+typedef struct STRUCT_ARENA
+{
+  PSTRUCT_ARENA_BLOCK pstBlock;
+  size_t lBlockSize;
+} STRUCT_ARENA, *PSTRUCT_ARENA;
+
+/**
+ * Position of the arena, to free everything allocated after it
+ */
+typedef struct STRUCT_ARENA_MARK
+{
+  PSTRUCT_ARENA_BLOCK pstBlock;
+  size_t lUsed;
+} STRUCT_ARENA_MARK, *PSTRUCT_ARENA_MARK;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Empty arena, the first block is allocated by the first
+ * allocation. lBlockSize 0 is ARENA_BLOCK_SIZE.
+ */
+void vArenaInit(PSTRUCT_ARENA pstArena, size_t lBlockSize);
+
+/**
+ * lSize bytes aligned to lAlign (a power of 2), NULL when
+ * malloc() fails. A bigger allocation than the block has its
+ * own block.
+ */
+void *pvArenaAllocAligned(PSTRUCT_ARENA pstArena, size_t lSize, size_t lAlign);
+
+/**
+ * lSize bytes aligned to ARENA_ALIGN
+ */
+void *pvArenaAlloc(PSTRUCT_ARENA pstArena, size_t lSize);
+
+/**
+ * Copy of the string in the arena
+ */
+char *pszArenaStrdup(PSTRUCT_ARENA pstArena, const char *kpszString);
+
+/**
+ * Current position of the arena
+ */
+STRUCT_ARENA_MARK stArenaMark(PSTRUCT_ARENA pstArena);
+
+/**
+ * Free everything allocated after the mark
+ */
+void vArenaRewind(PSTRUCT_ARENA pstArena, STRUCT_ARENA_MARK stMark);
+
+/**
+ * Free every allocation, only the last block
+ * is kept to the next allocations
+ */
+void vArenaReset(PSTRUCT_ARENA pstArena);
+
+/**
+ * Free the blocks of the arena
+ */
+void vArenaDestroy(PSTRUCT_ARENA pstArena);
+
+#endif /* _ARENA_H_ */
@@ -0,0 +1,159 @@
+/**
+ * arena.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Arena (bump) allocator, the memory of many
+ *              allocations is freed at once
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+void vArenaInit(PSTRUCT_ARENA pstArena, size_t lBlockSize)
+{
+  memset(pstArena, 0, sizeof(STRUCT_ARENA));
+
+  pstArena->lBlockSize = lBlockSize == 0 ? ARENA_BLOCK_SIZE : lBlockSize;
+}
+
+/**
+ * New block with at least lSize bytes after the alignment
+ */
+static PSTRUCT_ARENA_BLOCK pstArenaNewBlock(PSTRUCT_ARENA pstArena, size_t lSize, size_t lAlign)
+{
+  PSTRUCT_ARENA_BLOCK pstBlock = NULL;
+  size_t lBlockSize = pstArena->lBlockSize;
+
+  if(lSize > SIZE_MAX - sizeof(STRUCT_ARENA_BLOCK) - lAlign)
+  {
+    return NULL;
+  }
+
+  if(lBlockSize < lSize + lAlign)
+  {
+    lBlockSize = lSize + lAlign;
+  }
+
+  if((pstBlock = (PSTRUCT_ARENA_BLOCK) malloc(sizeof(STRUCT_ARENA_BLOCK) + lBlockSize)) == NULL)
+  {
+    return NULL;
+  }
+
+  pstBlock->pstPrev = pstArena->pstBlock;
+  pstBlock->lSize = lBlockSize;
+  pstBlock->lUsed = 0;
+
+  pstArena->pstBlock = pstBlock;
+
+  return pstBlock;
+}
+
+void *pvArenaAllocAligned(PSTRUCT_ARENA pstArena, size_t lSize, size_t lAlign)
+{
+  PSTRUCT_ARENA_BLOCK pstBlock = pstArena->pstBlock;
+  size_t lPadding = 0;
+
+  if(lAlign == 0 || (lAlign & (lAlign - 1)) != 0)
+  {
+    return NULL;
+  }
+
+  if(pstBlock != NULL)
+  {
+    lPadding = -(uintptr_t) (pstBlock->aucData + pstBlock->lUsed) & (lAlign - 1);
+  }
+
+  /* The common case: the allocation is in the current block */
+  if(pstBlock == NULL || lPadding > pstBlock->lSize - pstBlock->lUsed ||
+     lSize > pstBlock->lSize - pstBlock->lUsed - lPadding)
+  {
+    if((pstBlock = pstArenaNewBlock(pstArena, lSize, lAlign)) == NULL)
+    {
+      return NULL;
+    }
+
+    lPadding = -(uintptr_t) pstBlock->aucData & (lAlign - 1);
+  }
+
+  pstBlock->lUsed += lPadding + lSize;
+
+  return pstBlock->aucData + pstBlock->lUsed - lSize;
+}
+
+void *pvArenaAlloc(PSTRUCT_ARENA pstArena, size_t lSize)
+{
+  return pvArenaAllocAligned(pstArena, lSize, ARENA_ALIGN);
+}
+
+char *pszArenaStrdup(PSTRUCT_ARENA pstArena, const char *kpszString)
+{
+  size_t lSize = strlen(kpszString) + 1;
+  char *pszCopy = NULL;
+
+  if((pszCopy = (char *) pvArenaAllocAligned(pstArena, lSize, 1)) != NULL)
+  {
+    memcpy(pszCopy, kpszString, lSize);
+  }
+
+  return pszCopy;
+}
+
+STRUCT_ARENA_MARK stArenaMark(PSTRUCT_ARENA pstArena)
+{
+  STRUCT_ARENA_MARK stMark;
+
+  stMark.pstBlock = pstArena->pstBlock;
+  stMark.lUsed = pstArena->pstBlock != NULL ? pstArena->pstBlock->lUsed : 0;
+
+  return stMark;
+}
+
+void vArenaRewind(PSTRUCT_ARENA pstArena, STRUCT_ARENA_MARK stMark)
+{
+  PSTRUCT_ARENA_BLOCK pstPrev = NULL;
+
+  while(pstArena->pstBlock != NULL && pstArena->pstBlock != stMark.pstBlock)
+  {
+    pstPrev = pstArena->pstBlock->pstPrev;
+    free(pstArena->pstBlock);
+    pstArena->pstBlock = pstPrev;
+  }
+
+  if(pstArena->pstBlock != NULL)
+  {
+    pstArena->pstBlock->lUsed = stMark.lUsed;
+  }
+}
+
+void vArenaReset(PSTRUCT_ARENA pstArena)
+{
+  PSTRUCT_ARENA_BLOCK pstPrev = NULL;
+
+  if(pstArena->pstBlock == NULL)
+  {
+    return;
+  }
+
+  while(pstArena->pstBlock->pstPrev != NULL)
+  {
+    pstPrev = pstArena->pstBlock->pstPrev->pstPrev;
+    free(pstArena->pstBlock->pstPrev);
+    pstArena->pstBlock->pstPrev = pstPrev;
+  }
+
+  pstArena->pstBlock->lUsed = 0;
+}
+
+void vArenaDestroy(PSTRUCT_ARENA pstArena)
+{
+  STRUCT_ARENA_MARK stEmpty;
+
+  memset(&stEmpty, 0, sizeof(stEmpty));
+
+  vArenaRewind(pstArena, stEmpty);
+}
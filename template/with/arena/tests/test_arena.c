@@ -0,0 +1,97 @@
+/**
+ * test_arena.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the arena allocator, run by "make test"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "arena.h"
+
+TEST(alignment)
+{
+  STRUCT_ARENA stArena;
+  size_t lAlign;
+  void *pvPtr = NULL;
+
+  vArenaInit(&stArena, 256);
+
+  TEST_CHECK(((uintptr_t) pvArenaAlloc(&stArena, 1) & (ARENA_ALIGN - 1)) == 0);
+  TEST_CHECK(((uintptr_t) pvArenaAlloc(&stArena, 3) & (ARENA_ALIGN - 1)) == 0);
+
+  for(lAlign = 1; lAlign <= 4096; lAlign <<= 1)
+  {
+    pvPtr = pvArenaAllocAligned(&stArena, 7, lAlign);
+
+    TEST_CHECK(pvPtr != NULL && ((uintptr_t) pvPtr & (lAlign - 1)) == 0);
+  }
+
+  TEST_CHECK(pvArenaAllocAligned(&stArena, 8, 3) == NULL);
+
+  vArenaDestroy(&stArena);
+}
+
+TEST(blocks)
+{
+  STRUCT_ARENA stArena;
+  char *apszPtrs[100];
+  char *pszBig = NULL;
+  int ii;
+
+  vArenaInit(&stArena, 128);
+
+  /* The allocations of the full blocks stay valid */
+  for(ii = 0; ii < 100; ii++)
+  {
+    apszPtrs[ii] = (char *) pvArenaAlloc(&stArena, 24);
+    memset(apszPtrs[ii], ii, 24);
+  }
+
+  for(ii = 0; ii < 100; ii++)
+  {
+    TEST_CHECK(apszPtrs[ii][0] == ii && apszPtrs[ii][23] == ii);
+  }
+
+  pszBig = (char *) pvArenaAlloc(&stArena, 10000);
+  TEST_CHECK(pszBig != NULL);
+  memset(pszBig, 0x5A, 10000);
+
+  TEST_CHECK(strcmp(pszArenaStrdup(&stArena, "arena"), "arena") == 0);
+
+  vArenaDestroy(&stArena);
+  TEST_CHECK(stArena.pstBlock == NULL);
+}
+
+TEST(mark_and_reset)
+{
+  STRUCT_ARENA stArena;
+  STRUCT_ARENA_MARK stMark;
+  void *pvAfterMark = NULL;
+  int ii;
+
+  vArenaInit(&stArena, 64);
+
+  pvArenaAlloc(&stArena, 16);
+  stMark = stArenaMark(&stArena);
+  pvAfterMark = pvArenaAlloc(&stArena, 16);
+
+  for(ii = 0; ii < 50; ii++)
+  {
+    pvArenaAlloc(&stArena, 32);
+  }
+
+  /* The memory after the mark is given again */
+  vArenaRewind(&stArena, stMark);
+  TEST_CHECK(pvArenaAlloc(&stArena, 16) == pvAfterMark);
+
+  vArenaReset(&stArena);
+  TEST_CHECK(stArena.pstBlock != NULL && stArena.pstBlock->pstPrev == NULL && stArena.pstBlock->lUsed == 0);
+
+  vArenaDestroy(&stArena);
+}
@@ -0,0 +1,62 @@
+/**
+ * bench_pool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of the object pool against malloc()
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdlib.h>
+#include "bench.h"
+#include "pool.h"
+
+/**
+ * Objects alive at the same time
+ */
+#define BENCH_POOL_LIVE 64
+
+static void vBenchPoolAllocFree(uint64_t ui64Iterations, void *pvArg)
+{
+  STRUCT_POOL stPool;
+  void *apvObjects[BENCH_POOL_LIVE] = { NULL };
+  uint64_t ii;
+
+  (void) pvArg;
+
+  bPoolInit(&stPool, 96, 0);
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    vPoolFree(&stPool, apvObjects[ii % BENCH_POOL_LIVE]);
+    apvObjects[ii % BENCH_POOL_LIVE] = pvPoolAlloc(&stPool);
+    BENCH_DO_NOT_OPTIMIZE(apvObjects[ii % BENCH_POOL_LIVE]);
+  }
+
+  vPoolDestroy(&stPool);
+}
+
+static void vBenchMallocFree(uint64_t ui64Iterations, void *pvArg)
+{
+  void *apvObjects[BENCH_POOL_LIVE] = { NULL };
+  uint64_t ii;
+  int jj;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    free(apvObjects[ii % BENCH_POOL_LIVE]);
+    apvObjects[ii % BENCH_POOL_LIVE] = malloc(96);
+    BENCH_DO_NOT_OPTIMIZE(apvObjects[ii % BENCH_POOL_LIVE]);
+  }
+
+  for(jj = 0; jj < BENCH_POOL_LIVE; jj++)
+  {
+    free(apvObjects[jj]);
+  }
+}
+
+BENCH_REGISTER("pool_alloc_free_96", vBenchPoolAllocFree, NULL)
+BENCH_REGISTER("pool_malloc_free_96", vBenchMallocFree, NULL)
@@ -0,0 +1,102 @@
+/**
+ * pool.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Pool of objects of the same size, the allocation
+ *              and the free are a pop and a push of a free list
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Objects of each chunk, when bPoolInit() receives 0
+ */
+#define POOL_OBJECTS_PER_CHUNK 256
+
+/**
+ * Alignment of the objects, the same of malloc()
+ */
+#define POOL_ALIGN _Alignof(max_align_t)
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * A free object keeps the next free object in its first bytes
+ */
+typedef struct STRUCT_POOL_FREE
+{
+  struct STRUCT_POOL_FREE *pstNext;
+} STRUCT_POOL_FREE, *PSTRUCT_POOL_FREE;
+
+/**
+ * Objects allocated together by one malloc()
+ */
+typedef struct STRUCT_POOL_CHUNK
+{
+  struct STRUCT_POOL_CHUNK *pstNext;
+  _Alignas(max_align_t) unsigned char aucObjects[];
+} STRUCT_POOL_CHUNK, *PSTRUCT_POOL_CHUNK;
+
+/**
+ * The pool. It isn't thread safe, use one pool by thread.
+ */
+typedef struct STRUCT_POOL
+{
+  size_t lObjectSize;         /* Size asked, rounded up to POOL_ALIGN */
+  size_t lObjectsPerChunk;
+  size_t lInUse;              /* Objects allocated and not freed      */
+  PSTRUCT_POOL_FREE pstFree;
+  PSTRUCT_POOL_CHUNK pstChunks;
+} STRUCT_POOL, *PSTRUCT_POOL;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Empty pool of objects of lObjectSize bytes, the chunks
+ * are allocated when needed. lObjectsPerChunk 0 is
+ * POOL_OBJECTS_PER_CHUNK.
+ */
+bool bPoolInit(PSTRUCT_POOL pstPool, size_t lObjectSize, size_t lObjectsPerChunk);
+
+/**
+ * An object of the pool, NULL when malloc() fails
+ */
+void *pvPoolAlloc(PSTRUCT_POOL pstPool);
+
+/**
+ * Give the object back to the pool, it must be of this pool
+ */
+void vPoolFree(PSTRUCT_POOL pstPool, void *pvObject);
+
+/**
+ * Free the chunks, every object of the pool is freed
+ */
+void vPoolDestroy(PSTRUCT_POOL pstPool);
+
+#endif /* _POOL_H_ */
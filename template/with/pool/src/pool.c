@@ -0,0 +1,110 @@
+/**
+ * pool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Pool of objects of the same size, the allocation
+ *              and the free are a pop and a push of a free list
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pool.h"
+
+bool bPoolInit(PSTRUCT_POOL pstPool, size_t lObjectSize, size_t lObjectsPerChunk)
+{
+  memset(pstPool, 0, sizeof(STRUCT_POOL));
+
+  if(lObjectSize == 0 || lObjectSize > SIZE_MAX / 2)
+  {
+    return false;
+  }
+
+  /* A free object must hold the pointer of the free list */
+  if(lObjectSize < sizeof(STRUCT_POOL_FREE))
+  {
+    lObjectSize = sizeof(STRUCT_POOL_FREE);
+  }
+
+  pstPool->lObjectSize = (lObjectSize + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+  pstPool->lObjectsPerChunk = lObjectsPerChunk == 0 ? POOL_OBJECTS_PER_CHUNK : lObjectsPerChunk;
+
+  return pstPool->lObjectsPerChunk <= (SIZE_MAX - sizeof(STRUCT_POOL_CHUNK)) / pstPool->lObjectSize;
+}
+
+/**
+ * New chunk, its objects go to the free list
+ */
+static bool bPoolNewChunk(PSTRUCT_POOL pstPool)
+{
+  PSTRUCT_POOL_CHUNK pstChunk = NULL;
+  PSTRUCT_POOL_FREE pstObject = NULL;
+  size_t ii;
+
+  if((pstChunk = (PSTRUCT_POOL_CHUNK) malloc(sizeof(STRUCT_POOL_CHUNK) +
+                                             pstPool->lObjectSize * pstPool->lObjectsPerChunk)) == NULL)
+  {
+    return false;
+  }
+
+  pstChunk->pstNext = pstPool->pstChunks;
+  pstPool->pstChunks = pstChunk;
+
+  /* From the end, so the objects are given in the order of the memory */
+  for(ii = pstPool->lObjectsPerChunk; ii > 0; ii--)
+  {
+    pstObject = (PSTRUCT_POOL_FREE) (pstChunk->aucObjects + (ii - 1) * pstPool->lObjectSize);
+    pstObject->pstNext = pstPool->pstFree;
+    pstPool->pstFree = pstObject;
+  }
+
+  return true;
+}
+
+void *pvPoolAlloc(PSTRUCT_POOL pstPool)
+{
+  PSTRUCT_POOL_FREE pstObject = NULL;
+
+  if(pstPool->pstFree == NULL && !bPoolNewChunk(pstPool))
+  {
+    return NULL;
+  }
+
+  pstObject = pstPool->pstFree;
+  pstPool->pstFree = pstObject->pstNext;
+  pstPool->lInUse++;
+
+  return pstObject;
+}
+
+void vPoolFree(PSTRUCT_POOL pstPool, void *pvObject)
+{
+  PSTRUCT_POOL_FREE pstObject = (PSTRUCT_POOL_FREE) pvObject;
+
+  if(pvObject == NULL)
+  {
+    return;
+  }
+
+  pstObject->pstNext = pstPool->pstFree;
+  pstPool->pstFree = pstObject;
+  pstPool->lInUse--;
+}
+
+void vPoolDestroy(PSTRUCT_POOL pstPool)
+{
+  PSTRUCT_POOL_CHUNK pstNext = NULL;
+
+  while(pstPool->pstChunks != NULL)
+  {
+    pstNext = pstPool->pstChunks->pstNext;
+    free(pstPool->pstChunks);
+    pstPool->pstChunks = pstNext;
+  }
+
+  pstPool->pstFree = NULL;
+  pstPool->lInUse = 0;
+}
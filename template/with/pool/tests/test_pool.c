@@ -0,0 +1,69 @@
+/**
+ * test_pool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the object pool, run by "make test"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "pool.h"
+
+TEST(init)
+{
+  STRUCT_POOL stPool;
+
+  TEST_CHECK(!bPoolInit(&stPool, 0, 0));
+
+  /* Small objects still hold the pointer of the free list */
+  TEST_CHECK(bPoolInit(&stPool, 1, 0));
+  TEST_CHECK(stPool.lObjectSize >= sizeof(void *) && stPool.lObjectSize % POOL_ALIGN == 0);
+  TEST_CHECK(stPool.lObjectsPerChunk == POOL_OBJECTS_PER_CHUNK);
+
+  vPoolDestroy(&stPool);
+}
+
+TEST(alloc_free)
+{
+  STRUCT_POOL stPool;
+  unsigned char *apucObjects[1000];
+  int ii;
+
+  TEST_CHECK(bPoolInit(&stPool, 40, 16));
+
+  for(ii = 0; ii < 1000; ii++)
+  {
+    apucObjects[ii] = (unsigned char *) pvPoolAlloc(&stPool);
+
+    TEST_CHECK(apucObjects[ii] != NULL && ((uintptr_t) apucObjects[ii] & (POOL_ALIGN - 1)) == 0);
+
+    memset(apucObjects[ii], ii & 0xFF, 40);
+  }
+
+  TEST_CHECK(stPool.lInUse == 1000);
+
+  /* No object overlaps another one */
+  for(ii = 0; ii < 1000; ii++)
+  {
+    TEST_CHECK(apucObjects[ii][0] == (ii & 0xFF) && apucObjects[ii][39] == (ii & 0xFF));
+  }
+
+  /* The last freed object is the next one given */
+  vPoolFree(&stPool, apucObjects[500]);
+  TEST_CHECK(pvPoolAlloc(&stPool) == apucObjects[500]);
+
+  for(ii = 0; ii < 1000; ii++)
+  {
+    vPoolFree(&stPool, apucObjects[ii]);
+  }
+
+  TEST_CHECK(stPool.lInUse == 0);
+
+  vPoolDestroy(&stPool);
+  TEST_CHECK(stPool.pstChunks == NULL);
+}
@@ -0,0 +1,57 @@
+/**
+ * bench_ringbuffer.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of a push and a pop of the ring buffers
+ *              in the same thread, without the cost of the contention
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include "bench.h"
+#include "ringbuffer.h"
+
+static void vBenchSpscPushPop(uint64_t ui64Iterations, void *pvArg)
+{
+  static STRUCT_SPSC_RING stRing;
+  void *pvData = NULL;
+  uint64_t ii;
+
+  (void) pvArg;
+
+  bSpscRingInit(&stRing, 1024);
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    bSpscRingPush(&stRing, (void *) (uintptr_t) ii);
+    bSpscRingPop(&stRing, &pvData);
+    BENCH_DO_NOT_OPTIMIZE(pvData);
+  }
+
+  vSpscRingDestroy(&stRing);
+}
+
+static void vBenchMpmcPushPop(uint64_t ui64Iterations, void *pvArg)
+{
+  static STRUCT_MPMC_RING stRing;
+  void *pvData = NULL;
+  uint64_t ii;
+
+  (void) pvArg;
+
+  bMpmcRingInit(&stRing, 1024);
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    bMpmcRingPush(&stRing, (void *) (uintptr_t) ii);
+    bMpmcRingPop(&stRing, &pvData);
+    BENCH_DO_NOT_OPTIMIZE(pvData);
+  }
+
+  vMpmcRingDestroy(&stRing);
+}
+
+BENCH_REGISTER("ringbuffer_spsc_push_pop", vBenchSpscPushPop, NULL)
+BENCH_REGISTER("ringbuffer_mpmc_push_pop", vBenchMpmcPushPop, NULL)
@@ -0,0 +1,128 @@
+/**
+ * ringbuffer.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Bounded lock-free ring buffers of pointers, one
+ *              producer and one consumer (SPSC) or many of each
+ *              one (MPMC)
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _RINGBUFFER_H_
+#define _RINGBUFFER_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The indexes written by different threads are in different
+ * cache lines, otherwise each write invalidates the line of the
+ * other thread (false sharing). A ring allocated in the heap
+ * must use aligned_alloc(RING_CACHE_LINE, ...).
+ */
+#define RING_CACHE_LINE 64
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Ring of one producer and one consumer. Each side keeps
+ * a copy of the index of the other one and reads it again
+ * only when the ring seems full (or empty).
+ */
+typedef struct STRUCT_SPSC_RING
+{
+  _Alignas(RING_CACHE_LINE) atomic_size_t lHead; /* Next slot read, by the consumer     */
+  size_t lTailCache;                              /* Last lTail seen by the consumer     */
+  _Alignas(RING_CACHE_LINE) atomic_size_t lTail; /* Next slot written, by the producer  */
+  size_t lHeadCache;                              /* Last lHead seen by the producer     */
+  _Alignas(RING_CACHE_LINE) size_t lMask;        /* Capacity - 1, read only             */
+  void **ppvSlots;
+} STRUCT_SPSC_RING, *PSTRUCT_SPSC_RING;
+
+/**
+ * A slot of the MPMC ring, lSequence says if it can be
+ * written or read in the current lap of the ring
+ */
+typedef struct STRUCT_MPMC_CELL
+{
+  atomic_size_t lSequence;
+  void *pvData;
+} STRUCT_MPMC_CELL, *PSTRUCT_MPMC_CELL;
+
+/**
+ * Ring of many producers and many consumers (Vyukov's
+ * bounded queue), a compare and swap by operation
+ */
+typedef struct STRUCT_MPMC_RING
+{
+  _Alignas(RING_CACHE_LINE) atomic_size_t lEnqueuePos;
+  _Alignas(RING_CACHE_LINE) atomic_size_t lDequeuePos;
+  _Alignas(RING_CACHE_LINE) size_t lMask;
+  PSTRUCT_MPMC_CELL pastCells;
+} STRUCT_MPMC_RING, *PSTRUCT_MPMC_RING;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Empty ring, lCapacity is rounded up to a power of 2
+ */
+bool bSpscRingInit(PSTRUCT_SPSC_RING pstRing, size_t lCapacity);
+
+/**
+ * Only the producer calls it, false when the ring is full
+ */
+bool bSpscRingPush(PSTRUCT_SPSC_RING pstRing, void *pvData);
+
+/**
+ * Only the consumer calls it, false when the ring is empty
+ */
+bool bSpscRingPop(PSTRUCT_SPSC_RING pstRing, void **ppvData);
+
+/**
+ * Free the slots of the ring
+ */
+void vSpscRingDestroy(PSTRUCT_SPSC_RING pstRing);
+
+/**
+ * Empty ring, lCapacity is rounded up to a power of 2 (at least 2)
+ */
+bool bMpmcRingInit(PSTRUCT_MPMC_RING pstRing, size_t lCapacity);
+
+/**
+ * Any thread calls it, false when the ring is full
+ */
+bool bMpmcRingPush(PSTRUCT_MPMC_RING pstRing, void *pvData);
+
+/**
+ * Any thread calls it, false when the ring is empty
+ */
+bool bMpmcRingPop(PSTRUCT_MPMC_RING pstRing, void **ppvData);
+
+/**
+ * Free the cells of the ring
+ */
+void vMpmcRingDestroy(PSTRUCT_MPMC_RING pstRing);
+
+#endif /* _RINGBUFFER_H_ */
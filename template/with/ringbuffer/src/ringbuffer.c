@@ -0,0 +1,214 @@
+/**
+ * ringbuffer.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Bounded lock-free ring buffers of pointers, one
+ *              producer and one consumer (SPSC) or many of each
+ *              one (MPMC)
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ringbuffer.h"
+
+/**
+ * Power of 2 >= lCapacity, 0 on overflow
+ */
+static size_t lRingCapacity(size_t lCapacity)
+{
+  size_t lPower = 1;
+
+  while(lPower < lCapacity)
+  {
+    if(lPower > SIZE_MAX / 2)
+    {
+      return 0;
+    }
+
+    lPower <<= 1;
+  }
+
+  return lPower;
+}
+
+bool bSpscRingInit(PSTRUCT_SPSC_RING pstRing, size_t lCapacity)
+{
+  memset(pstRing, 0, sizeof(STRUCT_SPSC_RING));
+
+  if((lCapacity = lRingCapacity(lCapacity)) == 0 ||
+     (pstRing->ppvSlots = (void **) calloc(lCapacity, sizeof(void *))) == NULL)
+  {
+    return false;
+  }
+
+  atomic_init(&pstRing->lHead, 0);
+  atomic_init(&pstRing->lTail, 0);
+  pstRing->lMask = lCapacity - 1;
+
+  return true;
+}
+
+bool bSpscRingPush(PSTRUCT_SPSC_RING pstRing, void *pvData)
+{
+  size_t lTail = atomic_load_explicit(&pstRing->lTail, memory_order_relaxed);
+
+  if(lTail - pstRing->lHeadCache > pstRing->lMask)
+  {
+    pstRing->lHeadCache = atomic_load_explicit(&pstRing->lHead, memory_order_acquire);
+
+    if(lTail - pstRing->lHeadCache > pstRing->lMask)
+    {
+      return false;
+    }
+  }
+
+  pstRing->ppvSlots[lTail & pstRing->lMask] = pvData;
+
+  /* The slot is written before the consumer sees the new tail */
+  atomic_store_explicit(&pstRing->lTail, lTail + 1, memory_order_release);
+
+  return true;
+}
+
+bool bSpscRingPop(PSTRUCT_SPSC_RING pstRing, void **ppvData)
+{
+  size_t lHead = atomic_load_explicit(&pstRing->lHead, memory_order_relaxed);
+
+  if(lHead == pstRing->lTailCache)
+  {
+    pstRing->lTailCache = atomic_load_explicit(&pstRing->lTail, memory_order_acquire);
+
+    if(lHead == pstRing->lTailCache)
+    {
+      return false;
+    }
+  }
+
+  *ppvData = pstRing->ppvSlots[lHead & pstRing->lMask];
+
+  atomic_store_explicit(&pstRing->lHead, lHead + 1, memory_order_release);
+
+  return true;
+}
+
+void vSpscRingDestroy(PSTRUCT_SPSC_RING pstRing)
+{
+  free(pstRing->ppvSlots);
+
+  pstRing->ppvSlots = NULL;
+}
+
+bool bMpmcRingInit(PSTRUCT_MPMC_RING pstRing, size_t lCapacity)
+{
+  size_t ii;
+
+  memset(pstRing, 0, sizeof(STRUCT_MPMC_RING));
+
+  if((lCapacity = lRingCapacity(lCapacity < 2 ? 2 : lCapacity)) == 0 ||
+     (pstRing->pastCells = (PSTRUCT_MPMC_CELL) calloc(lCapacity, sizeof(STRUCT_MPMC_CELL))) == NULL)
+  {
+    return false;
+  }
+
+  /* The cell ii is written when the position is ii */
+  for(ii = 0; ii < lCapacity; ii++)
+  {
+    atomic_init(&pstRing->pastCells[ii].lSequence, ii);
+  }
+
+  atomic_init(&pstRing->lEnqueuePos, 0);
+  atomic_init(&pstRing->lDequeuePos, 0);
+  pstRing->lMask = lCapacity - 1;
+
+  return true;
+}
+
+bool bMpmcRingPush(PSTRUCT_MPMC_RING pstRing, void *pvData)
+{
+  PSTRUCT_MPMC_CELL pstCell = NULL;
+  size_t lPos = atomic_load_explicit(&pstRing->lEnqueuePos, memory_order_relaxed);
+  size_t lSequence = 0;
+  intptr_t iDiff = 0;
+
+  while(true)
+  {
+    pstCell = &pstRing->pastCells[lPos & pstRing->lMask];
+    lSequence = atomic_load_explicit(&pstCell->lSequence, memory_order_acquire);
+    iDiff = (intptr_t) lSequence - (intptr_t) lPos;
+
+    if(iDiff == 0)
+    {
+      if(atomic_compare_exchange_weak_explicit(&pstRing->lEnqueuePos, &lPos, lPos + 1,
+                                               memory_order_relaxed, memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(iDiff < 0)
+    {
+      /* The cell wasn't read in the last lap */
+      return false;
+    }
+    else
+    {
+      lPos = atomic_load_explicit(&pstRing->lEnqueuePos, memory_order_relaxed);
+    }
+  }
+
+  pstCell->pvData = pvData;
+
+  atomic_store_explicit(&pstCell->lSequence, lPos + 1, memory_order_release);
+
+  return true;
+}
+
+bool bMpmcRingPop(PSTRUCT_MPMC_RING pstRing, void **ppvData)
+{
+  PSTRUCT_MPMC_CELL pstCell = NULL;
+  size_t lPos = atomic_load_explicit(&pstRing->lDequeuePos, memory_order_relaxed);
+  size_t lSequence = 0;
+  intptr_t iDiff = 0;
+
+  while(true)
+  {
+    pstCell = &pstRing->pastCells[lPos & pstRing->lMask];
+    lSequence = atomic_load_explicit(&pstCell->lSequence, memory_order_acquire);
+    iDiff = (intptr_t) lSequence - (intptr_t) (lPos + 1);
+
+    if(iDiff == 0)
+    {
+      if(atomic_compare_exchange_weak_explicit(&pstRing->lDequeuePos, &lPos, lPos + 1,
+                                               memory_order_relaxed, memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(iDiff < 0)
+    {
+      /* The cell wasn't written in this lap */
+      return false;
+    }
+    else
+    {
+      lPos = atomic_load_explicit(&pstRing->lDequeuePos, memory_order_relaxed);
+    }
+  }
+
+  *ppvData = pstCell->pvData;
+
+  /* The cell is written again in the next lap */
+  atomic_store_explicit(&pstCell->lSequence, lPos + pstRing->lMask + 1, memory_order_release);
+
+  return true;
+}
+
+void vMpmcRingDestroy(PSTRUCT_MPMC_RING pstRing)
+{
+  free(pstRing->pastCells);
+
+  pstRing->pastCells = NULL;
+}
@@ -0,0 +1,193 @@
+/**
+ * test_ringbuffer.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the ring buffers, run by "make test"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "test.h"
+#include "ringbuffer.h"
+
+/**
+ * Values sent by the threads of the tests
+ */
+#define TEST_RING_VALUES 200000
+
+/**
+ * Producers and consumers of the MPMC test
+ */
+#define TEST_RING_THREADS 4
+
+static STRUCT_SPSC_RING gstSpscRing;
+static STRUCT_MPMC_RING gstMpmcRing;
+static atomic_ullong gullMpmcSum;
+
+TEST(spsc_single_thread)
+{
+  void *pvData = NULL;
+  uintptr_t ii;
+
+  TEST_CHECK(bSpscRingInit(&gstSpscRing, 5));
+  TEST_CHECK(gstSpscRing.lMask == 7);
+
+  TEST_CHECK(!bSpscRingPop(&gstSpscRing, &pvData));
+
+  for(ii = 0; ii < 8; ii++)
+  {
+    TEST_CHECK(bSpscRingPush(&gstSpscRing, (void *) (ii + 1)));
+  }
+
+  TEST_CHECK(!bSpscRingPush(&gstSpscRing, (void *) 9));
+
+  for(ii = 0; ii < 8; ii++)
+  {
+    TEST_CHECK(bSpscRingPop(&gstSpscRing, &pvData) && (uintptr_t) pvData == ii + 1);
+  }
+
+  TEST_CHECK(!bSpscRingPop(&gstSpscRing, &pvData));
+
+  vSpscRingDestroy(&gstSpscRing);
+}
+
+static void *pvSpscProducer(void *pvArg)
+{
+  uintptr_t ii;
+
+  (void) pvArg;
+
+  for(ii = 1; ii <= TEST_RING_VALUES; ii++)
+  {
+    /* Yield when the ring is full, the consumer can be in the same CPU */
+    while(!bSpscRingPush(&gstSpscRing, (void *) ii))
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+TEST(spsc_two_threads)
+{
+  pthread_t tProducer;
+  void *pvData = NULL;
+  uintptr_t uiExpected = 1;
+
+  TEST_CHECK(bSpscRingInit(&gstSpscRing, 64));
+
+  pthread_create(&tProducer, NULL, pvSpscProducer, NULL);
+
+  /* The values arrive in the order of the push */
+  while(uiExpected <= TEST_RING_VALUES)
+  {
+    if(bSpscRingPop(&gstSpscRing, &pvData))
+    {
+      if((uintptr_t) pvData != uiExpected)
+      {
+        TEST_CHECK((uintptr_t) pvData == uiExpected);
+        break;
+      }
+
+      uiExpected++;
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  pthread_join(tProducer, NULL);
+
+  vSpscRingDestroy(&gstSpscRing);
+}
+
+static void *pvMpmcProducer(void *pvArg)
+{
+  uintptr_t uiFirst = (uintptr_t) pvArg * TEST_RING_VALUES;
+  uintptr_t ii;
+
+  for(ii = 1; ii <= TEST_RING_VALUES; ii++)
+  {
+    while(!bMpmcRingPush(&gstMpmcRing, (void *) (uiFirst + ii)))
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+static void *pvMpmcConsumer(void *pvArg)
+{
+  unsigned long long ullSum = 0;
+  void *pvData = NULL;
+  int ii;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < TEST_RING_VALUES; ii++)
+  {
+    while(!bMpmcRingPop(&gstMpmcRing, &pvData))
+    {
+      sched_yield();
+    }
+
+    ullSum += (uintptr_t) pvData;
+  }
+
+  atomic_fetch_add(&gullMpmcSum, ullSum);
+
+  return NULL;
+}
+
+TEST(mpmc)
+{
+  pthread_t atProducers[TEST_RING_THREADS];
+  pthread_t atConsumers[TEST_RING_THREADS];
+  unsigned long long ullExpected = 0;
+  void *pvData = NULL;
+  uintptr_t ii;
+
+  TEST_CHECK(bMpmcRingInit(&gstMpmcRing, 1));
+  TEST_CHECK(gstMpmcRing.lMask == 1);
+  TEST_CHECK(bMpmcRingPush(&gstMpmcRing, (void *) 1) && bMpmcRingPush(&gstMpmcRing, (void *) 2));
+  TEST_CHECK(!bMpmcRingPush(&gstMpmcRing, (void *) 3));
+  TEST_CHECK(bMpmcRingPop(&gstMpmcRing, &pvData) && (uintptr_t) pvData == 1);
+  TEST_CHECK(bMpmcRingPop(&gstMpmcRing, &pvData) && (uintptr_t) pvData == 2);
+  TEST_CHECK(!bMpmcRingPop(&gstMpmcRing, &pvData));
+  vMpmcRingDestroy(&gstMpmcRing);
+
+  TEST_CHECK(bMpmcRingInit(&gstMpmcRing, 256));
+
+  atomic_init(&gullMpmcSum, 0);
+
+  for(ii = 0; ii < TEST_RING_THREADS; ii++)
+  {
+    pthread_create(&atProducers[ii], NULL, pvMpmcProducer, (void *) ii);
+    pthread_create(&atConsumers[ii], NULL, pvMpmcConsumer, NULL);
+  }
+
+  for(ii = 0; ii < TEST_RING_THREADS; ii++)
+  {
+    pthread_join(atProducers[ii], NULL);
+    pthread_join(atConsumers[ii], NULL);
+  }
+
+  /* Each value was taken once */
+  for(ii = 0; ii < (uintptr_t) TEST_RING_THREADS * TEST_RING_VALUES; ii++)
+  {
+    ullExpected += ii + 1;
+  }
+
+  TEST_CHECK(atomic_load(&gullMpmcSum) == ullExpected);
+  TEST_CHECK(!bMpmcRingPop(&gstMpmcRing, &pvData));
+
+  vMpmcRingDestroy(&gstMpmcRing);
+}
@@ -0,0 +1,61 @@
+/**
+ * bench_simd_dispatch.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of the implementations of the CPU
+ *              dispatch, with a buffer of 4 KiB
+ *
+ * Date: 19/10/2026
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "simd_dispatch.h"
+
+static uint8_t gaucBenchData[4096];
+
+static void vBenchSumBytes(uint64_t ui64Iterations, void *pvArg)
+{
+  PFN_SUM_BYTES pfnSumBytes = (PFN_SUM_BYTES) pvArg;
+  const uint8_t *kpucData = gaucBenchData;
+  uint64_t ui64Sum = 0;
+  uint64_t ii;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    /* Otherwise the sum of the same buffer is computed once */
+    BENCH_DO_NOT_OPTIMIZE(kpucData);
+
+    ui64Sum = pfnSumBytes(kpucData, sizeof(gaucBenchData));
+    BENCH_DO_NOT_OPTIMIZE(ui64Sum);
+  }
+}
+
+/**
+ * The dispatched call, with the cost of the ifunc (or pointer)
+ */
+static void vBenchSumBytesDispatch(uint64_t ui64Iterations, void *pvArg)
+{
+  const uint8_t *kpucData = gaucBenchData;
+  uint64_t ui64Sum = 0;
+  uint64_t ii;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    BENCH_DO_NOT_OPTIMIZE(kpucData);
+
+    ui64Sum = ui64SumBytes(kpucData, sizeof(gaucBenchData));
+    BENCH_DO_NOT_OPTIMIZE(ui64Sum);
+  }
+}
+
+BENCH_REGISTER("simd_sum_bytes_dispatch", vBenchSumBytesDispatch, NULL)
+BENCH_REGISTER("simd_sum_bytes_scalar", vBenchSumBytes, (void *) ui64SumBytesScalar)
+
+/* The AVX2 one is the dispatched call, in the CPUs that have it */
+#ifdef SIMD_DISPATCH_X86
+BENCH_REGISTER("simd_sum_bytes_sse2", vBenchSumBytes, (void *) ui64SumBytesSse2)
+#endif
@@ -0,0 +1,102 @@
+/**
+ * simd_dispatch.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Skeleton of a function with one implementation by
+ *              instruction set, the best one for the CPU is chosen
+ *              once (ifunc or the first call). Copy it to the hot
+ *              functions of the project.
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _SIMD_DISPATCH_H_
+#define _SIMD_DISPATCH_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * The SSE2 and AVX2 implementations exist only in x86-64,
+ * the other CPUs use the scalar one
+ */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #define SIMD_DISPATCH_X86 1
+#endif
+
+/**
+ * The loader resolves the function once (GNU indirect function),
+ * without a pointer read in each call. -DSIMD_DISPATCH_NO_IFUNC
+ * uses the pointer, e.g. in a static binary. The sanitizers use
+ * the pointer too, their runtime doesn't exist yet when the
+ * loader runs the resolver.
+ */
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+  #define SIMD_DISPATCH_NO_IFUNC 1
+#elif defined(__has_feature)
+  #if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+    #define SIMD_DISPATCH_NO_IFUNC 1
+  #endif
+#endif
+
+#if defined(SIMD_DISPATCH_X86) && defined(__ELF__) && !defined(SIMD_DISPATCH_NO_IFUNC)
+  #define SIMD_DISPATCH_IFUNC 1
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Signature shared by the implementations
+ */
+typedef uint64_t (*PFN_SUM_BYTES)(const uint8_t *kpucData, size_t lSize);
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Sum of the bytes, with the best implementation of the CPU
+ */
+uint64_t ui64SumBytes(const uint8_t *kpucData, size_t lSize);
+
+/**
+ * Name of the implementation used by ui64SumBytes():
+ * "avx2", "sse2" or "scalar"
+ */
+const char *kpszGetSumBytesImpl(void);
+
+/**
+ * The implementations, the tests compare them with the scalar one
+ */
+uint64_t ui64SumBytesScalar(const uint8_t *kpucData, size_t lSize);
+
+#ifdef SIMD_DISPATCH_X86
+uint64_t ui64SumBytesSse2(const uint8_t *kpucData, size_t lSize);
+uint64_t ui64SumBytesAvx2(const uint8_t *kpucData, size_t lSize);
+
+/**
+ * The CPU runs the AVX2 implementation
+ */
+bool bCpuHasAvx2(void);
+#endif
+
+#endif /* _SIMD_DISPATCH_H_ */
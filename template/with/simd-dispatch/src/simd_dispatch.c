@@ -0,0 +1,140 @@
+/**
+ * simd_dispatch.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Skeleton of a function with one implementation by
+ *              instruction set, the best one for the CPU is chosen
+ *              once (ifunc or the first call). Copy it to the hot
+ *              functions of the project.
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdatomic.h>
+#include "simd_dispatch.h"
+
+#ifdef SIMD_DISPATCH_X86
+  #include <immintrin.h>
+#endif
+
+uint64_t ui64SumBytesScalar(const uint8_t *kpucData, size_t lSize)
+{
+  uint64_t ui64Sum = 0;
+  size_t ii;
+
+  for(ii = 0; ii < lSize; ii++)
+  {
+    ui64Sum += kpucData[ii];
+  }
+
+  return ui64Sum;
+}
+
+#ifdef SIMD_DISPATCH_X86
+/* Every x86-64 CPU has SSE2, it is the base of the dispatch */
+uint64_t ui64SumBytesSse2(const uint8_t *kpucData, size_t lSize)
+{
+  __m128i xZero = _mm_setzero_si128();
+  __m128i xSum = _mm_setzero_si128();
+  size_t ii = 0;
+
+  /* psadbw: sum of 8 bytes in each half of the register */
+  for(; ii + 16 <= lSize; ii += 16)
+  {
+    xSum = _mm_add_epi64(xSum, _mm_sad_epu8(_mm_loadu_si128((const __m128i *) (kpucData + ii)), xZero));
+  }
+
+  return (uint64_t) _mm_cvtsi128_si64(xSum) + (uint64_t) _mm_cvtsi128_si64(_mm_unpackhi_epi64(xSum, xSum)) +
+         ui64SumBytesScalar(kpucData + ii, lSize - ii);
+}
+
+/* Only this function is compiled with AVX2, the binary still runs in any x86-64 */
+__attribute__((target("avx2")))
+uint64_t ui64SumBytesAvx2(const uint8_t *kpucData, size_t lSize)
+{
+  __m256i yZero = _mm256_setzero_si256();
+  __m256i ySum = _mm256_setzero_si256();
+  size_t ii = 0;
+
+  for(; ii + 32 <= lSize; ii += 32)
+  {
+    ySum = _mm256_add_epi64(ySum, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *) (kpucData + ii)), yZero));
+  }
+
+  return (uint64_t) _mm256_extract_epi64(ySum, 0) + (uint64_t) _mm256_extract_epi64(ySum, 1) +
+         (uint64_t) _mm256_extract_epi64(ySum, 2) + (uint64_t) _mm256_extract_epi64(ySum, 3) +
+         ui64SumBytesSse2(kpucData + ii, lSize - ii);
+}
+
+bool bCpuHasAvx2(void)
+{
+  /* The resolver of an ifunc runs before the constructors of libgcc */
+  __builtin_cpu_init();
+
+  return __builtin_cpu_supports("avx2");
+}
+#endif
+
+/**
+ * Best implementation of the CPU, add the new ones
+ * from the best to the worst
+ */
+static PFN_SUM_BYTES pfnResolveSumBytes(void)
+{
+#ifdef SIMD_DISPATCH_X86
+  if(bCpuHasAvx2())
+  {
+    return ui64SumBytesAvx2;
+  }
+
+  return ui64SumBytesSse2;
+#else
+  return ui64SumBytesScalar;
+#endif
+}
+
+#ifdef SIMD_DISPATCH_IFUNC
+uint64_t ui64SumBytes(const uint8_t *kpucData, size_t lSize) __attribute__((ifunc("pfnResolveSumBytes")));
+#else
+static uint64_t ui64SumBytesFirstCall(const uint8_t *kpucData, size_t lSize);
+
+/**
+ * Implementation used, the first call replaces it by the best one
+ */
+static _Atomic(PFN_SUM_BYTES) gpfnSumBytes = ui64SumBytesFirstCall;
+
+static uint64_t ui64SumBytesFirstCall(const uint8_t *kpucData, size_t lSize)
+{
+  PFN_SUM_BYTES pfnSumBytes = pfnResolveSumBytes();
+
+  /* Two threads in the first call store the same pointer */
+  atomic_store_explicit(&gpfnSumBytes, pfnSumBytes, memory_order_relaxed);
+
+  return pfnSumBytes(kpucData, lSize);
+}
+
+uint64_t ui64SumBytes(const uint8_t *kpucData, size_t lSize)
+{
+  return atomic_load_explicit(&gpfnSumBytes, memory_order_relaxed)(kpucData, lSize);
+}
+#endif
+
+const char *kpszGetSumBytesImpl(void)
+{
+  PFN_SUM_BYTES pfnSumBytes = pfnResolveSumBytes();
+
+#ifdef SIMD_DISPATCH_X86
+  if(pfnSumBytes == ui64SumBytesAvx2)
+  {
+    return "avx2";
+  }
+
+  if(pfnSumBytes == ui64SumBytesSse2)
+  {
+    return "sse2";
+  }
+#endif
+
+  return pfnSumBytes == ui64SumBytesScalar ? "scalar" : "unknown";
+}
@@ -0,0 +1,72 @@
+/**
+ * test_simd_dispatch.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the CPU dispatch, each implementation
+ *              the CPU runs must give the result of the scalar one.
+ *              Run by "make test".
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "simd_dispatch.h"
+
+/**
+ * Bytes of the buffer, the sizes tested go
+ * from 0 to it and begin in any alignment
+ */
+#define TEST_SIMD_SIZE 300
+
+TEST(implementations)
+{
+  uint8_t aucData[TEST_SIMD_SIZE + 64];
+  uint64_t ui64Expected = 0;
+  size_t lOffset;
+  size_t lSize;
+  size_t ii;
+
+  for(ii = 0; ii < sizeof(aucData); ii++)
+  {
+    aucData[ii] = (uint8_t) (ii * 131 + 7);
+  }
+
+  /* The tails and the unaligned loads of the vector loops */
+  for(lOffset = 0; lOffset < 33; lOffset++)
+  {
+    for(lSize = 0; lSize <= TEST_SIMD_SIZE; lSize++)
+    {
+      ui64Expected = ui64SumBytesScalar(aucData + lOffset, lSize);
+
+      TEST_CHECK(ui64SumBytes(aucData + lOffset, lSize) == ui64Expected);
+
+#ifdef SIMD_DISPATCH_X86
+      TEST_CHECK(ui64SumBytesSse2(aucData + lOffset, lSize) == ui64Expected);
+
+      if(bCpuHasAvx2())
+      {
+        TEST_CHECK(ui64SumBytesAvx2(aucData + lOffset, lSize) == ui64Expected);
+      }
+#endif
+    }
+  }
+
+  memset(aucData, 0xFF, sizeof(aucData));
+  TEST_CHECK(ui64SumBytes(aucData, sizeof(aucData)) == 255 * sizeof(aucData));
+}
+
+TEST(implementation_name)
+{
+  const char *kpszImpl = kpszGetSumBytesImpl();
+
+  TEST_CHECK(strcmp(kpszImpl, "unknown") != 0);
+
+#ifdef SIMD_DISPATCH_X86
+  TEST_CHECK(strcmp(kpszImpl, bCpuHasAvx2() ? "avx2" : "sse2") == 0);
+#endif
+
+  printf("# dispatch to %s\n", kpszImpl);
+}
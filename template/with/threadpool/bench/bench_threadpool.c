@@ -0,0 +1,80 @@
+/**
+ * bench_threadpool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Microbenchmarks of the overhead of a task of the thread
+ *              pool: the tasks are empty, so only the submit, the steal
+ *              and the wait are measured
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include "bench.h"
+#include "threadpool.h"
+
+/**
+ * Tasks of each wait
+ */
+#define BENCH_POOL_BATCH 1024
+
+static STRUCT_THREAD_POOL gstBenchPool;
+
+static void vBenchEmptyTask(void *pvArg)
+{
+  BENCH_DO_NOT_OPTIMIZE(pvArg);
+}
+
+/**
+ * Each task submits the next one, from the worker
+ */
+static void vBenchChainTask(void *pvArg)
+{
+  uintptr_t uiLeft = (uintptr_t) pvArg;
+
+  if(uiLeft > 1)
+  {
+    bThreadPoolSubmit(&gstBenchPool, vBenchChainTask, (void *) (uiLeft - 1));
+  }
+}
+
+static void vBenchSubmitFromMain(uint64_t ui64Iterations, void *pvArg)
+{
+  uint64_t ii;
+
+  (void) pvArg;
+
+  for(ii = 0; ii < ui64Iterations; ii++)
+  {
+    bThreadPoolSubmit(&gstBenchPool, vBenchEmptyTask, NULL);
+
+    if(ii % BENCH_POOL_BATCH == BENCH_POOL_BATCH - 1)
+    {
+      vThreadPoolWait(&gstBenchPool);
+    }
+  }
+
+  vThreadPoolWait(&gstBenchPool);
+}
+
+static void vBenchSubmitFromWorker(uint64_t ui64Iterations, void *pvArg)
+{
+  (void) pvArg;
+
+  bThreadPoolSubmit(&gstBenchPool, vBenchChainTask, (void *) (uintptr_t) ui64Iterations);
+
+  vThreadPoolWait(&gstBenchPool);
+}
+
+/**
+ * The pool lives while the runner runs, its threads
+ * aren't a cost of the benchmarks
+ */
+static void __attribute__((constructor)) vBenchStartPool(void)
+{
+  bThreadPoolInit(&gstBenchPool, 0);
+}
+
+BENCH_REGISTER("threadpool_submit_main", vBenchSubmitFromMain, NULL)
+BENCH_REGISTER("threadpool_submit_worker", vBenchSubmitFromWorker, NULL)
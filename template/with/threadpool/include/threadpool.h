@@ -0,0 +1,138 @@
+/**
+ * threadpool.h
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Work-stealing thread pool, each worker has its
+ *              own deque and takes the tasks of the others when
+ *              it is empty
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+/******************************************************************************
+ *                                                                            *
+ *                                 Includes                                   *
+ *                                                                            *
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/******************************************************************************
+ *                                                                            *
+ *                             Defines and macros                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Maximum number of workers of a pool
+ */
+#define THREAD_POOL_MAX_WORKERS 256
+
+/**
+ * Initial size of the deque of each worker, it grows when needed
+ */
+#define THREAD_POOL_DEQUE_SIZE 64
+
+/******************************************************************************
+ *                                                                            *
+ *                  Typedefs, structures, unions and enums                    *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Function run by a worker
+ */
+typedef void (*PFN_THREAD_POOL_TASK)(void *pvArg);
+
+/**
+ * A task waiting in a deque
+ */
+typedef struct STRUCT_THREAD_POOL_TASK
+{
+  PFN_THREAD_POOL_TASK pfnTask;
+  void *pvArg;
+} STRUCT_THREAD_POOL_TASK, *PSTRUCT_THREAD_POOL_TASK;
+
+/**
+ * Circular deque of a worker: the owner pushes and pops in
+ * the bottom (the hot tasks, LIFO), the thieves take from
+ * the top (the old tasks, FIFO)
+ */
+typedef struct STRUCT_THREAD_POOL_DEQUE
+{
+  pthread_mutex_t stMutex;
+  PSTRUCT_THREAD_POOL_TASK pastTasks;
+  size_t lTop;
+  size_t lCount;
+  size_t lSize;
+} STRUCT_THREAD_POOL_DEQUE, *PSTRUCT_THREAD_POOL_DEQUE;
+
+struct STRUCT_THREAD_POOL;
+
+/**
+ * A thread of the pool and its deque
+ */
+typedef struct STRUCT_THREAD_POOL_WORKER
+{
+  struct STRUCT_THREAD_POOL *pstPool;
+  pthread_t tThread;
+  int iIndex;
+  STRUCT_THREAD_POOL_DEQUE stDeque;
+} STRUCT_THREAD_POOL_WORKER, *PSTRUCT_THREAD_POOL_WORKER;
+
+/**
+ * The pool. The counters are atomic, so a submit only locks
+ * a deque. stMutex protects bStop and the sleep of the workers
+ * (stWorkCond, when there isn't a task) and of vThreadPoolWait()
+ * (stDoneCond).
+ */
+typedef struct STRUCT_THREAD_POOL
+{
+  PSTRUCT_THREAD_POOL_WORKER pastWorkers;
+  int iWorkersCount;
+  atomic_uint uiNextWorker;   /* Deque of the next task of a thread out of the pool */
+  pthread_mutex_t stMutex;
+  pthread_cond_t stWorkCond;
+  pthread_cond_t stDoneCond;
+  atomic_long lQueued;        /* Tasks in the deques                                */
+  atomic_long lPending;       /* Tasks submitted and not finished                   */
+  atomic_int iSleeping;       /* Workers waiting in stWorkCond                      */
+  bool bStop;
+} STRUCT_THREAD_POOL, *PSTRUCT_THREAD_POOL;
+
+/******************************************************************************
+ *                                                                            *
+ *                            Prototype functions                             *
+ *                                                                            *
+ ******************************************************************************/
+
+/**
+ * Start iWorkers threads, 0 is the number of CPUs online
+ */
+bool bThreadPoolInit(PSTRUCT_THREAD_POOL pstPool, int iWorkers);
+
+/**
+ * Add a task. From a task of the pool, it goes to the deque of
+ * the worker (and is run by it, unless another one steals it),
+ * from other threads the deques are used in turns.
+ */
+bool bThreadPoolSubmit(PSTRUCT_THREAD_POOL pstPool, PFN_THREAD_POOL_TASK pfnTask, void *pvArg);
+
+/**
+ * Wait until every task submitted (and the tasks submitted by
+ * them) finish. A task of the pool must not call it.
+ */
+void vThreadPoolWait(PSTRUCT_THREAD_POOL pstPool);
+
+/**
+ * Run the tasks left, stop the workers and free the pool
+ */
+void vThreadPoolDestroy(PSTRUCT_THREAD_POOL pstPool);
+
+#endif /* _THREADPOOL_H_ */
@@ -0,0 +1,325 @@
+/**
+ * threadpool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Work-stealing thread pool, each worker has its
+ *              own deque and takes the tasks of the others when
+ *              it is empty
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+/**
+ * Worker of the current thread, NULL out of the pools
+ */
+static _Thread_local PSTRUCT_THREAD_POOL_WORKER gpstCurrentWorker = NULL;
+
+/**
+ * Add a task in the bottom of the deque
+ */
+static bool bDequePush(PSTRUCT_THREAD_POOL_DEQUE pstDeque, PFN_THREAD_POOL_TASK pfnTask, void *pvArg)
+{
+  PSTRUCT_THREAD_POOL_TASK pastTasks = NULL;
+  size_t ii;
+
+  pthread_mutex_lock(&pstDeque->stMutex);
+
+  if(pstDeque->lCount == pstDeque->lSize)
+  {
+    if((pastTasks = (PSTRUCT_THREAD_POOL_TASK) malloc(pstDeque->lSize * 2 * sizeof(STRUCT_THREAD_POOL_TASK))) == NULL)
+    {
+      pthread_mutex_unlock(&pstDeque->stMutex);
+
+      return false;
+    }
+
+    /* The new array begins in the top */
+    for(ii = 0; ii < pstDeque->lCount; ii++)
+    {
+      pastTasks[ii] = pstDeque->pastTasks[(pstDeque->lTop + ii) % pstDeque->lSize];
+    }
+
+    free(pstDeque->pastTasks);
+
+    pstDeque->pastTasks = pastTasks;
+    pstDeque->lTop = 0;
+    pstDeque->lSize *= 2;
+  }
+
+  pstDeque->pastTasks[(pstDeque->lTop + pstDeque->lCount) % pstDeque->lSize].pfnTask = pfnTask;
+  pstDeque->pastTasks[(pstDeque->lTop + pstDeque->lCount) % pstDeque->lSize].pvArg = pvArg;
+  pstDeque->lCount++;
+
+  pthread_mutex_unlock(&pstDeque->stMutex);
+
+  return true;
+}
+
+/**
+ * Take the task of the bottom (bSteal false) or of the top (bSteal true)
+ */
+static bool bDequeTake(PSTRUCT_THREAD_POOL_DEQUE pstDeque, bool bSteal, PSTRUCT_THREAD_POOL_TASK pstTask)
+{
+  bool bTaken = false;
+
+  pthread_mutex_lock(&pstDeque->stMutex);
+
+  if(pstDeque->lCount > 0)
+  {
+    if(bSteal)
+    {
+      *pstTask = pstDeque->pastTasks[pstDeque->lTop];
+      pstDeque->lTop = (pstDeque->lTop + 1) % pstDeque->lSize;
+    }
+    else
+    {
+      *pstTask = pstDeque->pastTasks[(pstDeque->lTop + pstDeque->lCount - 1) % pstDeque->lSize];
+    }
+
+    pstDeque->lCount--;
+    bTaken = true;
+  }
+
+  pthread_mutex_unlock(&pstDeque->stMutex);
+
+  return bTaken;
+}
+
+/**
+ * A task of the own deque or, when it is empty, of the others
+ */
+static bool bThreadPoolTake(PSTRUCT_THREAD_POOL_WORKER pstWorker, PSTRUCT_THREAD_POOL_TASK pstTask)
+{
+  PSTRUCT_THREAD_POOL pstPool = pstWorker->pstPool;
+  int ii;
+
+  if(bDequeTake(&pstWorker->stDeque, false, pstTask))
+  {
+    return true;
+  }
+
+  /* Each worker begins by its neighbor, so the thieves are spread */
+  for(ii = 1; ii < pstPool->iWorkersCount; ii++)
+  {
+    if(bDequeTake(&pstPool->pastWorkers[(pstWorker->iIndex + ii) % pstPool->iWorkersCount].stDeque, true, pstTask))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Thread of a worker: run the tasks, sleep when there
+ * isn't any, stop when the pool stops and is empty
+ */
+static void *pvThreadPoolWorker(void *pvWorker)
+{
+  PSTRUCT_THREAD_POOL_WORKER pstWorker = (PSTRUCT_THREAD_POOL_WORKER) pvWorker;
+  PSTRUCT_THREAD_POOL pstPool = pstWorker->pstPool;
+  STRUCT_THREAD_POOL_TASK stTask;
+  bool bStop = false;
+
+  gpstCurrentWorker = pstWorker;
+
+  while(!bStop)
+  {
+    if(bThreadPoolTake(pstWorker, &stTask))
+    {
+      atomic_fetch_sub(&pstPool->lQueued, 1);
+
+      stTask.pfnTask(stTask.pvArg);
+
+      if(atomic_fetch_sub(&pstPool->lPending, 1) == 1)
+      {
+        pthread_mutex_lock(&pstPool->stMutex);
+        pthread_cond_broadcast(&pstPool->stDoneCond);
+        pthread_mutex_unlock(&pstPool->stMutex);
+      }
+
+      continue;
+    }
+
+    pthread_mutex_lock(&pstPool->stMutex);
+
+    /* A submit reads iSleeping after lQueued, one of them sees the other */
+    atomic_fetch_add(&pstPool->iSleeping, 1);
+
+    while(atomic_load(&pstPool->lQueued) <= 0 && !pstPool->bStop)
+    {
+      pthread_cond_wait(&pstPool->stWorkCond, &pstPool->stMutex);
+    }
+
+    atomic_fetch_sub(&pstPool->iSleeping, 1);
+
+    bStop = pstPool->bStop && atomic_load(&pstPool->lQueued) <= 0;
+
+    pthread_mutex_unlock(&pstPool->stMutex);
+  }
+
+  gpstCurrentWorker = NULL;
+
+  return NULL;
+}
+
+/**
+ * Stop and join the first iStarted workers, free the pool
+ */
+static void vThreadPoolStop(PSTRUCT_THREAD_POOL pstPool, int iStarted)
+{
+  int ii;
+
+  pthread_mutex_lock(&pstPool->stMutex);
+  pstPool->bStop = true;
+  pthread_cond_broadcast(&pstPool->stWorkCond);
+  pthread_mutex_unlock(&pstPool->stMutex);
+
+  for(ii = 0; ii < iStarted; ii++)
+  {
+    pthread_join(pstPool->pastWorkers[ii].tThread, NULL);
+  }
+
+  for(ii = 0; ii < pstPool->iWorkersCount; ii++)
+  {
+    pthread_mutex_destroy(&pstPool->pastWorkers[ii].stDeque.stMutex);
+    free(pstPool->pastWorkers[ii].stDeque.pastTasks);
+  }
+
+  pthread_mutex_destroy(&pstPool->stMutex);
+  pthread_cond_destroy(&pstPool->stWorkCond);
+  pthread_cond_destroy(&pstPool->stDoneCond);
+
+  free(pstPool->pastWorkers);
+
+  pstPool->pastWorkers = NULL;
+  pstPool->iWorkersCount = 0;
+}
+
+bool bThreadPoolInit(PSTRUCT_THREAD_POOL pstPool, int iWorkers)
+{
+  PSTRUCT_THREAD_POOL_WORKER pstWorker = NULL;
+  int ii;
+
+  memset(pstPool, 0, sizeof(STRUCT_THREAD_POOL));
+
+  if(iWorkers <= 0)
+  {
+    iWorkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+  }
+
+  if(iWorkers <= 0)
+  {
+    iWorkers = 1;
+  }
+
+  if(iWorkers > THREAD_POOL_MAX_WORKERS)
+  {
+    iWorkers = THREAD_POOL_MAX_WORKERS;
+  }
+
+  if((pstPool->pastWorkers = (PSTRUCT_THREAD_POOL_WORKER) calloc(iWorkers, sizeof(STRUCT_THREAD_POOL_WORKER))) == NULL)
+  {
+    return false;
+  }
+
+  pthread_mutex_init(&pstPool->stMutex, NULL);
+  pthread_cond_init(&pstPool->stWorkCond, NULL);
+  pthread_cond_init(&pstPool->stDoneCond, NULL);
+  atomic_init(&pstPool->uiNextWorker, 0);
+  atomic_init(&pstPool->lQueued, 0);
+  atomic_init(&pstPool->lPending, 0);
+  atomic_init(&pstPool->iSleeping, 0);
+
+  /* Every deque exists before the first thief */
+  for(ii = 0; ii < iWorkers; ii++)
+  {
+    pstWorker = &pstPool->pastWorkers[ii];
+    pstWorker->pstPool = pstPool;
+    pstWorker->iIndex = ii;
+
+    pthread_mutex_init(&pstWorker->stDeque.stMutex, NULL);
+    pstWorker->stDeque.lSize = THREAD_POOL_DEQUE_SIZE;
+
+    pstPool->iWorkersCount++;
+
+    if((pstWorker->stDeque.pastTasks = (PSTRUCT_THREAD_POOL_TASK) malloc(THREAD_POOL_DEQUE_SIZE *
+                                                                         sizeof(STRUCT_THREAD_POOL_TASK))) == NULL)
+    {
+      vThreadPoolStop(pstPool, 0);
+
+      return false;
+    }
+  }
+
+  for(ii = 0; ii < iWorkers; ii++)
+  {
+    if(pthread_create(&pstPool->pastWorkers[ii].tThread, NULL, pvThreadPoolWorker, &pstPool->pastWorkers[ii]) != 0)
+    {
+      vThreadPoolStop(pstPool, ii);
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool bThreadPoolSubmit(PSTRUCT_THREAD_POOL pstPool, PFN_THREAD_POOL_TASK pfnTask, void *pvArg)
+{
+  PSTRUCT_THREAD_POOL_WORKER pstWorker = gpstCurrentWorker;
+
+  if(pstWorker == NULL || pstWorker->pstPool != pstPool)
+  {
+    pstWorker = &pstPool->pastWorkers[atomic_fetch_add(&pstPool->uiNextWorker, 1) % pstPool->iWorkersCount];
+  }
+
+  /* Before the push, so it never finishes before being counted */
+  atomic_fetch_add(&pstPool->lPending, 1);
+
+  if(!bDequePush(&pstWorker->stDeque, pfnTask, pvArg))
+  {
+    atomic_fetch_sub(&pstPool->lPending, 1);
+
+    return false;
+  }
+
+  atomic_fetch_add(&pstPool->lQueued, 1);
+
+  if(atomic_load(&pstPool->iSleeping) > 0)
+  {
+    pthread_mutex_lock(&pstPool->stMutex);
+    pthread_cond_signal(&pstPool->stWorkCond);
+    pthread_mutex_unlock(&pstPool->stMutex);
+  }
+
+  return true;
+}
+
+void vThreadPoolWait(PSTRUCT_THREAD_POOL pstPool)
+{
+  pthread_mutex_lock(&pstPool->stMutex);
+
+  while(atomic_load(&pstPool->lPending) > 0)
+  {
+    pthread_cond_wait(&pstPool->stDoneCond, &pstPool->stMutex);
+  }
+
+  pthread_mutex_unlock(&pstPool->stMutex);
+}
+
+void vThreadPoolDestroy(PSTRUCT_THREAD_POOL pstPool)
+{
+  if(pstPool->pastWorkers == NULL)
+  {
+    return;
+  }
+
+  vThreadPoolStop(pstPool, pstPool->iWorkersCount);
+}
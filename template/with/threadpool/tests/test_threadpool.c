@@ -0,0 +1,95 @@
+/**
+ * test_threadpool.c
+ *
+ * Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+ *
+ * Description: Unit tests of the thread pool, run by "make test"
+ *
+ * Date: 19/10/2026
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "test.h"
+#include "threadpool.h"
+
+/**
+ * Tasks submitted by the main thread
+ */
+#define TEST_POOL_TASKS 10000
+
+/**
+ * Depth of the tree of tasks that submit tasks
+ */
+#define TEST_POOL_DEPTH 12
+
+static STRUCT_THREAD_POOL gstPool;
+static atomic_long glCounter;
+
+static void vTaskIncrement(void *pvArg)
+{
+  atomic_fetch_add(&glCounter, (long) (intptr_t) pvArg);
+}
+
+/**
+ * Each task of depth > 0 submits two tasks, from the worker
+ */
+static void vTaskTree(void *pvArg)
+{
+  intptr_t iDepth = (intptr_t) pvArg;
+
+  atomic_fetch_add(&glCounter, 1);
+
+  if(iDepth > 0)
+  {
+    bThreadPoolSubmit(&gstPool, vTaskTree, (void *) (iDepth - 1));
+    bThreadPoolSubmit(&gstPool, vTaskTree, (void *) (iDepth - 1));
+  }
+}
+
+TEST(submit_and_wait)
+{
+  int ii;
+
+  TEST_CHECK(bThreadPoolInit(&gstPool, 4));
+  TEST_CHECK(gstPool.iWorkersCount == 4);
+
+  atomic_init(&glCounter, 0);
+
+  for(ii = 0; ii < TEST_POOL_TASKS; ii++)
+  {
+    TEST_CHECK(bThreadPoolSubmit(&gstPool, vTaskIncrement, (void *) (intptr_t) 1));
+  }
+
+  vThreadPoolWait(&gstPool);
+  TEST_CHECK(atomic_load(&glCounter) == TEST_POOL_TASKS);
+
+  /* The pool is used again after a wait */
+  atomic_store(&glCounter, 0);
+  TEST_CHECK(bThreadPoolSubmit(&gstPool, vTaskTree, (void *) (intptr_t) TEST_POOL_DEPTH));
+
+  vThreadPoolWait(&gstPool);
+  TEST_CHECK(atomic_load(&glCounter) == (1L << (TEST_POOL_DEPTH + 1)) - 1);
+
+  vThreadPoolDestroy(&gstPool);
+  TEST_CHECK(gstPool.pastWorkers == NULL);
+}
+
+TEST(destroy_runs_tasks)
+{
+  int ii;
+
+  TEST_CHECK(bThreadPoolInit(&gstPool, 0));
+  TEST_CHECK(gstPool.iWorkersCount >= 1);
+
+  atomic_store(&glCounter, 0);
+
+  for(ii = 0; ii < TEST_POOL_TASKS; ii++)
+  {
+    bThreadPoolSubmit(&gstPool, vTaskIncrement, (void *) (intptr_t) 2);
+  }
+
+  /* Without wait, the destroy runs the tasks left */
+  vThreadPoolDestroy(&gstPool);
+  TEST_CHECK(atomic_load(&glCounter) == 2L * TEST_POOL_TASKS);
+}
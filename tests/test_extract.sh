@@ -0,0 +1,57 @@
+#!/bin/bash
+# 
+# test_extract.sh
+# 
+# Written by Gustavo Bacagine <gustavo.bacagine@protonmail.com>
+#
+# Description: Test of --extract-template with a short project
+#              name ("io") that is part of other words, only the
+#              whole words are replaced by "template"
+#
+# Date: 2026-10-19
+#
+
+MKCPROJ="$(realpath "${1:-bin/mkcproj}")"
+TMPDIR_TEST="$(mktemp -d)"
+FAILURES=0
+
+trap 'rm -rf "$TMPDIR_TEST"' EXIT
+
+# The profile of the developer never changes the test
+export HOME="$TMPDIR_TEST"
+
+check() {
+  if grep -q -F -- "$2" "$1" 2> /dev/null; then
+    echo "ok - ${1#$TMPDIR_TEST/}: $2"
+  else
+    echo "not ok - ${1#$TMPDIR_TEST/}: $2"
+    FAILURES=$((FAILURES + 1))
+  fi
+}
+
+# The name of the project is the name of the directory
+PROJECT="$TMPDIR_TEST/io"
+mkdir -p "$PROJECT/src" "$PROJECT/include"
+
+cat > "$PROJECT/include/io.h" << 'EOT'
+#ifndef _IO_H_
+#define _IO_H_
+#include <stdio.h>
+#endif /* _IO_H_ */
+EOT
+
+cat > "$PROJECT/src/io_words.c" << 'EOT'
+#include "io.h"
+/* Foundation, radio, IOCTL and IO_MAX */
+int io_main(void);
+EOT
+
+"$MKCPROJ" -X "$PROJECT" -T "$TMPDIR_TEST/template" > /dev/null || exit 1
+
+check "$TMPDIR_TEST/template/include/template.h" '#ifndef _TEMPLATE_H_'
+check "$TMPDIR_TEST/template/include/template.h" '#include <stdio.h>'
+check "$TMPDIR_TEST/template/src/template_words.c" '#include "template.h"'
+check "$TMPDIR_TEST/template/src/template_words.c" '/* Foundation, radio, IOCTL and TEMPLATE_MAX */'
+check "$TMPDIR_TEST/template/src/template_words.c" 'int template_main(void);'
+
+test $FAILURES -eq 0